@@ -43,6 +43,7 @@ src/lib/enesim_draw_cache.c \
 src/lib/enesim_draw_cache_private.h \
 src/lib/enesim_format.c \
 src/lib/enesim_log.c \
+src/lib/enesim_log_private.h \
 src/lib/enesim_image.c \
 src/lib/enesim_image_private.h \
 src/lib/enesim_main.c \
@@ -93,7 +94,6 @@ src_lib_libenesim_la_CPPFLAGS = \
 
 src_lib_libenesim_la_LIBADD = \
 @ENESIM_LIBS@ \
-@ENS_SIMD_FLAGS@ \
 -lm
 
 src_lib_libenesim_la_LDFLAGS = -no-undefined -version-info @version_info@
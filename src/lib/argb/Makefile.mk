@@ -1,12 +1,14 @@
 
 src_lib_libenesim_la_SOURCES += \
 src/lib/argb/libargb.h \
+src/lib/argb/libargb_a8.h \
 src/lib/argb/libargb_argb8888.h \
 src/lib/argb/libargb_argb8888_blend.h \
 src/lib/argb/libargb_argb8888_core.h \
 src/lib/argb/libargb_argb8888_fill.h \
 src/lib/argb/libargb_argb8888_misc.h \
 src/lib/argb/libargb_argb8888_mul4_sym.h \
+src/lib/argb/libargb_argb8888_rop.h \
 src/lib/argb/libargb_argb8888_unpre.h \
 src/lib/argb/libargb_macros.h \
 src/lib/argb/libargb_mmx.h \
@@ -34,5 +34,6 @@
 
 #include "libargb_argb8888.h"
 #include "libargb_argb8888_unpre.h"
+#include "libargb_a8.h"
 
 #endif
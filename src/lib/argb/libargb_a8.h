@@ -0,0 +1,161 @@
+/* LIBARGB - ARGB helper functions
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARGB_A8_H
+#define LIBARGB_A8_H
+
+/*
+ * The a8 destination only keeps the alpha channel. Every function gives the
+ * same alpha the argb8888 function of the same operation would give
+ */
+static inline void a8_blend(uint8_t *d, uint16_t a)
+{
+	*d = a + ((*d * (256 - a)) >> 8);
+}
+
+/* the alpha of argb8888_mul_256() */
+static inline uint16_t a8_mul_256(uint16_t a, uint16_t b)
+{
+	return (a * b) >> 8;
+}
+
+/* the alpha of argb8888_mul_sym() and argb8888_mul4_sym() */
+static inline uint16_t a8_mul_sym(uint16_t a, uint16_t b)
+{
+	return (a * b + 255) >> 8;
+}
+/*============================================================================*
+ *                              Span operations                               *
+ *============================================================================*/
+static inline void a8_sp_none_color_none_fill(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint32_t *m EINA_UNUSED)
+{
+	memset(d, color >> 24, len);
+}
+
+static inline void a8_sp_argb8888_none_none_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color EINA_UNUSED, uint32_t *m EINA_UNUSED)
+{
+	uint8_t *end = d + len;
+	while (d < end)
+		*d++ = *s++ >> 24;
+}
+
+static inline void a8_sp_argb8888_color_none_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m EINA_UNUSED)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		*d++ = a8_mul_sym(ca, *s++ >> 24);
+}
+
+static inline void a8_sp_a8_none_none_fill(uint8_t *d, uint32_t len,
+		uint8_t *s, uint32_t color EINA_UNUSED, uint32_t *m EINA_UNUSED)
+{
+	memcpy(d, s, len);
+}
+
+static inline void a8_sp_none_color_argb8888_fill(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint32_t *m)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		*d++ = a8_mul_sym(ca, *m++ >> 24);
+}
+
+static inline void a8_sp_none_color_a8_fill(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint8_t *m)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		*d++ = a8_mul_256(ca, *m++ + 1);
+}
+
+static inline void a8_sp_argb8888_none_argb8888_fill(uint8_t *d,
+		uint32_t len, uint32_t *s, uint32_t color EINA_UNUSED,
+		uint32_t *m)
+{
+	uint8_t *end = d + len;
+	while (d < end)
+		*d++ = a8_mul_sym(*s++ >> 24, *m++ >> 24);
+}
+
+static inline void a8_sp_none_color_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint32_t *m EINA_UNUSED)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, ca);
+}
+
+static inline void a8_sp_argb8888_none_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color EINA_UNUSED, uint32_t *m EINA_UNUSED)
+{
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, *s++ >> 24);
+}
+
+static inline void a8_sp_argb8888_color_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m EINA_UNUSED)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, a8_mul_sym(ca, *s++ >> 24));
+}
+
+static inline void a8_sp_a8_none_none_blend(uint8_t *d, uint32_t len,
+		uint8_t *s, uint32_t color EINA_UNUSED, uint32_t *m EINA_UNUSED)
+{
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, *s++);
+}
+
+static inline void a8_sp_none_color_argb8888_blend(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint32_t *m)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, a8_mul_256(ca, (*m++ >> 24) + 1));
+}
+
+static inline void a8_sp_none_color_a8_blend(uint8_t *d, uint32_t len,
+		uint32_t *s EINA_UNUSED, uint32_t color, uint8_t *m)
+{
+	uint16_t ca = color >> 24;
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, a8_mul_sym(ca, *m++));
+}
+
+static inline void a8_sp_argb8888_none_argb8888_blend(uint8_t *d,
+		uint32_t len, uint32_t *s, uint32_t color EINA_UNUSED,
+		uint32_t *m)
+{
+	uint8_t *end = d + len;
+	while (d < end)
+		a8_blend(d++, a8_mul_256(*s++ >> 24, (*m++ >> 24) + 1));
+}
+
+#endif
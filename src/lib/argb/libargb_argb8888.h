@@ -34,5 +34,6 @@
 #include "libargb_argb8888_mul4_sym.h"
 #include "libargb_argb8888_fill.h"
 #include "libargb_argb8888_blend.h"
+#include "libargb_argb8888_rop.h"
 
 #endif
@@ -176,15 +176,24 @@ static inline void argb8888_sp_argb8888_none_none_blend(uint32_t *d,
 	while (d < end)
 	{
 		uint16_t a16 = 256 - ((*s) >> 24);
+		unsigned int n;
 
 		switch (a16)
 		{
+			/* skip the whole transparent run */
 			case 256:
-			break;
+			n = argb8888_alpha_run(s, s + (end - d), 0);
+			d += n;
+			s += n;
+			continue;
 
+			/* and copy the whole opaque run */
 			case 1:
-			*d = *s;
-			break;
+			n = argb8888_alpha_run(s, s + (end - d), 255);
+			memcpy(d, s, n * sizeof(uint32_t));
+			d += n;
+			s += n;
+			continue;
 
 			default:
 #if LIBARGB_MMX
@@ -245,13 +254,32 @@ static inline void argb8888_sp_none_color_a8_blend(uint32_t *d, unsigned int len
 	while (d < end)
 	{
 		uint16_t ma = *m;
+		uint8_t *mend;
 
 		switch (ma)
 		{
+			/* skip the whole transparent run */
 			case 0:
-			break;
+			mend = m + (end - d);
+			while (m < mend && !*m)
+			{
+				m++;
+				d++;
+			}
+			continue;
 
 			case 255:
+			/* an opaque color fills the whole opaque run */
+			if (ca == 1)
+			{
+				mend = m + (end - d);
+				while (m < mend && *m == 255)
+				{
+					*d++ = color;
+					m++;
+				}
+				continue;
+			}
 			argb8888_blend(d, ca, color);
 			break;
 
@@ -380,13 +408,27 @@ static inline void argb8888_sp_none_color_argb8888_blend(uint32_t *d, unsigned i
 	while (d < end)
 	{
 		uint16_t ma = 1 + ((*m) >> 24);
+		unsigned int n;
 
 		switch (ma)
 		{
+			/* skip the whole transparent run */
 			case 1:
-			break;
+			n = argb8888_alpha_run(m, m + (end - d), 0);
+			d += n;
+			m += n;
+			continue;
 
 			case 256:
+			/* an opaque color fills the whole opaque run */
+			if (ca == 1)
+			{
+				n = argb8888_alpha_run(m, m + (end - d), 255);
+				m += n;
+				while (n--)
+					*d++ = color;
+				continue;
+			}
 			argb8888_blend(d, ca, color);
 			break;
 
@@ -413,11 +455,17 @@ static inline void argb8888_sp_argb8888_none_argb8888_blend(uint32_t *d, unsigne
 	while (d < end)
 	{
 		uint16_t ma = 1 + ((*m) >> 24);
+		unsigned int n;
 
 		switch (ma)
 		{
+			/* skip the whole transparent run */
 			case 1:
-			break;
+			n = argb8888_alpha_run(m, m + (end - d), 0);
+			d += n;
+			s += n;
+			m += n;
+			continue;
 
 			case 256:
 			{
@@ -70,4 +70,15 @@ static inline void argb8888_fill(uint32_t *dplane0, uint32_t splane0)
 {
 	*dplane0 = splane0;
 }
+
+/* the number of pixels from p to end that have the alpha a */
+static inline unsigned int argb8888_alpha_run(uint32_t *p, uint32_t *end,
+		uint8_t a)
+{
+	uint32_t *start = p;
+
+	while (p < end && (*p >> 24) == a)
+		p++;
+	return p - start;
+}
 #endif
@@ -0,0 +1,163 @@
+/* LIBARGB - ARGB helper functions
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef LIBARGB_ARGB8888_ROP_H
+#define LIBARGB_ARGB8888_ROP_H
+
+/*
+ * The porter duff and separable blend operators besides the fill and the
+ * blend. The source pixel is src*color*ma as the fill functions do, with
+ * a symmetric multiplication for the mask, and then it is combined with the
+ * destination pixel
+ */
+
+/*
+ * D = D(1 - Sa)
+ */
+static inline void argb8888_dst_out(uint32_t *d, uint32_t s)
+{
+	*d = argb8888_mul_256(256 - (s >> 24), *d);
+}
+
+/*
+ * D = S * Da
+ */
+static inline void argb8888_src_in(uint32_t *d, uint32_t s)
+{
+	*d = argb8888_mul_256(1 + (*d >> 24), s);
+}
+
+/*
+ * D = D * Sa
+ */
+static inline void argb8888_dst_in(uint32_t *d, uint32_t s)
+{
+	*d = argb8888_mul_256(1 + (s >> 24), *d);
+}
+
+/*
+ * D = S * D + S(1 - Da) + D(1 - Sa), the sum fits on 16 bits for
+ * premultiplied colors
+ */
+static inline void argb8888_multiply(uint32_t *d, uint32_t s)
+{
+	uint16_t isa = 255 - (s >> 24);
+	uint16_t ida = 255 - (*d >> 24);
+	uint32_t r = 0;
+	int i;
+
+	for (i = 0; i < 32; i += 8)
+	{
+		uint16_t sc = (s >> i) & 0xff;
+		uint16_t dc = (*d >> i) & 0xff;
+		uint16_t c;
+
+		c = sc * dc + sc * ida + dc * isa + 255;
+		r |= (uint32_t)(c >> 8) << i;
+	}
+	*d = r;
+}
+
+/*
+ * D = S + D - S * D
+ */
+static inline void argb8888_screen(uint32_t *d, uint32_t s)
+{
+	uint32_t r = 0;
+	int i;
+
+	for (i = 0; i < 32; i += 8)
+	{
+		uint16_t sc = (s >> i) & 0xff;
+		uint16_t dc = (*d >> i) & 0xff;
+		uint16_t c;
+
+		c = sc + dc - ((sc * dc + 255) >> 8);
+		r |= (uint32_t)c << i;
+	}
+	*d = r;
+}
+
+/*============================================================================*
+ *                              Span operations                               *
+ *============================================================================*/
+/*
+ * Defines the span functions of an operator, one for every combination
+ * of source, color and mask the compositor uses
+ */
+#define ARGB8888_ROP_SPANS(op)						\
+static inline void argb8888_sp_none_color_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s EINA_UNUSED, uint32_t color,	\
+		uint32_t *m EINA_UNUSED)				\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, color);				\
+}									\
+									\
+static inline void argb8888_sp_argb8888_none_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color EINA_UNUSED,	\
+		uint32_t *m EINA_UNUSED)				\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, *s++);				\
+}									\
+									\
+static inline void argb8888_sp_argb8888_color_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color,		\
+		uint32_t *m EINA_UNUSED)				\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, argb8888_mul4_sym(color, *s++));	\
+}									\
+									\
+static inline void argb8888_sp_none_color_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s EINA_UNUSED, uint32_t color,	\
+		uint32_t *m)						\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, argb8888_mul_sym(*m++ >> 24, color));	\
+}									\
+									\
+static inline void argb8888_sp_none_color_a8_##op(uint32_t *d,		\
+		uint32_t len, uint32_t *s EINA_UNUSED, uint32_t color,	\
+		uint8_t *m)						\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, argb8888_mul_sym(*m++, color));	\
+}									\
+									\
+static inline void argb8888_sp_argb8888_none_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color EINA_UNUSED,	\
+		uint32_t *m)						\
+{									\
+	uint32_t *end = d + len;					\
+	while (d < end)							\
+		argb8888_##op(d++, argb8888_mul_sym(*m++ >> 24, *s++));	\
+}
+
+ARGB8888_ROP_SPANS(dst_out)
+ARGB8888_ROP_SPANS(src_in)
+ARGB8888_ROP_SPANS(dst_in)
+ARGB8888_ROP_SPANS(multiply)
+ARGB8888_ROP_SPANS(screen)
+
+#endif
@@ -1,3 +1,7 @@
-
 src_lib_libenesim_la_SOURCES += \
-src/lib/compositor/enesim_compositor_argb8888.c
+src/lib/compositor/enesim_compositor_a8.c \
+src/lib/compositor/enesim_compositor_a8_sse2.c \
+src/lib/compositor/enesim_compositor_argb8888.c \
+src/lib/compositor/enesim_compositor_argb8888_avx2.c \
+src/lib/compositor/enesim_compositor_argb8888_sse2.c \
+src/lib/compositor/enesim_compositor_argb8888_ssse3.c
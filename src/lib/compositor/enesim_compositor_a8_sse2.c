@@ -0,0 +1,518 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "enesim_private.h"
+#include "libargb.h"
+
+#include "enesim_main.h"
+#include "enesim_color.h"
+#include "enesim_format.h"
+
+#include "enesim_compositor_private.h"
+#include "enesim_cpu_private.h"
+
+#if ENESIM_CPU_X86
+#include <emmintrin.h>
+#endif
+/*
+ * The SSE2 versions of the a8 kernels. They work on sixteen pixels at a
+ * time with the destination aligned to 16 bytes, the alpha values are
+ * computed on two vectors of eight 16 bits values. The unaligned head and
+ * the tail are done with the generic functions. Every function must give
+ * the same result as the generic one, bit by bit. The plain color fill and
+ * the a8 copy are already a memset and a memcpy
+ */
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#if ENESIM_CPU_X86
+#define SSE2 ENESIM_CPU_TARGET("sse2")
+
+/* number of pixels until d is aligned to 16 bytes */
+#define ALIGN16_HEAD(d, len) \
+	(((16 - ((uintptr_t)(d) & 15)) & 15) < (len) ? \
+	((16 - ((uintptr_t)(d) & 15)) & 15) : (len))
+
+/*
+ * The alpha of sixteen argb8888 pixels
+ */
+static inline SSE2 void _argb8888_alpha_load(uint32_t *s, __m128i *lo,
+		__m128i *hi)
+{
+	__m128i s0, s1, s2, s3;
+
+	s0 = _mm_srli_epi32(_mm_loadu_si128((__m128i *)s), 24);
+	s1 = _mm_srli_epi32(_mm_loadu_si128((__m128i *)s + 1), 24);
+	s2 = _mm_srli_epi32(_mm_loadu_si128((__m128i *)s + 2), 24);
+	s3 = _mm_srli_epi32(_mm_loadu_si128((__m128i *)s + 3), 24);
+	*lo = _mm_packs_epi32(s0, s1);
+	*hi = _mm_packs_epi32(s2, s3);
+}
+
+/*
+ * Sixteen a8 values
+ */
+static inline SSE2 void _a8_load(uint8_t *s, __m128i *lo, __m128i *hi)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i a;
+
+	a = _mm_loadu_si128((__m128i *)s);
+	*lo = _mm_unpacklo_epi8(a, z);
+	*hi = _mm_unpackhi_epi8(a, z);
+}
+
+/*
+ * a * b >> 8, as a8_mul_256() does
+ */
+static inline SSE2 __m128i _mul_256(__m128i a, __m128i b)
+{
+	return _mm_srli_epi16(_mm_mullo_epi16(a, b), 8);
+}
+
+/*
+ * (a * b + 255) >> 8, as a8_mul_sym() does
+ */
+static inline SSE2 __m128i _mul_sym(__m128i a, __m128i b)
+{
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(a, b),
+			_mm_set1_epi16(255)), 8);
+}
+
+/*
+ * a + d * (256 - a) / 256, as a8_blend() does
+ */
+static inline SSE2 __m128i _blend(__m128i d, __m128i alo, __m128i ahi)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i k = _mm_set1_epi16(256);
+	__m128i dlo, dhi;
+
+	dlo = _mm_unpacklo_epi8(d, z);
+	dhi = _mm_unpackhi_epi8(d, z);
+	dlo = _mm_add_epi16(alo, _mul_256(dlo, _mm_sub_epi16(k, alo)));
+	dhi = _mm_add_epi16(ahi, _mul_256(dhi, _mm_sub_epi16(k, ahi)));
+
+	return _mm_packus_epi16(dlo, dhi);
+}
+/*----------------------------------------------------------------------------*
+ *                            Fill span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static SSE2 void _a8_sp_argb8888_none_none_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_none_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _mm_packus_epi16(alo, ahi));
+		d += 16;
+		s += 16;
+	}
+	a8_sp_argb8888_none_none_fill(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_argb8888_color_none_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_color_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _mm_packus_epi16(
+				_mul_sym(ca, alo), _mul_sym(ca, ahi)));
+		d += 16;
+		s += 16;
+	}
+	a8_sp_argb8888_color_none_fill(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_none_color_argb8888_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_none_color_argb8888_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i mlo, mhi;
+
+		_argb8888_alpha_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _mm_packus_epi16(
+				_mul_sym(ca, mlo), _mul_sym(ca, mhi)));
+		d += 16;
+		m += 16;
+	}
+	a8_sp_none_color_argb8888_fill(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_none_color_a8_fill(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca, one;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_none_color_a8_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	one = _mm_set1_epi16(1);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i mlo, mhi;
+
+		_a8_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _mm_packus_epi16(
+				_mul_256(ca, _mm_add_epi16(mlo, one)),
+				_mul_256(ca, _mm_add_epi16(mhi, one))));
+		d += 16;
+		m += 16;
+	}
+	a8_sp_none_color_a8_fill(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_argb8888_none_argb8888_fill(uint8_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_none_argb8888_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi, mlo, mhi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_argb8888_alpha_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _mm_packus_epi16(
+				_mul_sym(alo, mlo), _mul_sym(ahi, mhi)));
+		d += 16;
+		s += 16;
+		m += 16;
+	}
+	a8_sp_argb8888_none_argb8888_fill(d, len & 15, s, color, m);
+}
+/*----------------------------------------------------------------------------*
+ *                            Blend span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static SSE2 void _a8_sp_none_color_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_none_color_none_blend(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d), ca, ca));
+		d += 16;
+	}
+	a8_sp_none_color_none_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_argb8888_none_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_none_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d), alo, ahi));
+		d += 16;
+		s += 16;
+	}
+	a8_sp_argb8888_none_none_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_argb8888_color_none_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_color_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_sym(ca, alo), _mul_sym(ca, ahi)));
+		d += 16;
+		s += 16;
+	}
+	a8_sp_argb8888_color_none_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_a8_none_none_blend(uint8_t *d, uint32_t len,
+		uint8_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_a8_none_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_a8_load(s, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d), alo, ahi));
+		d += 16;
+		s += 16;
+	}
+	a8_sp_a8_none_none_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_none_color_argb8888_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca, one;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_none_color_argb8888_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	one = _mm_set1_epi16(1);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i mlo, mhi;
+
+		_argb8888_alpha_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_256(ca, _mm_add_epi16(mlo, one)),
+				_mul_256(ca, _mm_add_epi16(mhi, one))));
+		d += 16;
+		m += 16;
+	}
+	a8_sp_none_color_argb8888_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_none_color_a8_blend(uint8_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i ca;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_none_color_a8_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	ca = _mm_set1_epi16(color >> 24);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i mlo, mhi;
+
+		_a8_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_sym(ca, mlo), _mul_sym(ca, mhi)));
+		d += 16;
+		m += 16;
+	}
+	a8_sp_none_color_a8_blend(d, len & 15, s, color, m);
+}
+
+static SSE2 void _a8_sp_argb8888_none_argb8888_blend(uint8_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint8_t *end;
+	uint32_t head;
+	__m128i one;
+
+	head = ALIGN16_HEAD(d, len);
+	a8_sp_argb8888_none_argb8888_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	one = _mm_set1_epi16(1);
+	end = d + (len & ~15);
+	while (d < end)
+	{
+		__m128i alo, ahi, mlo, mhi;
+
+		_argb8888_alpha_load(s, &alo, &ahi);
+		_argb8888_alpha_load(m, &mlo, &mhi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_256(alo, _mm_add_epi16(mlo, one)),
+				_mul_256(ahi, _mm_add_epi16(mhi, one))));
+		d += 16;
+		s += 16;
+		m += 16;
+	}
+	a8_sp_argb8888_none_argb8888_blend(d, len & 15, s, color, m);
+}
+
+#undef SSE2
+#endif
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_compositor_a8_sse2_init(void)
+{
+#if ENESIM_CPU_X86
+	/* color */
+	enesim_compositor_span_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_none_color_none_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8);
+	/* pixel */
+	enesim_compositor_span_pixel_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_none_none_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_none_none_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_a8_none_none_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_A8);
+	/* mask color */
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_none_color_argb8888_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_none_color_a8_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_A8);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_none_color_argb8888_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_none_color_a8_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_A8);
+	/* pixel mask */
+	enesim_compositor_span_pixel_mask_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_none_argb8888_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_mask_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_none_argb8888_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	/* pixel color */
+	enesim_compositor_span_pixel_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_color_none_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_color_register(
+			ENESIM_COMPOSITOR_SPAN(_a8_sp_argb8888_color_none_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_A8,
+			ENESIM_FORMAT_ARGB8888);
+#endif
+}
+/** @endcond */
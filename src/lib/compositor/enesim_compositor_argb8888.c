@@ -24,6 +24,7 @@
 #include "enesim_format.h"
 
 #include "enesim_compositor_private.h"
+#include "enesim_cpu_private.h"
 /*============================================================================*
  *                                  Local                                     *
  *============================================================================*/
@@ -217,6 +218,21 @@ static void _span_register(void)
 			ENESIM_FORMAT_ARGB8888);
 }
 
+/* the rest of the operators use the generic functions directly */
+static void _rop_register(void)
+{
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(argb8888, dst_out,
+			ENESIM_ROP_DST_OUT);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(argb8888, src_in,
+			ENESIM_ROP_SRC_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(argb8888, dst_in,
+			ENESIM_ROP_DST_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(argb8888, multiply,
+			ENESIM_ROP_MULTIPLY);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(argb8888, screen,
+			ENESIM_ROP_SCREEN);
+}
+
 static void _point_register(void)
 {
 	/* color */
@@ -263,7 +279,15 @@ static void _point_register(void)
 void enesim_compositor_argb8888_init(void)
 {
 	_span_register();
+	_rop_register();
 	_point_register();
+	/* override the generic functions with the best ones the cpu can run */
+	if (enesim_cpu_feature_has(ENESIM_CPU_FEATURE_SSE2))
+		enesim_compositor_argb8888_sse2_init();
+	if (enesim_cpu_feature_has(ENESIM_CPU_FEATURE_SSSE3))
+		enesim_compositor_argb8888_ssse3_init();
+	if (enesim_cpu_feature_has(ENESIM_CPU_FEATURE_AVX2))
+		enesim_compositor_argb8888_avx2_init();
 }
 
 void enesim_compositor_argb8888_shutdown(void)
@@ -0,0 +1,904 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "enesim_private.h"
+#include "libargb.h"
+
+#include "enesim_main.h"
+#include "enesim_color.h"
+#include "enesim_format.h"
+
+#include "enesim_compositor_private.h"
+#include "enesim_cpu_private.h"
+
+#if ENESIM_CPU_X86
+#include <immintrin.h>
+#endif
+/*
+ * The AVX2 versions of the argb8888 kernels. They work on eight pixels at a
+ * time with the destination aligned to 32 bytes, the unaligned head and the
+ * tail are done with the generic functions. Every function must give the
+ * same result as the generic one, bit by bit. The unpacks and packs work
+ * inside every 128 bits lane, so the pixels keep their order
+ */
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#if ENESIM_CPU_X86
+#define AVX2 ENESIM_CPU_TARGET("avx2")
+
+/* number of pixels until d is aligned to 32 bytes */
+#define ALIGN32_HEAD(d, len) \
+	(((32 - ((uintptr_t)(d) & 31)) & 31) / 4 < (len) ? \
+	((32 - ((uintptr_t)(d) & 31)) & 31) / 4 : (len))
+
+/*
+ * [0a0a 0a0a 0a0a 0a0a] for every pixel, from the [000a] of every pixel
+ */
+static inline AVX2 void _alpha_unpack(__m256i a, __m256i *lo, __m256i *hi)
+{
+	a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+	*lo = _mm256_unpacklo_epi32(a, a);
+	*hi = _mm256_unpackhi_epi32(a, a);
+}
+
+/*
+ * [000a] for every pixel of an a8 mask
+ */
+static inline AVX2 __m256i _a8_load(uint8_t *m)
+{
+	return _mm256_cvtepu8_epi32(_mm_loadl_epi64((__m128i *)m));
+}
+
+/*
+ * c * a >> 8 on every channel, as argb8888_mul_256() does
+ */
+static inline AVX2 __m256i _mul_256(__m256i c, __m256i alo, __m256i ahi)
+{
+	__m256i z = _mm256_setzero_si256();
+	__m256i clo, chi;
+
+	clo = _mm256_unpacklo_epi8(c, z);
+	chi = _mm256_unpackhi_epi8(c, z);
+	clo = _mm256_srli_epi16(_mm256_mullo_epi16(clo, alo), 8);
+	chi = _mm256_srli_epi16(_mm256_mullo_epi16(chi, ahi), 8);
+
+	return _mm256_packus_epi16(clo, chi);
+}
+
+/*
+ * (c * a + 255) >> 8 on every channel, as argb8888_mul_sym() does
+ */
+static inline AVX2 __m256i _mul_sym(__m256i c, __m256i alo, __m256i ahi)
+{
+	__m256i z = _mm256_setzero_si256();
+	__m256i k = _mm256_set1_epi16(255);
+	__m256i clo, chi;
+
+	clo = _mm256_unpacklo_epi8(c, z);
+	chi = _mm256_unpackhi_epi8(c, z);
+	clo = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(clo, alo), k), 8);
+	chi = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(chi, ahi), k), 8);
+
+	return _mm256_packus_epi16(clo, chi);
+}
+
+/*
+ * As argb8888_mul4_sym() does, the green channel is not rounded
+ */
+static inline AVX2 __m256i _mul4_sym(__m256i c1, __m256i c2)
+{
+	__m256i z = _mm256_setzero_si256();
+	__m256i k = _mm256_set1_epi64x(UINT64_C(0x00ff00ff000000ff));
+	__m256i lo, hi;
+
+	lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c1, z), _mm256_unpacklo_epi8(c2, z));
+	hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c1, z), _mm256_unpackhi_epi8(c2, z));
+	lo = _mm256_srli_epi16(_mm256_add_epi16(lo, k), 8);
+	hi = _mm256_srli_epi16(_mm256_add_epi16(hi, k), 8);
+
+	return _mm256_packus_epi16(lo, hi);
+}
+
+/*
+ * s + d * (256 - sa) / 256, adding the whole pixel as argb8888_blend() does
+ */
+static inline AVX2 __m256i _blend(__m256i d, __m256i s)
+{
+	__m256i alo, ahi;
+
+	_alpha_unpack(_mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(s, 24)),
+			&alo, &ahi);
+	return _mm256_add_epi32(s, _mul_256(d, alo, ahi));
+}
+
+/*
+ * r where the mask is set, d otherwise
+ */
+static inline AVX2 __m256i _select(__m256i mask, __m256i r, __m256i d)
+{
+	return _mm256_or_si256(_mm256_and_si256(mask, r), _mm256_andnot_si256(mask, d));
+}
+
+/*
+ * The number of pixels from p to end, in steps of eight, that have the
+ * alpha a
+ */
+static inline AVX2 uint32_t _alpha_run(uint32_t *p, uint32_t *end, __m256i a)
+{
+	uint32_t *start = p;
+
+	while (p < end && _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_srli_epi32(
+			_mm256_loadu_si256((__m256i *)p), 24), a)) == -1)
+		p += 8;
+	return p - start;
+}
+
+/*
+ * Same as _alpha_run() but for an a8 mask
+ */
+static inline AVX2 uint32_t _a8_run(uint8_t *p, uint8_t *end, __m256i a)
+{
+	uint8_t *start = p;
+
+	while (p < end && _mm256_movemask_epi8(_mm256_cmpeq_epi32(_a8_load(p), a))
+			== -1)
+		p += 8;
+	return p - start;
+}
+/*----------------------------------------------------------------------------*
+ *                            Fill span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static AVX2 void _argb8888_sp_none_color_none_fill(uint32_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_none_fill(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		_mm256_store_si256((__m256i *)d, c);
+		d += 8;
+	}
+	argb8888_sp_none_color_none_fill(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_none_none_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		_mm256_store_si256((__m256i *)d,
+				_mm256_loadu_si256((__m256i *)s));
+		d += 8;
+		s += 8;
+	}
+	argb8888_sp_argb8888_none_none_fill(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_color_none_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c, full;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_color_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	full = _mm256_set1_epi32(0xffffffff);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i ss;
+
+		ss = _mm256_loadu_si256((__m256i *)s);
+		/* a full pixel gives the color, the mul does not */
+		_mm256_store_si256((__m256i *)d, _select(_mm256_cmpeq_epi32(ss, full),
+				c, _mul4_sym(c, ss)));
+		d += 8;
+		s += 8;
+	}
+	argb8888_sp_argb8888_color_none_fill(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_none_color_argb8888_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_argb8888_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i alo, ahi;
+
+		_alpha_unpack(_mm256_srli_epi32(_mm256_loadu_si256((__m256i *)m), 24),
+				&alo, &ahi);
+		_mm256_store_si256((__m256i *)d, _mul_sym(c, alo, ahi));
+		d += 8;
+		m += 8;
+	}
+	argb8888_sp_none_color_argb8888_fill(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_none_color_a8_fill(uint32_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c, one;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_a8_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	one = _mm256_set1_epi32(1);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i alo, ahi;
+
+		_alpha_unpack(_mm256_add_epi32(_a8_load(m), one), &alo, &ahi);
+		_mm256_store_si256((__m256i *)d, _mul_256(c, alo, ahi));
+		d += 8;
+		m += 8;
+	}
+	argb8888_sp_none_color_a8_fill(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_none_argb8888_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_none_argb8888_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i alo, ahi;
+
+		_alpha_unpack(_mm256_srli_epi32(_mm256_loadu_si256((__m256i *)m), 24),
+				&alo, &ahi);
+		_mm256_store_si256((__m256i *)d, _mul_sym(
+				_mm256_loadu_si256((__m256i *)s), alo, ahi));
+		d += 8;
+		s += 8;
+		m += 8;
+	}
+	argb8888_sp_argb8888_none_argb8888_fill(d, len & 7, s, color, m);
+}
+/*----------------------------------------------------------------------------*
+ *                            Blend span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static AVX2 void _argb8888_sp_none_color_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_none_blend(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		_mm256_store_si256((__m256i *)d, _blend(
+				_mm256_load_si256((__m256i *)d), c));
+		d += 8;
+	}
+	argb8888_sp_none_color_none_blend(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_none_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i z, opaque;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	z = _mm256_setzero_si256();
+	opaque = _mm256_set1_epi32(255);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i ss, sa, transparent, dd;
+		uint32_t n;
+		int mask;
+
+		ss = _mm256_loadu_si256((__m256i *)s);
+		sa = _mm256_srli_epi32(ss, 24);
+		transparent = _mm256_cmpeq_epi32(sa, z);
+		mask = _mm256_movemask_epi8(transparent);
+		/* all transparent, skip the whole transparent run */
+		if (mask == -1)
+		{
+			n = 8 + _alpha_run(s + 8, s + (end - d), z);
+			d += n;
+			s += n;
+			continue;
+		}
+		/* all opaque, copy the whole opaque run */
+		if (!mask && _mm256_movemask_epi8(_mm256_cmpeq_epi32(sa, opaque))
+				== -1)
+		{
+			n = 8 + _alpha_run(s + 8, s + (end - d), opaque);
+			memcpy(d, s, n * sizeof(uint32_t));
+			d += n;
+			s += n;
+			continue;
+		}
+		/* the transparent pixels are kept untouched */
+		dd = _mm256_load_si256((__m256i *)d);
+		_mm256_store_si256((__m256i *)d, _select(transparent, dd,
+				_blend(dd, ss)));
+		d += 8;
+		s += 8;
+	}
+	argb8888_sp_argb8888_none_none_blend(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_color_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_color_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i cs;
+
+		cs = _mul4_sym(c, _mm256_loadu_si256((__m256i *)s));
+		_mm256_store_si256((__m256i *)d, _blend(
+				_mm256_load_si256((__m256i *)d), cs));
+		d += 8;
+		s += 8;
+	}
+	argb8888_sp_argb8888_color_none_blend(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_none_color_argb8888_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c, one, z;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_argb8888_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	one = _mm256_set1_epi32(1);
+	z = _mm256_setzero_si256();
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i ma, alo, ahi;
+
+		ma = _mm256_srli_epi32(_mm256_loadu_si256((__m256i *)m), 24);
+		/* a transparent mask does not touch the destination, skip
+		 * the whole transparent run
+		 */
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(ma, z)) == -1)
+		{
+			uint32_t n;
+
+			n = 8 + _alpha_run(m + 8, m + (end - d), z);
+			d += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(_mm256_add_epi32(ma, one), &alo, &ahi);
+		_mm256_store_si256((__m256i *)d, _blend(
+				_mm256_load_si256((__m256i *)d),
+				_mul_256(c, alo, ahi)));
+		d += 8;
+		m += 8;
+	}
+	argb8888_sp_none_color_argb8888_blend(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_none_color_a8_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i c, z;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_none_color_a8_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm256_set1_epi32(color);
+	z = _mm256_setzero_si256();
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i ma, alo, ahi;
+
+		ma = _a8_load(m);
+		/* a transparent mask does not touch the destination, skip
+		 * the whole transparent run
+		 */
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(ma, z)) == -1)
+		{
+			uint32_t n;
+
+			n = 8 + _a8_run(m + 8, m + (end - d), z);
+			d += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(ma, &alo, &ahi);
+		_mm256_store_si256((__m256i *)d, _blend(
+				_mm256_load_si256((__m256i *)d),
+				_mul_sym(c, alo, ahi)));
+		d += 8;
+		m += 8;
+	}
+	argb8888_sp_none_color_a8_blend(d, len & 7, s, color, m);
+}
+
+static AVX2 void _argb8888_sp_argb8888_none_argb8888_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m256i one, z;
+
+	head = ALIGN32_HEAD(d, len);
+	argb8888_sp_argb8888_none_argb8888_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	one = _mm256_set1_epi32(1);
+	z = _mm256_setzero_si256();
+	end = d + (len & ~7);
+	while (d < end)
+	{
+		__m256i ma, mc, dd, alo, ahi, transparent;
+
+		ma = _mm256_srli_epi32(_mm256_loadu_si256((__m256i *)m), 24);
+		/* skip the whole transparent run of the mask */
+		if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(ma, z)) == -1)
+		{
+			uint32_t n;
+
+			n = 8 + _alpha_run(m + 8, m + (end - d), z);
+			d += n;
+			s += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(_mm256_add_epi32(ma, one), &alo, &ahi);
+		mc = _mul_256(_mm256_loadu_si256((__m256i *)s), alo, ahi);
+		/* the transparent pixels are kept untouched */
+		transparent = _mm256_cmpeq_epi32(_mm256_srli_epi32(mc, 24), z);
+		if (_mm256_movemask_epi8(transparent) == -1)
+			goto next;
+		dd = _mm256_load_si256((__m256i *)d);
+		_mm256_store_si256((__m256i *)d, _select(transparent, dd,
+				_blend(dd, mc)));
+next:
+		d += 8;
+		s += 8;
+		m += 8;
+	}
+	argb8888_sp_argb8888_none_argb8888_blend(d, len & 7, s, color, m);
+}
+
+/*----------------------------------------------------------------------------*
+ *                         Other operators funcitons                          *
+ *----------------------------------------------------------------------------*/
+/*
+ * (x * y + 255) >> 8 on every 16 bits channel
+ */
+static inline AVX2 __m256i _mul16_sym(__m256i x, __m256i y)
+{
+	return _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(x, y),
+			_mm256_set1_epi16(255)), 8);
+}
+
+static inline AVX2 __m256i _dst_out(__m256i d, __m256i s)
+{
+	__m256i alo, ahi;
+
+	_alpha_unpack(_mm256_sub_epi32(_mm256_set1_epi32(256), _mm256_srli_epi32(s, 24)),
+			&alo, &ahi);
+	return _mul_256(d, alo, ahi);
+}
+
+static inline AVX2 __m256i _src_in(__m256i d, __m256i s)
+{
+	__m256i alo, ahi;
+
+	_alpha_unpack(_mm256_add_epi32(_mm256_srli_epi32(d, 24), _mm256_set1_epi32(1)),
+			&alo, &ahi);
+	return _mul_256(s, alo, ahi);
+}
+
+static inline AVX2 __m256i _dst_in(__m256i d, __m256i s)
+{
+	__m256i alo, ahi;
+
+	_alpha_unpack(_mm256_add_epi32(_mm256_srli_epi32(s, 24), _mm256_set1_epi32(1)),
+			&alo, &ahi);
+	return _mul_256(d, alo, ahi);
+}
+
+/*
+ * As the generic function, the sum fits on 16 bits for premultiplied colors
+ */
+static inline AVX2 __m256i _multiply(__m256i d, __m256i s)
+{
+	__m256i z = _mm256_setzero_si256();
+	__m256i k = _mm256_set1_epi32(255);
+	__m256i islo, ishi, idlo, idhi;
+	__m256i slo, shi, dlo, dhi;
+	__m256i lo, hi;
+
+	_alpha_unpack(_mm256_sub_epi32(k, _mm256_srli_epi32(s, 24)), &islo, &ishi);
+	_alpha_unpack(_mm256_sub_epi32(k, _mm256_srli_epi32(d, 24)), &idlo, &idhi);
+	slo = _mm256_unpacklo_epi8(s, z);
+	shi = _mm256_unpackhi_epi8(s, z);
+	dlo = _mm256_unpacklo_epi8(d, z);
+	dhi = _mm256_unpackhi_epi8(d, z);
+	lo = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(slo, dlo),
+			_mm256_mullo_epi16(slo, idlo)), _mm256_mullo_epi16(dlo, islo));
+	hi = _mm256_add_epi16(_mm256_add_epi16(_mm256_mullo_epi16(shi, dhi),
+			_mm256_mullo_epi16(shi, idhi)), _mm256_mullo_epi16(dhi, ishi));
+	lo = _mm256_srli_epi16(_mm256_add_epi16(lo, _mm256_set1_epi16(255)), 8);
+	hi = _mm256_srli_epi16(_mm256_add_epi16(hi, _mm256_set1_epi16(255)), 8);
+
+	return _mm256_packus_epi16(lo, hi);
+}
+
+static inline AVX2 __m256i _screen(__m256i d, __m256i s)
+{
+	__m256i z = _mm256_setzero_si256();
+	__m256i slo, shi, dlo, dhi;
+	__m256i lo, hi;
+
+	slo = _mm256_unpacklo_epi8(s, z);
+	shi = _mm256_unpackhi_epi8(s, z);
+	dlo = _mm256_unpacklo_epi8(d, z);
+	dhi = _mm256_unpackhi_epi8(d, z);
+	lo = _mm256_sub_epi16(_mm256_add_epi16(slo, dlo), _mul16_sym(slo, dlo));
+	hi = _mm256_sub_epi16(_mm256_add_epi16(shi, dhi), _mul16_sym(shi, dhi));
+
+	return _mm256_packus_epi16(lo, hi);
+}
+
+/*
+ * The span functions of an operator, the source pixels are computed as the
+ * generic functions do and then combined with the destination
+ */
+#define ROP_SPANS(op)							\
+static AVX2 void _argb8888_sp_none_color_none_##op(uint32_t *d,		\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m256i c;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_none_color_none_##op(d, head, s, color, m);		\
+	d += head;							\
+	len -= head;							\
+									\
+	c = _mm256_set1_epi32(color);					\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d), c));	\
+		d += 8;							\
+	}								\
+	argb8888_sp_none_color_none_##op(d, len & 7, s, color, m);	\
+}									\
+									\
+static AVX2 void _argb8888_sp_argb8888_none_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_argb8888_none_none_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	len -= head;							\
+									\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d),	\
+				_mm256_loadu_si256((__m256i *)s)));	\
+		d += 8;							\
+		s += 8;							\
+	}								\
+	argb8888_sp_argb8888_none_none_##op(d, len & 7, s, color, m);	\
+}									\
+									\
+static AVX2 void _argb8888_sp_argb8888_color_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m256i c;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_argb8888_color_none_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	len -= head;							\
+									\
+	c = _mm256_set1_epi32(color);					\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d),	\
+				_mul4_sym(c, _mm256_loadu_si256((__m256i *)s))));	\
+		d += 8;							\
+		s += 8;							\
+	}								\
+	argb8888_sp_argb8888_color_none_##op(d, len & 7, s, color, m);	\
+}									\
+									\
+static AVX2 void _argb8888_sp_none_color_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m256i c;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_none_color_argb8888_##op(d, head, s, color, m);	\
+	d += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	c = _mm256_set1_epi32(color);					\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		__m256i alo, ahi;					\
+									\
+		_alpha_unpack(_mm256_srli_epi32(			\
+				_mm256_loadu_si256((__m256i *)m), 24),	\
+				&alo, &ahi);				\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d),	\
+				_mul_sym(c, alo, ahi)));		\
+		d += 8;							\
+		m += 8;							\
+	}								\
+	argb8888_sp_none_color_argb8888_##op(d, len & 7, s, color, m);	\
+}									\
+									\
+static AVX2 void _argb8888_sp_none_color_a8_##op(uint32_t *d,		\
+		uint32_t len, uint32_t *s, uint32_t color, uint8_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m256i c;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_none_color_a8_##op(d, head, s, color, m);		\
+	d += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	c = _mm256_set1_epi32(color);					\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		__m256i alo, ahi;					\
+									\
+		_alpha_unpack(_a8_load(m), &alo, &ahi);			\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d),	\
+				_mul_sym(c, alo, ahi)));		\
+		d += 8;							\
+		m += 8;							\
+	}								\
+	argb8888_sp_none_color_a8_##op(d, len & 7, s, color, m);	\
+}									\
+									\
+static AVX2 void _argb8888_sp_argb8888_none_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+									\
+	head = ALIGN32_HEAD(d, len);					\
+	argb8888_sp_argb8888_none_argb8888_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	end = d + (len & ~7);						\
+	while (d < end)							\
+	{								\
+		__m256i alo, ahi;					\
+									\
+		_alpha_unpack(_mm256_srli_epi32(			\
+				_mm256_loadu_si256((__m256i *)m), 24),	\
+				&alo, &ahi);				\
+		_mm256_store_si256((__m256i *)d, _##op(			\
+				_mm256_load_si256((__m256i *)d),	\
+				_mul_sym(_mm256_loadu_si256((__m256i *)s),	\
+				alo, ahi)));				\
+		d += 8;							\
+		s += 8;							\
+		m += 8;							\
+	}								\
+	argb8888_sp_argb8888_none_argb8888_##op(d, len & 7, s, color, m);	\
+}
+
+ROP_SPANS(dst_out)
+ROP_SPANS(src_in)
+ROP_SPANS(dst_in)
+ROP_SPANS(multiply)
+ROP_SPANS(screen)
+
+#undef ROP_SPANS
+
+#undef AVX2
+#endif
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_compositor_argb8888_avx2_init(void)
+{
+#if ENESIM_CPU_X86
+	/* color */
+	enesim_compositor_span_color_register(
+			_argb8888_sp_none_color_none_fill, ENESIM_ROP_FILL,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_color_register(
+			_argb8888_sp_none_color_none_blend, ENESIM_ROP_BLEND,
+			ENESIM_FORMAT_ARGB8888);
+	/* pixel */
+	enesim_compositor_span_pixel_register(_argb8888_sp_argb8888_none_none_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_register(_argb8888_sp_argb8888_none_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* mask color */
+	enesim_compositor_span_mask_color_register(
+			_argb8888_sp_none_color_argb8888_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_argb8888_sp_none_color_a8_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_A8);
+	enesim_compositor_span_mask_color_register(
+			_argb8888_sp_none_color_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_argb8888_sp_none_color_a8_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_A8);
+	/* pixel mask */
+	enesim_compositor_span_pixel_mask_register(
+			_argb8888_sp_argb8888_none_argb8888_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_mask_register(
+			_argb8888_sp_argb8888_none_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	/* pixel color */
+	enesim_compositor_span_pixel_color_register(
+			_argb8888_sp_argb8888_color_none_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_color_register(
+			_argb8888_sp_argb8888_color_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* other operators */
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, dst_out,
+			ENESIM_ROP_DST_OUT);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, src_in,
+			ENESIM_ROP_SRC_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, dst_in,
+			ENESIM_ROP_DST_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, multiply,
+			ENESIM_ROP_MULTIPLY);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, screen,
+			ENESIM_ROP_SCREEN);
+#endif
+}
+/** @endcond */
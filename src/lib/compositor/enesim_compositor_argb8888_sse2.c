@@ -0,0 +1,1012 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "enesim_private.h"
+#include "libargb.h"
+
+#include "enesim_main.h"
+#include "enesim_color.h"
+#include "enesim_format.h"
+
+#include "enesim_compositor_private.h"
+#include "enesim_cpu_private.h"
+
+#if ENESIM_CPU_X86
+#include <emmintrin.h>
+#endif
+/*
+ * The SSE2 versions of the argb8888 kernels. They work on four pixels at a
+ * time with the destination aligned to 16 bytes, the unaligned head and the
+ * tail are done with the generic functions. Every function must give the
+ * same result as the generic one, bit by bit
+ */
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#if ENESIM_CPU_X86
+#define SSE2 ENESIM_CPU_TARGET("sse2")
+
+/* number of pixels until d is aligned to 16 bytes */
+#define ALIGN16_HEAD(d, len) \
+	(((16 - ((uintptr_t)(d) & 15)) & 15) / 4 < (len) ? \
+	((16 - ((uintptr_t)(d) & 15)) & 15) / 4 : (len))
+
+/*
+ * [0a0a 0a0a 0a0a 0a0a] for every pixel, from the [000a] of every pixel
+ */
+static inline SSE2 void _alpha_unpack(__m128i a, __m128i *lo, __m128i *hi)
+{
+	a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+	*lo = _mm_unpacklo_epi32(a, a);
+	*hi = _mm_unpackhi_epi32(a, a);
+}
+
+/*
+ * [000a] for every pixel of an a8 mask
+ */
+static inline SSE2 __m128i _a8_load(uint8_t *m)
+{
+	__m128i z = _mm_setzero_si128();
+	uint32_t m4;
+
+	memcpy(&m4, m, sizeof(uint32_t));
+	return _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(m4), z), z);
+}
+
+/*
+ * c * a >> 8 on every channel, as argb8888_mul_256() does
+ */
+static inline SSE2 __m128i _mul_256(__m128i c, __m128i alo, __m128i ahi)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i clo, chi;
+
+	clo = _mm_unpacklo_epi8(c, z);
+	chi = _mm_unpackhi_epi8(c, z);
+	clo = _mm_srli_epi16(_mm_mullo_epi16(clo, alo), 8);
+	chi = _mm_srli_epi16(_mm_mullo_epi16(chi, ahi), 8);
+
+	return _mm_packus_epi16(clo, chi);
+}
+
+/*
+ * (c * a + 255) >> 8 on every channel, as argb8888_mul_sym() does
+ */
+static inline SSE2 __m128i _mul_sym(__m128i c, __m128i alo, __m128i ahi)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i k = _mm_set1_epi16(255);
+	__m128i clo, chi;
+
+	clo = _mm_unpacklo_epi8(c, z);
+	chi = _mm_unpackhi_epi8(c, z);
+	clo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(clo, alo), k), 8);
+	chi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(chi, ahi), k), 8);
+
+	return _mm_packus_epi16(clo, chi);
+}
+
+/*
+ * As argb8888_mul4_sym() does, the green channel is not rounded
+ */
+static inline SSE2 __m128i _mul4_sym(__m128i c1, __m128i c2)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i k = _mm_set_epi16(255, 255, 0, 255, 255, 255, 0, 255);
+	__m128i lo, hi;
+
+	lo = _mm_mullo_epi16(_mm_unpacklo_epi8(c1, z), _mm_unpacklo_epi8(c2, z));
+	hi = _mm_mullo_epi16(_mm_unpackhi_epi8(c1, z), _mm_unpackhi_epi8(c2, z));
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, k), 8);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, k), 8);
+
+	return _mm_packus_epi16(lo, hi);
+}
+
+/*
+ * s + d * (256 - sa) / 256, adding the whole pixel as argb8888_blend() does
+ */
+static inline SSE2 __m128i _blend(__m128i d, __m128i s)
+{
+	__m128i alo, ahi;
+
+	_alpha_unpack(_mm_sub_epi32(_mm_set1_epi32(256), _mm_srli_epi32(s, 24)),
+			&alo, &ahi);
+	return _mm_add_epi32(s, _mul_256(d, alo, ahi));
+}
+
+/*
+ * r where the mask is set, d otherwise
+ */
+static inline SSE2 __m128i _select(__m128i mask, __m128i r, __m128i d)
+{
+	return _mm_or_si128(_mm_and_si128(mask, r), _mm_andnot_si128(mask, d));
+}
+
+/*
+ * The number of pixels from p to end, in steps of four, that have the
+ * alpha a
+ */
+static inline SSE2 uint32_t _alpha_run(uint32_t *p, uint32_t *end, __m128i a)
+{
+	uint32_t *start = p;
+
+	while (p < end && _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(
+			_mm_loadu_si128((__m128i *)p), 24), a)) == 0xffff)
+		p += 4;
+	return p - start;
+}
+
+/*
+ * Same as _alpha_run() but for an a8 mask
+ */
+static inline SSE2 uint32_t _a8_run(uint8_t *p, uint8_t *end, __m128i a)
+{
+	uint8_t *start = p;
+
+	while (p < end && _mm_movemask_epi8(_mm_cmpeq_epi32(_a8_load(p), a))
+			== 0xffff)
+		p += 4;
+	return p - start;
+}
+/*----------------------------------------------------------------------------*
+ *                            Fill span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static SSE2 void _argb8888_sp_none_color_none_fill(uint32_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_none_fill(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		_mm_store_si128((__m128i *)d, c);
+		d += 4;
+	}
+	argb8888_sp_none_color_none_fill(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_argb8888_none_none_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		_mm_store_si128((__m128i *)d,
+				_mm_loadu_si128((__m128i *)s));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_none_none_fill(d, len & 3, s, color, m);
+}
+
+/*
+ * The streaming versions of the fills, for destinations bigger than the
+ * cache. The stores go directly to memory without reading the lines first
+ * and without evicting the rest of the cache
+ */
+static SSE2 void _argb8888_sp_none_color_none_fill_stream(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_none_fill(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		_mm_stream_si128((__m128i *)d, c);
+		d += 4;
+	}
+	argb8888_sp_none_color_none_fill(d, len & 3, s, color, m);
+	/* the streaming stores are weakly ordered */
+	_mm_sfence();
+}
+
+static SSE2 void _argb8888_sp_argb8888_none_none_fill_stream(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		_mm_stream_si128((__m128i *)d,
+				_mm_loadu_si128((__m128i *)s));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_none_none_fill(d, len & 3, s, color, m);
+	_mm_sfence();
+}
+
+static SSE2 void _argb8888_sp_argb8888_color_none_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c, full;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_color_none_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	full = _mm_set1_epi32(0xffffffff);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ss;
+
+		ss = _mm_loadu_si128((__m128i *)s);
+		/* a full pixel gives the color, the mul does not */
+		_mm_store_si128((__m128i *)d, _select(_mm_cmpeq_epi32(ss, full),
+				c, _mul4_sym(c, ss)));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_color_none_fill(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_none_color_argb8888_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_argb8888_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_alpha_unpack(_mm_srli_epi32(_mm_loadu_si128((__m128i *)m), 24),
+				&alo, &ahi);
+		_mm_store_si128((__m128i *)d, _mul_sym(c, alo, ahi));
+		d += 4;
+		m += 4;
+	}
+	argb8888_sp_none_color_argb8888_fill(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_none_color_a8_fill(uint32_t *d, uint32_t len,
+		uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c, one;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_a8_fill(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	one = _mm_set1_epi32(1);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_alpha_unpack(_mm_add_epi32(_a8_load(m), one), &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _mul_256(c, alo, ahi));
+		d += 4;
+		m += 4;
+	}
+	argb8888_sp_none_color_a8_fill(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_argb8888_none_argb8888_fill(uint32_t *d,
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_argb8888_fill(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i alo, ahi;
+
+		_alpha_unpack(_mm_srli_epi32(_mm_loadu_si128((__m128i *)m), 24),
+				&alo, &ahi);
+		_mm_store_si128((__m128i *)d, _mul_sym(
+				_mm_loadu_si128((__m128i *)s), alo, ahi));
+		d += 4;
+		s += 4;
+		m += 4;
+	}
+	argb8888_sp_argb8888_none_argb8888_fill(d, len & 3, s, color, m);
+}
+/*----------------------------------------------------------------------------*
+ *                           Blend point funcitons                            *
+ *----------------------------------------------------------------------------*/
+/*
+ * A single pixel on the low lane, as the old MMX points did, the whole
+ * blend is done without moving the channels to scalar registers
+ */
+static SSE2 void _argb8888_pt_none_color_none_blend(uint32_t *d,
+		uint32_t s, uint32_t color, uint32_t m)
+{
+	*d = _mm_cvtsi128_si32(_blend(_mm_cvtsi32_si128(*d),
+			_mm_cvtsi32_si128(color)));
+}
+
+static SSE2 void _argb8888_pt_none_color_argb8888_blend(uint32_t *d,
+		uint32_t s, uint32_t color, uint32_t m)
+{
+	__m128i alo, ahi;
+
+	/* a transparent mask does not touch the destination */
+	if (!(m >> 24))
+		return;
+	_alpha_unpack(_mm_cvtsi32_si128(m >> 24), &alo, &ahi);
+	*d = _mm_cvtsi128_si32(_blend(_mm_cvtsi32_si128(*d),
+			_mul_sym(_mm_cvtsi32_si128(color), alo, ahi)));
+}
+
+static SSE2 void _argb8888_pt_argb8888_none_none_blend(uint32_t *d,
+		uint32_t s, uint32_t color, uint32_t m)
+{
+	*d = _mm_cvtsi128_si32(_blend(_mm_cvtsi32_si128(*d),
+			_mm_cvtsi32_si128(s)));
+}
+/*----------------------------------------------------------------------------*
+ *                            Blend span funcitons                            *
+ *----------------------------------------------------------------------------*/
+static SSE2 void _argb8888_sp_none_color_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_none_blend(d, head, s, color, m);
+	d += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d), c));
+		d += 4;
+	}
+	argb8888_sp_none_color_none_blend(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_argb8888_none_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i z, opaque;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	z = _mm_setzero_si128();
+	opaque = _mm_set1_epi32(255);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ss, sa, transparent, dd;
+		uint32_t n;
+		int mask;
+
+		ss = _mm_loadu_si128((__m128i *)s);
+		sa = _mm_srli_epi32(ss, 24);
+		transparent = _mm_cmpeq_epi32(sa, z);
+		mask = _mm_movemask_epi8(transparent);
+		/* all transparent, skip the whole transparent run */
+		if (mask == 0xffff)
+		{
+			n = 4 + _alpha_run(s + 4, s + (end - d), z);
+			d += n;
+			s += n;
+			continue;
+		}
+		/* all opaque, copy the whole opaque run */
+		if (!mask && _mm_movemask_epi8(_mm_cmpeq_epi32(sa, opaque))
+				== 0xffff)
+		{
+			n = 4 + _alpha_run(s + 4, s + (end - d), opaque);
+			memcpy(d, s, n * sizeof(uint32_t));
+			d += n;
+			s += n;
+			continue;
+		}
+		/* the transparent pixels are kept untouched */
+		dd = _mm_load_si128((__m128i *)d);
+		_mm_store_si128((__m128i *)d, _select(transparent, dd,
+				_blend(dd, ss)));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_none_none_blend(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_argb8888_color_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_color_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i cs;
+
+		cs = _mul4_sym(c, _mm_loadu_si128((__m128i *)s));
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d), cs));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_color_none_blend(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_none_color_argb8888_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c, one, z;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_argb8888_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	one = _mm_set1_epi32(1);
+	z = _mm_setzero_si128();
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ma, alo, ahi;
+
+		ma = _mm_srli_epi32(_mm_loadu_si128((__m128i *)m), 24);
+		/* a transparent mask does not touch the destination, skip
+		 * the whole transparent run
+		 */
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(ma, z)) == 0xffff)
+		{
+			uint32_t n;
+
+			n = 4 + _alpha_run(m + 4, m + (end - d), z);
+			d += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(_mm_add_epi32(ma, one), &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_256(c, alo, ahi)));
+		d += 4;
+		m += 4;
+	}
+	argb8888_sp_none_color_argb8888_blend(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_none_color_a8_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint8_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i c, z;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_none_color_a8_blend(d, head, s, color, m);
+	d += head;
+	m += head;
+	len -= head;
+
+	c = _mm_set1_epi32(color);
+	z = _mm_setzero_si128();
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ma, alo, ahi;
+
+		ma = _a8_load(m);
+		/* a transparent mask does not touch the destination, skip
+		 * the whole transparent run
+		 */
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(ma, z)) == 0xffff)
+		{
+			uint32_t n;
+
+			n = 4 + _a8_run(m + 4, m + (end - d), z);
+			d += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(ma, &alo, &ahi);
+		_mm_store_si128((__m128i *)d, _blend(
+				_mm_load_si128((__m128i *)d),
+				_mul_sym(c, alo, ahi)));
+		d += 4;
+		m += 4;
+	}
+	argb8888_sp_none_color_a8_blend(d, len & 3, s, color, m);
+}
+
+static SSE2 void _argb8888_sp_argb8888_none_argb8888_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i one, z;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_argb8888_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	one = _mm_set1_epi32(1);
+	z = _mm_setzero_si128();
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ma, mc, dd, alo, ahi, transparent;
+
+		ma = _mm_srli_epi32(_mm_loadu_si128((__m128i *)m), 24);
+		/* skip the whole transparent run of the mask */
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(ma, z)) == 0xffff)
+		{
+			uint32_t n;
+
+			n = 4 + _alpha_run(m + 4, m + (end - d), z);
+			d += n;
+			s += n;
+			m += n;
+			continue;
+		}
+		_alpha_unpack(_mm_add_epi32(ma, one), &alo, &ahi);
+		mc = _mul_256(_mm_loadu_si128((__m128i *)s), alo, ahi);
+		/* the transparent pixels are kept untouched */
+		transparent = _mm_cmpeq_epi32(_mm_srli_epi32(mc, 24), z);
+		if (_mm_movemask_epi8(transparent) == 0xffff)
+			goto next;
+		dd = _mm_load_si128((__m128i *)d);
+		_mm_store_si128((__m128i *)d, _select(transparent, dd,
+				_blend(dd, mc)));
+next:
+		d += 4;
+		s += 4;
+		m += 4;
+	}
+	argb8888_sp_argb8888_none_argb8888_blend(d, len & 3, s, color, m);
+}
+
+/*----------------------------------------------------------------------------*
+ *                         Other operators funcitons                          *
+ *----------------------------------------------------------------------------*/
+/*
+ * (x * y + 255) >> 8 on every 16 bits channel
+ */
+static inline SSE2 __m128i _mul16_sym(__m128i x, __m128i y)
+{
+	return _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(x, y),
+			_mm_set1_epi16(255)), 8);
+}
+
+static inline SSE2 __m128i _dst_out(__m128i d, __m128i s)
+{
+	__m128i alo, ahi;
+
+	_alpha_unpack(_mm_sub_epi32(_mm_set1_epi32(256), _mm_srli_epi32(s, 24)),
+			&alo, &ahi);
+	return _mul_256(d, alo, ahi);
+}
+
+static inline SSE2 __m128i _src_in(__m128i d, __m128i s)
+{
+	__m128i alo, ahi;
+
+	_alpha_unpack(_mm_add_epi32(_mm_srli_epi32(d, 24), _mm_set1_epi32(1)),
+			&alo, &ahi);
+	return _mul_256(s, alo, ahi);
+}
+
+static inline SSE2 __m128i _dst_in(__m128i d, __m128i s)
+{
+	__m128i alo, ahi;
+
+	_alpha_unpack(_mm_add_epi32(_mm_srli_epi32(s, 24), _mm_set1_epi32(1)),
+			&alo, &ahi);
+	return _mul_256(d, alo, ahi);
+}
+
+/*
+ * As the generic function, the sum fits on 16 bits for premultiplied colors
+ */
+static inline SSE2 __m128i _multiply(__m128i d, __m128i s)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i k = _mm_set1_epi32(255);
+	__m128i islo, ishi, idlo, idhi;
+	__m128i slo, shi, dlo, dhi;
+	__m128i lo, hi;
+
+	_alpha_unpack(_mm_sub_epi32(k, _mm_srli_epi32(s, 24)), &islo, &ishi);
+	_alpha_unpack(_mm_sub_epi32(k, _mm_srli_epi32(d, 24)), &idlo, &idhi);
+	slo = _mm_unpacklo_epi8(s, z);
+	shi = _mm_unpackhi_epi8(s, z);
+	dlo = _mm_unpacklo_epi8(d, z);
+	dhi = _mm_unpackhi_epi8(d, z);
+	lo = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(slo, dlo),
+			_mm_mullo_epi16(slo, idlo)), _mm_mullo_epi16(dlo, islo));
+	hi = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(shi, dhi),
+			_mm_mullo_epi16(shi, idhi)), _mm_mullo_epi16(dhi, ishi));
+	lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_set1_epi16(255)), 8);
+	hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_set1_epi16(255)), 8);
+
+	return _mm_packus_epi16(lo, hi);
+}
+
+static inline SSE2 __m128i _screen(__m128i d, __m128i s)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i slo, shi, dlo, dhi;
+	__m128i lo, hi;
+
+	slo = _mm_unpacklo_epi8(s, z);
+	shi = _mm_unpackhi_epi8(s, z);
+	dlo = _mm_unpacklo_epi8(d, z);
+	dhi = _mm_unpackhi_epi8(d, z);
+	lo = _mm_sub_epi16(_mm_add_epi16(slo, dlo), _mul16_sym(slo, dlo));
+	hi = _mm_sub_epi16(_mm_add_epi16(shi, dhi), _mul16_sym(shi, dhi));
+
+	return _mm_packus_epi16(lo, hi);
+}
+
+/*
+ * The span functions of an operator, the source pixels are computed as the
+ * generic functions do and then combined with the destination
+ */
+#define ROP_SPANS(op)							\
+static SSE2 void _argb8888_sp_none_color_none_##op(uint32_t *d,		\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m128i c;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_none_color_none_##op(d, head, s, color, m);		\
+	d += head;							\
+	len -= head;							\
+									\
+	c = _mm_set1_epi32(color);					\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d), c));	\
+		d += 4;							\
+	}								\
+	argb8888_sp_none_color_none_##op(d, len & 3, s, color, m);	\
+}									\
+									\
+static SSE2 void _argb8888_sp_argb8888_none_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_argb8888_none_none_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	len -= head;							\
+									\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d),		\
+				_mm_loadu_si128((__m128i *)s)));	\
+		d += 4;							\
+		s += 4;							\
+	}								\
+	argb8888_sp_argb8888_none_none_##op(d, len & 3, s, color, m);	\
+}									\
+									\
+static SSE2 void _argb8888_sp_argb8888_color_none_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m128i c;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_argb8888_color_none_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	len -= head;							\
+									\
+	c = _mm_set1_epi32(color);					\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d),		\
+				_mul4_sym(c, _mm_loadu_si128((__m128i *)s))));	\
+		d += 4;							\
+		s += 4;							\
+	}								\
+	argb8888_sp_argb8888_color_none_##op(d, len & 3, s, color, m);	\
+}									\
+									\
+static SSE2 void _argb8888_sp_none_color_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m128i c;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_none_color_argb8888_##op(d, head, s, color, m);	\
+	d += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	c = _mm_set1_epi32(color);					\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		__m128i alo, ahi;					\
+									\
+		_alpha_unpack(_mm_srli_epi32(				\
+				_mm_loadu_si128((__m128i *)m), 24),	\
+				&alo, &ahi);				\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d),		\
+				_mul_sym(c, alo, ahi)));		\
+		d += 4;							\
+		m += 4;							\
+	}								\
+	argb8888_sp_none_color_argb8888_##op(d, len & 3, s, color, m);	\
+}									\
+									\
+static SSE2 void _argb8888_sp_none_color_a8_##op(uint32_t *d,		\
+		uint32_t len, uint32_t *s, uint32_t color, uint8_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+	__m128i c;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_none_color_a8_##op(d, head, s, color, m);		\
+	d += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	c = _mm_set1_epi32(color);					\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		__m128i alo, ahi;					\
+									\
+		_alpha_unpack(_a8_load(m), &alo, &ahi);			\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d),		\
+				_mul_sym(c, alo, ahi)));		\
+		d += 4;							\
+		m += 4;							\
+	}								\
+	argb8888_sp_none_color_a8_##op(d, len & 3, s, color, m);	\
+}									\
+									\
+static SSE2 void _argb8888_sp_argb8888_none_argb8888_##op(uint32_t *d,	\
+		uint32_t len, uint32_t *s, uint32_t color, uint32_t *m)	\
+{									\
+	uint32_t *end;							\
+	uint32_t head;							\
+									\
+	head = ALIGN16_HEAD(d, len);					\
+	argb8888_sp_argb8888_none_argb8888_##op(d, head, s, color, m);	\
+	d += head;							\
+	s += head;							\
+	m += head;							\
+	len -= head;							\
+									\
+	end = d + (len & ~3);						\
+	while (d < end)							\
+	{								\
+		__m128i alo, ahi;					\
+									\
+		_alpha_unpack(_mm_srli_epi32(				\
+				_mm_loadu_si128((__m128i *)m), 24),	\
+				&alo, &ahi);				\
+		_mm_store_si128((__m128i *)d, _##op(			\
+				_mm_load_si128((__m128i *)d),		\
+				_mul_sym(_mm_loadu_si128((__m128i *)s),	\
+				alo, ahi)));				\
+		d += 4;							\
+		s += 4;							\
+		m += 4;							\
+	}								\
+	argb8888_sp_argb8888_none_argb8888_##op(d, len & 3, s, color, m);	\
+}
+
+ROP_SPANS(dst_out)
+ROP_SPANS(src_in)
+ROP_SPANS(dst_in)
+ROP_SPANS(multiply)
+ROP_SPANS(screen)
+
+#undef ROP_SPANS
+
+#undef SSE2
+#endif
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_compositor_argb8888_sse2_init(void)
+{
+#if ENESIM_CPU_X86
+	/* color */
+	enesim_compositor_span_color_register(
+			_argb8888_sp_none_color_none_fill, ENESIM_ROP_FILL,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_color_register(
+			_argb8888_sp_none_color_none_blend, ENESIM_ROP_BLEND,
+			ENESIM_FORMAT_ARGB8888);
+	/* pixel */
+	enesim_compositor_span_pixel_register(_argb8888_sp_argb8888_none_none_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_register(_argb8888_sp_argb8888_none_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* stream */
+	enesim_compositor_span_stream_color_register(
+			_argb8888_sp_none_color_none_fill_stream,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_stream_pixel_register(
+			_argb8888_sp_argb8888_none_none_fill_stream,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	/* mask color */
+	enesim_compositor_span_mask_color_register(
+			_argb8888_sp_none_color_argb8888_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_argb8888_sp_none_color_a8_fill),
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_A8);
+	enesim_compositor_span_mask_color_register(
+			_argb8888_sp_none_color_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_mask_color_register(
+			ENESIM_COMPOSITOR_SPAN(_argb8888_sp_none_color_a8_blend),
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_A8);
+	/* pixel mask */
+	enesim_compositor_span_pixel_mask_register(
+			_argb8888_sp_argb8888_none_argb8888_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_mask_register(
+			_argb8888_sp_argb8888_none_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+	/* pixel color */
+	enesim_compositor_span_pixel_color_register(
+			_argb8888_sp_argb8888_color_none_fill,
+			ENESIM_ROP_FILL, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_span_pixel_color_register(
+			_argb8888_sp_argb8888_color_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* points */
+	enesim_compositor_pt_color_register(
+			_argb8888_pt_none_color_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_pt_mask_color_register(
+			_argb8888_pt_none_color_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	enesim_compositor_pt_pixel_register(
+			_argb8888_pt_argb8888_none_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* other operators */
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, dst_out,
+			ENESIM_ROP_DST_OUT);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, src_in,
+			ENESIM_ROP_SRC_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, dst_in,
+			ENESIM_ROP_DST_IN);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, multiply,
+			ENESIM_ROP_MULTIPLY);
+	ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(_argb8888, screen,
+			ENESIM_ROP_SCREEN);
+#endif
+}
+/** @endcond */
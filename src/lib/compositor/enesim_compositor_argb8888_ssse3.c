@@ -0,0 +1,239 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "enesim_private.h"
+#include "libargb.h"
+
+#include "enesim_main.h"
+#include "enesim_color.h"
+#include "enesim_format.h"
+
+#include "enesim_compositor_private.h"
+#include "enesim_cpu_private.h"
+
+#if ENESIM_CPU_X86
+#include <tmmintrin.h>
+#endif
+/*
+ * The SSSE3 versions of the argb8888 blend kernels. They are the same as the
+ * SSE2 ones but the alpha of every pixel is spread over its channels with a
+ * single shuffle. Every function must give the same result as the generic
+ * one, bit by bit
+ */
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#if ENESIM_CPU_X86
+#define SSSE3 ENESIM_CPU_TARGET("ssse3")
+
+/* number of pixels until d is aligned to 16 bytes */
+#define ALIGN16_HEAD(d, len) \
+	(((16 - ((uintptr_t)(d) & 15)) & 15) / 4 < (len) ? \
+	((16 - ((uintptr_t)(d) & 15)) & 15) / 4 : (len))
+
+/*
+ * [0a0a 0a0a] of the first and last two pixels, from the [a000] of every
+ * pixel
+ */
+static inline SSSE3 void _alpha_shuffle(__m128i c, __m128i *lo, __m128i *hi)
+{
+	*lo = _mm_shuffle_epi8(c, _mm_set_epi8(-1, 7, -1, 7, -1, 7, -1, 7,
+			-1, 3, -1, 3, -1, 3, -1, 3));
+	*hi = _mm_shuffle_epi8(c, _mm_set_epi8(-1, 15, -1, 15, -1, 15, -1, 15,
+			-1, 11, -1, 11, -1, 11, -1, 11));
+}
+
+/*
+ * c * a >> 8 on every channel, as argb8888_mul_256() does
+ */
+static inline SSSE3 __m128i _mul_256(__m128i c, __m128i alo, __m128i ahi)
+{
+	__m128i z = _mm_setzero_si128();
+	__m128i clo, chi;
+
+	clo = _mm_unpacklo_epi8(c, z);
+	chi = _mm_unpackhi_epi8(c, z);
+	clo = _mm_srli_epi16(_mm_mullo_epi16(clo, alo), 8);
+	chi = _mm_srli_epi16(_mm_mullo_epi16(chi, ahi), 8);
+
+	return _mm_packus_epi16(clo, chi);
+}
+
+/*
+ * s + d * (256 - sa) / 256, adding the whole pixel as argb8888_blend() does
+ */
+static inline SSSE3 __m128i _blend(__m128i d, __m128i s)
+{
+	__m128i k = _mm_set1_epi16(256);
+	__m128i alo, ahi;
+
+	_alpha_shuffle(s, &alo, &ahi);
+	return _mm_add_epi32(s, _mul_256(d, _mm_sub_epi16(k, alo),
+			_mm_sub_epi16(k, ahi)));
+}
+
+/*
+ * r where the mask is set, d otherwise
+ */
+static inline SSSE3 __m128i _select(__m128i mask, __m128i r, __m128i d)
+{
+	return _mm_or_si128(_mm_and_si128(mask, r), _mm_andnot_si128(mask, d));
+}
+
+/*
+ * The number of pixels from p with an alpha of a, in blocks of four pixels
+ */
+static inline SSSE3 uint32_t _alpha_run(uint32_t *p, uint32_t *end, __m128i a)
+{
+	uint32_t *start = p;
+
+	while (p < end && _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(
+			_mm_loadu_si128((__m128i *)p), 24), a)) == 0xffff)
+		p += 4;
+	return p - start;
+}
+/*----------------------------------------------------------------------------*
+ *                           Blend span funcitons                             *
+ *----------------------------------------------------------------------------*/
+static SSSE3 void _argb8888_sp_argb8888_none_none_blend(uint32_t *d,
+		unsigned int len, uint32_t *s,
+		uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i z, opaque;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_none_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	len -= head;
+
+	z = _mm_setzero_si128();
+	opaque = _mm_set1_epi32(255);
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i ss, sa, transparent, dd;
+		uint32_t n;
+		int mask;
+
+		ss = _mm_loadu_si128((__m128i *)s);
+		sa = _mm_srli_epi32(ss, 24);
+		transparent = _mm_cmpeq_epi32(sa, z);
+		mask = _mm_movemask_epi8(transparent);
+		/* all transparent, skip the whole transparent run */
+		if (mask == 0xffff)
+		{
+			n = 4 + _alpha_run(s + 4, s + (end - d), z);
+			d += n;
+			s += n;
+			continue;
+		}
+		/* all opaque, copy the whole opaque run */
+		if (!mask && _mm_movemask_epi8(_mm_cmpeq_epi32(sa, opaque))
+				== 0xffff)
+		{
+			n = 4 + _alpha_run(s + 4, s + (end - d), opaque);
+			memcpy(d, s, n * sizeof(uint32_t));
+			d += n;
+			s += n;
+			continue;
+		}
+		/* the transparent pixels are kept untouched */
+		dd = _mm_load_si128((__m128i *)d);
+		_mm_store_si128((__m128i *)d, _select(transparent, dd,
+				_blend(dd, ss)));
+		d += 4;
+		s += 4;
+	}
+	argb8888_sp_argb8888_none_none_blend(d, len & 3, s, color, m);
+}
+
+static SSSE3 void _argb8888_sp_argb8888_none_argb8888_blend(uint32_t *d,
+		unsigned int len, uint32_t *s, uint32_t color, uint32_t *m)
+{
+	uint32_t *end;
+	uint32_t head;
+	__m128i one, z;
+
+	head = ALIGN16_HEAD(d, len);
+	argb8888_sp_argb8888_none_argb8888_blend(d, head, s, color, m);
+	d += head;
+	s += head;
+	m += head;
+	len -= head;
+
+	one = _mm_set1_epi16(1);
+	z = _mm_setzero_si128();
+	end = d + (len & ~3);
+	while (d < end)
+	{
+		__m128i mm, mc, dd, alo, ahi, transparent;
+
+		mm = _mm_loadu_si128((__m128i *)m);
+		/* skip the whole transparent run of the mask */
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_srli_epi32(mm, 24),
+				z)) == 0xffff)
+		{
+			uint32_t n;
+
+			n = 4 + _alpha_run(m + 4, m + (end - d), z);
+			d += n;
+			s += n;
+			m += n;
+			continue;
+		}
+		_alpha_shuffle(mm, &alo, &ahi);
+		mc = _mul_256(_mm_loadu_si128((__m128i *)s),
+				_mm_add_epi16(alo, one), _mm_add_epi16(ahi, one));
+		/* the transparent pixels are kept untouched */
+		transparent = _mm_cmpeq_epi32(_mm_srli_epi32(mc, 24), z);
+		if (_mm_movemask_epi8(transparent) != 0xffff)
+		{
+			dd = _mm_load_si128((__m128i *)d);
+			_mm_store_si128((__m128i *)d, _select(transparent, dd,
+					_blend(dd, mc)));
+		}
+		d += 4;
+		s += 4;
+		m += 4;
+	}
+	argb8888_sp_argb8888_none_argb8888_blend(d, len & 3, s, color, m);
+}
+
+#undef SSSE3
+#endif
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_compositor_argb8888_ssse3_init(void)
+{
+#if ENESIM_CPU_X86
+	/* pixel */
+	enesim_compositor_span_pixel_register(_argb8888_sp_argb8888_none_none_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888);
+	/* pixel mask */
+	enesim_compositor_span_pixel_mask_register(
+			_argb8888_sp_argb8888_none_argb8888_blend,
+			ENESIM_ROP_BLEND, ENESIM_FORMAT_ARGB8888,
+			ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);
+#endif
+}
+/** @endcond */
@@ -30,20 +30,20 @@
 static void _2d_rgb565_none_argb8888_pre(Enesim_Buffer_Sw_Data *data, uint32_t dw, uint32_t dh,
 		Enesim_Buffer_Sw_Data *sdata, uint32_t sw EINA_UNUSED, uint32_t sh EINA_UNUSED)
 {
-	uint16_t *dst = data->rgb565.plane0;
-	uint32_t *src = sdata->argb8888_pre.plane0;
+	uint8_t *dst = (uint8_t *)data->rgb565.plane0;
+	uint8_t *src = (uint8_t *)sdata->argb8888_pre.plane0;
 	size_t dstride = data->rgb565.plane0_stride;
-	size_t sstride = data->argb8888_pre.plane0_stride / 4;
+	size_t sstride = sdata->argb8888_pre.plane0_stride;
 
 	while (dh--)
 	{
-		uint16_t *ddst = dst;
-		uint32_t *ssrc = src;
+		uint16_t *ddst = (uint16_t *)dst;
+		uint32_t *ssrc = (uint32_t *)src;
 		uint32_t ddw = dw;
 		while (ddw--)
 		{
-			*dst = ((*src & 0xf80000) >> 8) | ((*src & 0xfc00) >> 5)
-					| ((*src & 0xf8) >> 3);
+			*ddst = ((*ssrc & 0xf80000) >> 8) | ((*ssrc & 0xfc00) >> 5)
+					| ((*ssrc & 0xf8) >> 3);
 			ssrc++;
 			ddst++;
 		}
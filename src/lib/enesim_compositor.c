@@ -42,6 +42,9 @@ typedef struct _Enesim_Compositor
 	Enesim_Compositor_Span sp_pixel[ENESIM_ROP_LAST][ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST];
 	Enesim_Compositor_Span sp_pixel_color[ENESIM_ROP_LAST][ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST];
 	Enesim_Compositor_Span sp_pixel_mask[ENESIM_ROP_LAST][ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST];
+	/* Streaming fills */
+	Enesim_Compositor_Span sp_stream_color[ENESIM_FORMAT_LAST];
+	Enesim_Compositor_Span sp_stream_pixel[ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST];
 	/* Points */
 	Enesim_Compositor_Point pt_color[ENESIM_ROP_LAST][ENESIM_FORMAT_LAST];
 	Enesim_Compositor_Point pt_mask_color[ENESIM_ROP_LAST][ENESIM_FORMAT_LAST][ENESIM_FORMAT_LAST];
@@ -57,8 +60,8 @@ static Enesim_Compositor _comps;
 static Enesim_Compositor_Point _point_color_get(Enesim_Rop rop,
 		Enesim_Format *dfmt, Enesim_Color color)
 {
-	/* TODO check if the color is opaque */
-	if ((rop == ENESIM_ROP_BLEND) && (color & 0xff000000))
+	/* blending an opaque color is the same as filling with it */
+	if ((rop == ENESIM_ROP_BLEND) && ((color >> 24) == 0xff))
 	{
 		rop = ENESIM_ROP_FILL;
 	}
@@ -66,7 +69,7 @@ static Enesim_Compositor_Point _point_color_get(Enesim_Rop rop,
 }
 
 static Enesim_Compositor_Point _point_mask_color_get(Enesim_Rop rop,
-		Enesim_Format *dfmt, Enesim_Color color EINA_UNUSED, Enesim_Format mfmt)
+		Enesim_Format *dfmt, Enesim_Format mfmt, Enesim_Color color EINA_UNUSED)
 {
 	return _comps.pt_mask_color[rop][*dfmt][mfmt];
 }
@@ -96,8 +99,8 @@ static Enesim_Compositor_Point _point_pixel_mask_get(Enesim_Rop rop,
 static Enesim_Compositor_Span _span_color_get(Enesim_Rop rop,
 		Enesim_Format *dfmt, Enesim_Color color)
 {
-	/* TODO check if the color is opaque */
-	if ((rop == ENESIM_ROP_BLEND) && (color & 0xff000000))
+	/* blending an opaque color is the same as filling with it */
+	if ((rop == ENESIM_ROP_BLEND) && ((color >> 24) == 0xff))
 	{
 		rop = ENESIM_ROP_FILL;
 	}
@@ -145,9 +148,11 @@ static Enesim_Compositor_Span _span_pixel_mask_get(Enesim_Rop rop,
 void enesim_compositor_init(void)
 {
 	enesim_compositor_argb8888_init();
+	enesim_compositor_a8_init();
 }
 void enesim_compositor_shutdown(void)
 {
+	enesim_compositor_a8_shutdown();
 	enesim_compositor_argb8888_shutdown();
 }
 
@@ -213,6 +218,104 @@ void enesim_compositor_span_pixel_color_register(Enesim_Compositor_Span sp,
 	_comps.sp_pixel_color[rop][dfmt][sfmt] = sp;
 }
 
+void enesim_compositor_span_stream_color_register(Enesim_Compositor_Span sp,
+		Enesim_Format dfmt)
+{
+	_comps.sp_stream_color[dfmt] = sp;
+}
+
+void enesim_compositor_span_stream_pixel_register(Enesim_Compositor_Span sp,
+		Enesim_Format dfmt, Enesim_Format sfmt)
+{
+	_comps.sp_stream_pixel[dfmt][sfmt] = sp;
+}
+
+/* Calls the callback for every registered span function, for the tools
+ * that need to go through all of them, like the benchmark
+ */
+void enesim_compositor_span_foreach(Enesim_Compositor_Span_Foreach_Cb cb,
+		void *data)
+{
+	Enesim_Rop rop;
+	Enesim_Format d, s, m;
+
+	for (rop = 0; rop < ENESIM_ROP_LAST; rop++)
+	{
+		for (d = 0; d < ENESIM_FORMAT_LAST; d++)
+		{
+			if (_comps.sp_color[rop][d])
+				cb(_comps.sp_color[rop][d], rop, d,
+						ENESIM_FORMAT_NONE, EINA_TRUE,
+						ENESIM_FORMAT_NONE, data);
+			for (s = 0; s < ENESIM_FORMAT_LAST; s++)
+			{
+				if (_comps.sp_mask_color[rop][d][s])
+					cb(_comps.sp_mask_color[rop][d][s], rop,
+							d, ENESIM_FORMAT_NONE,
+							EINA_TRUE, s, data);
+				if (_comps.sp_pixel[rop][d][s])
+					cb(_comps.sp_pixel[rop][d][s], rop, d,
+							s, EINA_FALSE,
+							ENESIM_FORMAT_NONE, data);
+				if (_comps.sp_pixel_color[rop][d][s])
+					cb(_comps.sp_pixel_color[rop][d][s],
+							rop, d, s, EINA_TRUE,
+							ENESIM_FORMAT_NONE, data);
+				for (m = 0; m < ENESIM_FORMAT_LAST; m++)
+				{
+					if (_comps.sp_pixel_mask[rop][d][s][m])
+						cb(_comps.sp_pixel_mask[rop][d][s][m],
+								rop, d, s,
+								EINA_FALSE, m,
+								data);
+				}
+			}
+		}
+	}
+}
+
+/* Same as enesim_compositor_span_foreach() but for the point functions */
+void enesim_compositor_point_foreach(
+		Enesim_Compositor_Point_Foreach_Cb cb, void *data)
+{
+	Enesim_Rop rop;
+	Enesim_Format d, s, m;
+
+	for (rop = 0; rop < ENESIM_ROP_LAST; rop++)
+	{
+		for (d = 0; d < ENESIM_FORMAT_LAST; d++)
+		{
+			if (_comps.pt_color[rop][d])
+				cb(_comps.pt_color[rop][d], rop, d,
+						ENESIM_FORMAT_NONE, EINA_TRUE,
+						ENESIM_FORMAT_NONE, data);
+			for (s = 0; s < ENESIM_FORMAT_LAST; s++)
+			{
+				if (_comps.pt_mask_color[rop][d][s])
+					cb(_comps.pt_mask_color[rop][d][s], rop,
+							d, ENESIM_FORMAT_NONE,
+							EINA_TRUE, s, data);
+				if (_comps.pt_pixel[rop][d][s])
+					cb(_comps.pt_pixel[rop][d][s], rop, d,
+							s, EINA_FALSE,
+							ENESIM_FORMAT_NONE, data);
+				if (_comps.pt_pixel_color[rop][d][s])
+					cb(_comps.pt_pixel_color[rop][d][s],
+							rop, d, s, EINA_TRUE,
+							ENESIM_FORMAT_NONE, data);
+				for (m = 0; m < ENESIM_FORMAT_LAST; m++)
+				{
+					if (_comps.pt_pixel_mask[rop][d][s][m])
+						cb(_comps.pt_pixel_mask[rop][d][s][m],
+								rop, d, s,
+								EINA_FALSE, m,
+								data);
+				}
+			}
+		}
+	}
+}
+
 Enesim_Compositor_Span enesim_compositor_span_get(Enesim_Rop rop,
 		Enesim_Format *dfmt, Enesim_Format sfmt, Enesim_Color color,
 		Enesim_Format mfmt)
@@ -242,6 +345,22 @@ Enesim_Compositor_Span enesim_compositor_span_get(Enesim_Rop rop,
 	return NULL;
 }
 
+/*
+ * Returns a function that fills a span of pixels with a color, or with pixels
+ * of format sfmt, without polluting the cache. Only destinations of size
+ * bytes bigger than the cache benefit from it, otherwise NULL is returned and
+ * the common fill span must be used
+ */
+Enesim_Compositor_Span enesim_compositor_span_stream_get(Enesim_Format dfmt,
+		Enesim_Format sfmt, size_t size)
+{
+	if (size < ENESIM_COMPOSITOR_STREAM_SIZE)
+		return NULL;
+	if (!sfmt)
+		return _comps.sp_stream_color[dfmt];
+	return _comps.sp_stream_pixel[dfmt][sfmt];
+}
+
 Enesim_Compositor_Point enesim_compositor_point_get(Enesim_Rop rop,
 		Enesim_Format *dfmt, Enesim_Format sfmt, Enesim_Color color,
 		Enesim_Format mfmt)
@@ -52,11 +52,45 @@ Enesim_Compositor_Point enesim_compositor_point_get(Enesim_Rop rop,
 		Enesim_Format *dfmt, Enesim_Format sfmt, Enesim_Color color,
 		Enesim_Format mfmt);
 
+/* destinations of at least this bytes are filled with streaming stores */
+#define ENESIM_COMPOSITOR_STREAM_SIZE (16 * 1024 * 1024)
+
+Enesim_Compositor_Span enesim_compositor_span_stream_get(Enesim_Format dfmt,
+		Enesim_Format sfmt, size_t size);
+
+/**
+ * Function called for every registered compositor function
+ * @param sp The span or point function
+ * @param rop The raster operation it does
+ * @param dfmt The destination format
+ * @param sfmt The source format, ENESIM_FORMAT_NONE for no source
+ * @param color If the function uses the color
+ * @param mfmt The mask format, ENESIM_FORMAT_NONE for no mask
+ * @param data The user provided data
+ */
+typedef void (*Enesim_Compositor_Span_Foreach_Cb)(Enesim_Compositor_Span sp,
+		Enesim_Rop rop, Enesim_Format dfmt, Enesim_Format sfmt,
+		Eina_Bool color, Enesim_Format mfmt, void *data);
+typedef void (*Enesim_Compositor_Point_Foreach_Cb)(Enesim_Compositor_Point pt,
+		Enesim_Rop rop, Enesim_Format dfmt, Enesim_Format sfmt,
+		Eina_Bool color, Enesim_Format mfmt, void *data);
+
+void enesim_compositor_span_foreach(Enesim_Compositor_Span_Foreach_Cb cb,
+		void *data);
+void enesim_compositor_point_foreach(
+		Enesim_Compositor_Point_Foreach_Cb cb, void *data);
+
 void enesim_compositor_init(void);
 void enesim_compositor_shutdown(void);
 
 void enesim_compositor_argb8888_init(void);
 void enesim_compositor_argb8888_shutdown(void);
+void enesim_compositor_argb8888_sse2_init(void);
+void enesim_compositor_argb8888_ssse3_init(void);
+void enesim_compositor_argb8888_avx2_init(void);
+void enesim_compositor_a8_init(void);
+void enesim_compositor_a8_shutdown(void);
+void enesim_compositor_a8_sse2_init(void);
 
 void enesim_compositor_pt_color_register(Enesim_Compositor_Point sp,
 		Enesim_Rop rop, Enesim_Format dfmt);
@@ -81,5 +115,35 @@ void enesim_compositor_span_pixel_mask_register(Enesim_Compositor_Span sp,
 		Enesim_Format mfmt);
 void enesim_compositor_span_pixel_color_register(Enesim_Compositor_Span sp,
 		Enesim_Rop rop, Enesim_Format dfmt, Enesim_Format sfmt);
+void enesim_compositor_span_stream_color_register(Enesim_Compositor_Span sp,
+		Enesim_Format dfmt);
+void enesim_compositor_span_stream_pixel_register(Enesim_Compositor_Span sp,
+		Enesim_Format dfmt, Enesim_Format sfmt);
+
+/*
+ * Registers the span functions of an argb8888 operator, named as
+ * <pfx>_sp_<src>_<color>_<mask>_<op>, for every source, color and mask
+ * combination
+ */
+#define ENESIM_COMPOSITOR_ARGB8888_ROP_REGISTER(pfx, op, rop)		\
+	enesim_compositor_span_color_register(				\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_none_color_none_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888);			\
+	enesim_compositor_span_pixel_register(				\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_argb8888_none_none_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);	\
+	enesim_compositor_span_pixel_color_register(			\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_argb8888_color_none_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);	\
+	enesim_compositor_span_mask_color_register(			\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_none_color_argb8888_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888);	\
+	enesim_compositor_span_mask_color_register(			\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_none_color_a8_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_A8);	\
+	enesim_compositor_span_pixel_mask_register(			\
+			ENESIM_COMPOSITOR_SPAN(pfx##_sp_argb8888_none_argb8888_##op),	\
+			rop, ENESIM_FORMAT_ARGB8888, ENESIM_FORMAT_ARGB8888,	\
+			ENESIM_FORMAT_ARGB8888)
 
 #endif /* ENESIM_COMPOSITOR_H_*/
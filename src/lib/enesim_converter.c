@@ -70,6 +70,29 @@ Enesim_Converter_2D enesim_converter_surface_get(Enesim_Buffer_Format dfmt,
 {
 	return _converters_2d[dfmt][angle][sfmt];
 }
+
+/* Calls the callback for every registered converter, for the tools that
+ * need to go through all of them, like the benchmark
+ */
+void enesim_converter_surface_foreach(Enesim_Converter_2D_Foreach_Cb cb,
+		void *data)
+{
+	Enesim_Buffer_Format d, s;
+	Enesim_Angle angle;
+
+	for (d = 0; d < ENESIM_BUFFER_FORMATS; d++)
+	{
+		for (angle = 0; angle < ENESIM_ANGLE_LAST; angle++)
+		{
+			for (s = 0; s < ENESIM_BUFFER_FORMATS; s++)
+			{
+				if (_converters_2d[d][angle][s])
+					cb(_converters_2d[d][angle][s], d,
+							angle, s, data);
+			}
+		}
+	}
+}
 /** @endcond */
 /*============================================================================*
  *                                   API                                      *
@@ -39,4 +39,10 @@ void enesim_converter_surface_register(Enesim_Converter_2D cnv,
 Enesim_Converter_2D enesim_converter_surface_get(Enesim_Buffer_Format dfmt,
 		Enesim_Angle angle, Enesim_Buffer_Format sfmt);
 
+typedef void (*Enesim_Converter_2D_Foreach_Cb)(Enesim_Converter_2D cnv,
+		Enesim_Buffer_Format dfmt, Enesim_Angle angle,
+		Enesim_Buffer_Format sfmt, void *data);
+void enesim_converter_surface_foreach(Enesim_Converter_2D_Foreach_Cb cb,
+		void *data);
+
 #endif
@@ -39,10 +39,24 @@
 
 #include "enesim_renderer_private.h"
 #include "enesim_draw_cache_private.h"
+#include "enesim_atomic_private.h"
 /*============================================================================*
  *                                  Local                                     *
  *============================================================================*/
 /** @cond internal */
+/* The size of the tiles the cache is split into */
+#define ENESIM_DRAW_CACHE_TILE_W 64
+#define ENESIM_DRAW_CACHE_TILE_H 16
+
+/* The state of a tile, the states of a tile being rendered go last */
+enum
+{
+	ENESIM_DRAW_CACHE_TILE_CLEAN, /* the tile has been rendered */
+	ENESIM_DRAW_CACHE_TILE_DIRTY, /* the tile needs to be rendered */
+	ENESIM_DRAW_CACHE_TILE_RENDERING, /* the tile is being rendered */
+	ENESIM_DRAW_CACHE_TILE_RENDERING_DIRTY, /* damaged while rendered */
+};
+
 struct _Enesim_Draw_Cache
 {
 	Enesim_Renderer *r;
@@ -50,26 +64,89 @@ struct _Enesim_Draw_Cache
 	Eina_Bool changed;
 
 	Enesim_Surface *s;
+	Enesim_Buffer_Sw_Data sw_data;
 
-	/* on the tiler we keep the area that needs to be redrawn from the
-	 * renderer */
-	Eina_Tiler *tiler;
-	/* given that the tiler is not lock free we need to lock it */
-	Eina_Lock tlock;
+	/* the state of every tile. The state is only changed atomically so
+	 * the tiles already rendered can be mapped concurrently without
+	 * locking. Only the thread that marks a tile as rendering draws it
+	 */
+	Enesim_Atomic *tiles;
+	int ntx, nty;
 	int tw, th;
+	/* to wait for the tiles other thread is rendering */
+	Eina_Lock lock;
+	Eina_Condition rendered;
 };
 
+static void _tiles_dirty(Enesim_Draw_Cache *thiz, Eina_Rectangle *area)
+{
+	Eina_Rectangle s_area;
+	int tx, ty, tx1, ty1;
+
+	eina_rectangle_coords_from(&s_area, 0, 0, thiz->tw, thiz->th);
+	if (!eina_rectangle_intersection(area, &s_area))
+		return;
+	tx1 = (area->x + area->w - 1) / ENESIM_DRAW_CACHE_TILE_W;
+	ty1 = (area->y + area->h - 1) / ENESIM_DRAW_CACHE_TILE_H;
+	for (ty = area->y / ENESIM_DRAW_CACHE_TILE_H; ty <= ty1; ty++)
+	{
+		for (tx = area->x / ENESIM_DRAW_CACHE_TILE_W; tx <= tx1; tx++)
+		{
+			Enesim_Atomic *tile = &thiz->tiles[(ty * thiz->ntx) + tx];
+			int old, state;
+
+			/* do not lose the damage of a tile being rendered,
+			 * the thread rendering it will render it again
+			 */
+			do {
+				old = enesim_atomic_get(tile);
+				if (old >= ENESIM_DRAW_CACHE_TILE_RENDERING)
+					state = ENESIM_DRAW_CACHE_TILE_RENDERING_DIRTY;
+				else
+					state = ENESIM_DRAW_CACHE_TILE_DIRTY;
+			} while (!enesim_atomic_cas(tile, old, state));
+		}
+	}
+}
+
+static void _tile_render(Enesim_Draw_Cache *thiz, int tx, int ty)
+{
+	Eina_Rectangle redraw;
+	Eina_Rectangle s_area;
+	uint8_t *dst;
+	int y, maxy;
+
+	eina_rectangle_coords_from(&redraw, tx * ENESIM_DRAW_CACHE_TILE_W,
+			ty * ENESIM_DRAW_CACHE_TILE_H, ENESIM_DRAW_CACHE_TILE_W,
+			ENESIM_DRAW_CACHE_TILE_H);
+	eina_rectangle_coords_from(&s_area, 0, 0, thiz->tw, thiz->th);
+	eina_rectangle_intersection(&redraw, &s_area);
+
+	dst = (uint8_t *)argb8888_at(thiz->sw_data.argb8888.plane0,
+			thiz->sw_data.argb8888.plane0_stride,
+			redraw.x, redraw.y);
+	y = redraw.y;
+	maxy = y + redraw.h;
+	while (y < maxy)
+	{
+		enesim_renderer_sw_draw(thiz->r, redraw.x + thiz->bounds.x,
+				y + thiz->bounds.y, redraw.w, (uint32_t *)dst);
+		dst += thiz->sw_data.argb8888.plane0_stride;
+		y++;
+	}
+}
+
 static Eina_Bool _damage_cb(Enesim_Renderer *r EINA_UNUSED,
 		const Eina_Rectangle *area, Eina_Bool past EINA_UNUSED,
 		void *data)
 {
 	Enesim_Draw_Cache *thiz = data;
-	Eina_Rectangle tiler_rect = *area;
+	Eina_Rectangle tiles_rect = *area;
 
 	/* get the real offset based on the geometry of the renderer */
-	tiler_rect.x -= thiz->bounds.x;
-	tiler_rect.y -= thiz->bounds.y;
-	eina_tiler_rect_add(thiz->tiler, &tiler_rect);
+	tiles_rect.x -= thiz->bounds.x;
+	tiles_rect.y -= thiz->bounds.y;
+	_tiles_dirty(thiz, &tiles_rect);
 	return EINA_TRUE;
 }
 /*============================================================================*
@@ -79,7 +156,8 @@ Enesim_Draw_Cache * enesim_draw_cache_new(void)
 {
 	Enesim_Draw_Cache *thiz;
 	thiz = calloc(1, sizeof(Enesim_Draw_Cache));
-   	eina_lock_new(&thiz->tlock);
+	eina_lock_new(&thiz->lock);
+	eina_condition_new(&thiz->rendered, &thiz->lock);
 	return thiz;
 }
 
@@ -97,12 +175,9 @@ void enesim_draw_cache_free(Enesim_Draw_Cache *thiz)
 		thiz->s = NULL;
 	}
 
-	if (thiz->tiler)
-	{
-		eina_tiler_free(thiz->tiler);
-		thiz->tiler = NULL;
-	}
-	eina_lock_free(&thiz->tlock);
+	free(thiz->tiles);
+	eina_condition_free(&thiz->rendered);
+	eina_lock_free(&thiz->lock);
 	free(thiz);
 }
 
@@ -144,42 +219,49 @@ Eina_Bool enesim_draw_cache_setup_sw(Enesim_Draw_Cache *thiz,
 {
 	if (!thiz->r) return EINA_FALSE;
 	/* TODO check what happens if the format is different? */
-	/* in case the renderer has changed our damaged/clear rectangles
+	/* in case the renderer has changed our damaged/clear tiles
 	 * has to be invalidated
 	 */
-	if (enesim_renderer_has_changed(thiz->r) || (!thiz->tiler) || (thiz->changed))
+	if (enesim_renderer_has_changed(thiz->r) || (!thiz->tiles) || (thiz->changed))
 	{
 		Eina_Bool full = EINA_FALSE;
 
 		if (thiz->changed)
 		{
 			thiz->changed = EINA_FALSE;
-			if (thiz->tiler)
-				eina_tiler_clear(thiz->tiler);
 			full = EINA_TRUE;
 		}
 
 		/* in case the size of the renderer has changed be sure
-		 * to destroy the tiler
+		 * to destroy the tiles
 		 */
 		enesim_renderer_destination_bounds_get(thiz->r, &thiz->bounds, 0, 0);
 		if (thiz->tw != thiz->bounds.w || thiz->th != thiz->bounds.h)
 		{
-			if (thiz->tiler)
-			{
-				eina_tiler_free(thiz->tiler);
-				thiz->tiler = NULL;
-			}
+			free(thiz->tiles);
+			thiz->tiles = NULL;
 			full = EINA_TRUE;
 		}
 
-		/* create a new tiler in case we dont have one */
-		if (!thiz->tiler)
+		/* create the tiles in case we dont have them */
+		if (!thiz->tiles)
 		{
-			thiz->tiler = eina_tiler_new(thiz->bounds.w, thiz->bounds.h);
-			eina_tiler_tile_size_set(thiz->tiler, 1, 1);
 			thiz->tw = thiz->bounds.w;
 			thiz->th = thiz->bounds.h;
+			thiz->ntx = (thiz->tw + ENESIM_DRAW_CACHE_TILE_W - 1) / ENESIM_DRAW_CACHE_TILE_W;
+			thiz->nty = (thiz->th + ENESIM_DRAW_CACHE_TILE_H - 1) / ENESIM_DRAW_CACHE_TILE_H;
+			/* the tiles start clean, the damage keeps the
+			 * state of the tiles being rendered
+			 */
+			thiz->tiles = calloc(thiz->ntx * thiz->nty,
+					sizeof(Enesim_Atomic));
+			if (!thiz->tiles)
+			{
+				/* force the creation on the next setup */
+				thiz->ntx = thiz->nty = 0;
+				thiz->tw = thiz->th = 0;
+				return EINA_FALSE;
+			}
 		}
 
 		/* create the surface if we dont have one already */
@@ -198,8 +280,14 @@ Eina_Bool enesim_draw_cache_setup_sw(Enesim_Draw_Cache *thiz,
 
 		if (!thiz->s)
 		{
+			Enesim_Buffer *buffer;
+
 			thiz->s = enesim_surface_new_pool_from(f,
 					thiz->bounds.w, thiz->bounds.h, p);
+			/* keep the mapped pointer, the map is called per span */
+			buffer = enesim_surface_buffer_get(thiz->s);
+			enesim_buffer_sw_data_get(buffer, &thiz->sw_data);
+			enesim_buffer_unref(buffer);
 		}
 		/* finally make the whole surface to be invalidated or pick
 		 * up the damages
@@ -208,7 +296,7 @@ Eina_Bool enesim_draw_cache_setup_sw(Enesim_Draw_Cache *thiz,
 		{
 			Eina_Rectangle complete;
 			eina_rectangle_coords_from(&complete, 0, 0, thiz->bounds.w, thiz->bounds.h);
-			eina_tiler_rect_add(thiz->tiler, &complete);
+			_tiles_dirty(thiz, &complete);
 		}
 		else
 		{
@@ -218,96 +306,71 @@ Eina_Bool enesim_draw_cache_setup_sw(Enesim_Draw_Cache *thiz,
 	return EINA_TRUE;
 }
 
-/* The area is in surface coordinates 0,0 -> renderer geometry width x renderer geometry height */
+/* The area is in surface coordinates 0,0 -> renderer geometry width x renderer geometry height.
+ * This can be called from several threads at once, every dirty tile the area touches
+ * is rendered only once, by the first thread that requests it
+ */
 Eina_Bool enesim_draw_cache_map_sw(Enesim_Draw_Cache *thiz,
 		Eina_Rectangle *area, Enesim_Buffer_Sw_Data *mapped)
 {
-	Enesim_Buffer *buffer;
-	Eina_Iterator *it;
-	Eina_Tiler *area_tiler;
-	Eina_Rectangle *rect;
 	Eina_Rectangle real_area;
 	Eina_Rectangle s_area;
-	Eina_Bool ret;
-
-	if (!thiz->r) return EINA_FALSE;
+	int tx, ty, tx0, tx1, ty1;
 
-	/* TODO to minimize the impact of the lock, split this function into a setup/cleanup/map */
-	eina_lock_take(&thiz->tlock);
-	//printf("requesting %" EINA_RECTANGLE_FORMAT "\n", EINA_RECTANGLE_ARGS(area));
+	if (!thiz->r || !thiz->s || !thiz->tiles) return EINA_FALSE;
 
-	/* create our own requested area tiler, so we can know what areas
-	 * should be redrawn and what areas should not
-	 */
+	*mapped = thiz->sw_data;
+	eina_rectangle_coords_from(&s_area, 0, 0, thiz->tw, thiz->th);
 	if (!area)
 	{
-		eina_rectangle_coords_from(&real_area, 0, 0, thiz->tw, thiz->th);
+		real_area = s_area;
 	}
 	else
 	{
 		real_area = *area;
+		if (!eina_rectangle_intersection(&real_area, &s_area))
+			return EINA_TRUE;
 	}
-	area_tiler = eina_tiler_new(real_area.w, real_area.h);
-	eina_tiler_tile_size_set(area_tiler, 1, 1);
 
-	/* get the mapped pointer */	
-	buffer = enesim_surface_buffer_get(thiz->s);
-	ret = enesim_buffer_sw_data_get(buffer, mapped);
-	enesim_buffer_unref(buffer);
-
-	/* check if the requested area has been already cached or not, ie
-	 * remove rectangles from the area tiler
-	 */
-	it = eina_tiler_iterator_new(thiz->tiler);
-	EINA_ITERATOR_FOREACH(it, rect)
+	tx0 = real_area.x / ENESIM_DRAW_CACHE_TILE_W;
+	tx1 = (real_area.x + real_area.w - 1) / ENESIM_DRAW_CACHE_TILE_W;
+	ty1 = (real_area.y + real_area.h - 1) / ENESIM_DRAW_CACHE_TILE_H;
+	for (ty = real_area.y / ENESIM_DRAW_CACHE_TILE_H; ty <= ty1; ty++)
 	{
-		Eina_Rectangle add = *rect;
-
-		/* convert the rect from surface to area coordinates */
-		add.x -= real_area.x;
-		add.y -= real_area.y;
-		eina_tiler_rect_add(area_tiler, &add);
-		//printf("adding %" EINA_RECTANGLE_FORMAT "\n", EINA_RECTANGLE_ARGS(&add));
-	}
-	eina_iterator_free(it);
-
-	/* ok, we now finally can get the damaged rectangles and draw */
-	eina_rectangle_coords_from(&s_area, 0, 0, thiz->tw, thiz->th);
-	it = eina_tiler_iterator_new(area_tiler);
-	EINA_ITERATOR_FOREACH(it, rect)
-	{
-		Eina_Rectangle redraw;
-		uint8_t *dst;
-		int y, maxy;
-
-		redraw = *rect;
-		/* convert the rect from area to surface coordinates */
-		redraw.x += real_area.x;
-		redraw.y += real_area.y;
-
-		if (!eina_rectangle_intersection(&redraw, &s_area))
-			continue;
-		dst = (uint8_t *)argb8888_at(mapped->argb8888.plane0,
-				mapped->argb8888.plane0_stride,
-				redraw.x, redraw.y);
-		//printf("redrawing into %d %d %d %d from %d %d\n", redraw.x, redraw.y, redraw.w, redraw.h,
-		//	redraw.x + thiz->bounds.x, redraw.y + thiz->bounds.y);
-		y = redraw.y;
-		maxy = y + redraw.h;
-		while (y < maxy)
+		for (tx = tx0; tx <= tx1; tx++)
 		{
-			enesim_renderer_sw_draw(thiz->r, redraw.x + thiz->bounds.x,
-					y + thiz->bounds.y, redraw.w, (uint32_t *)dst);
-			dst += mapped->argb8888.plane0_stride;
-			y++;
+			Enesim_Atomic *tile = &thiz->tiles[(ty * thiz->ntx) + tx];
+
+			while (enesim_atomic_get(tile) != ENESIM_DRAW_CACHE_TILE_CLEAN)
+			{
+				if (enesim_atomic_cas(tile, ENESIM_DRAW_CACHE_TILE_DIRTY,
+						ENESIM_DRAW_CACHE_TILE_RENDERING))
+				{
+					_tile_render(thiz, tx, ty);
+					/* publish the tile and wake up any waiter,
+					 * a tile damaged meanwhile is dirty again
+					 */
+					eina_lock_take(&thiz->lock);
+					if (!enesim_atomic_cas(tile,
+							ENESIM_DRAW_CACHE_TILE_RENDERING,
+							ENESIM_DRAW_CACHE_TILE_CLEAN))
+						enesim_atomic_set(tile,
+								ENESIM_DRAW_CACHE_TILE_DIRTY);
+					eina_condition_broadcast(&thiz->rendered);
+					eina_lock_release(&thiz->lock);
+					continue;
+				}
+				/* another thread is rendering it */
+				eina_lock_take(&thiz->lock);
+				while (enesim_atomic_get(tile) >=
+						ENESIM_DRAW_CACHE_TILE_RENDERING)
+					eina_condition_wait(&thiz->rendered);
+				eina_lock_release(&thiz->lock);
+			}
 		}
-		eina_tiler_rect_del(thiz->tiler, &redraw);
 	}
-	eina_iterator_free(it);
-	eina_tiler_free(area_tiler);
-	eina_lock_release(&thiz->tlock);
 
-	return ret;
+	return EINA_TRUE;
 }
 
 #if 0
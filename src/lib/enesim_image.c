@@ -142,6 +142,7 @@ int enesim_image_init(void)
 	ENESIM_IMAGE_ERROR_ALLOCATOR = eina_error_msg_static_register("Error allocating the surface data");
 	ENESIM_IMAGE_ERROR_LOADING = eina_error_msg_static_register("Error loading the image");
 	ENESIM_IMAGE_ERROR_SAVING = eina_error_msg_static_register("Error saving the image");
+	ENESIM_IMAGE_ERROR_CANCELLED = eina_error_msg_static_register("The operation has been cancelled");
 	/* the providers */
 	_providers = eina_hash_string_superfast_new(NULL);
 	/* the modules */
@@ -186,10 +187,13 @@ int enesim_image_shutdown(void)
 	/* unload every module */
 	eina_module_list_free(_modules);
 	eina_array_free(_modules);
+	_modules = NULL;
 	/* remove the finders */
 	eina_list_free(_finders);
+	_finders = NULL;
 	/* remove the providers */
 	eina_hash_free(_providers);
+	_providers = NULL;
 
 	return _enesim_image_init_count;
 }
@@ -204,6 +208,7 @@ Eina_Error ENESIM_IMAGE_ERROR_SIZE;
 Eina_Error ENESIM_IMAGE_ERROR_ALLOCATOR;
 Eina_Error ENESIM_IMAGE_ERROR_LOADING;
 Eina_Error ENESIM_IMAGE_ERROR_SAVING;
+Eina_Error ENESIM_IMAGE_ERROR_CANCELLED;
 
 /**
  * Gets information about an image
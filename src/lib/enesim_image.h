@@ -41,6 +41,7 @@ EAPI extern Eina_Error ENESIM_IMAGE_ERROR_SIZE;
 EAPI extern Eina_Error ENESIM_IMAGE_ERROR_ALLOCATOR;
 EAPI extern Eina_Error ENESIM_IMAGE_ERROR_LOADING;
 EAPI extern Eina_Error ENESIM_IMAGE_ERROR_SAVING;
+EAPI extern Eina_Error ENESIM_IMAGE_ERROR_CANCELLED;
 
 /**
  * Function prototype called whenever an image is loaded or saved
@@ -82,17 +83,25 @@ EAPI void enesim_image_save_async(Enesim_Stream *data, const char *mime,
  * @{
  */
 typedef struct _Enesim_Image_Context Enesim_Image_Context;
+typedef struct _Enesim_Image_Job Enesim_Image_Job; /**< An asynchronous load or save */
 
 EAPI Enesim_Image_Context * enesim_image_context_new(void);
 EAPI void enesim_image_context_free(Enesim_Image_Context *thiz);
-EAPI void enesim_image_context_load_async(Enesim_Image_Context *thiz,
+EAPI Enesim_Image_Job * enesim_image_context_load_async(Enesim_Image_Context *thiz,
 		Enesim_Stream *data, const char *mime, Enesim_Buffer *b,
 		Enesim_Pool *mpool, Enesim_Image_Callback cb,
 		void *user_data, const char *options);
-EAPI void enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
+EAPI Enesim_Image_Job * enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
 		const char *mime, Enesim_Buffer *b, Enesim_Image_Callback cb,
 		void *user_data, const char *options);
 EAPI void enesim_image_context_dispatch(Enesim_Image_Context *thiz);
+EAPI void enesim_image_context_job_priority_set(Enesim_Image_Context *thiz,
+		Enesim_Image_Job *j, Enesim_Priority priority);
+EAPI Eina_Bool enesim_image_context_job_cancel(Enesim_Image_Context *thiz,
+		Enesim_Image_Job *j);
+EAPI void enesim_image_context_threads_max_set(Enesim_Image_Context *thiz,
+		unsigned int max);
+EAPI unsigned int enesim_image_context_threads_max_get(Enesim_Image_Context *thiz);
 
 /**
  * @}
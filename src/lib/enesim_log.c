@@ -19,6 +19,8 @@
 
 #include "enesim_main.h"
 #include "enesim_log.h"
+
+#include "enesim_log_private.h"
 /*============================================================================*
  *                                  Local                                     *
  *============================================================================*/
@@ -30,6 +32,16 @@ struct _Enesim_Log
 /*============================================================================*
  *                                 Global                                     *
  *============================================================================*/
+/* Append the logs of other at the end of log, other is freed */
+Enesim_Log * enesim_log_join(Enesim_Log *log, Enesim_Log *other)
+{
+	if (!other) return log;
+	if (!log) return other;
+
+	log->trace = eina_list_merge(log->trace, other->trace);
+	free(other);
+	return log;
+}
 /** @endcond */
 /*============================================================================*
  *                                   API                                      *
@@ -54,6 +54,7 @@
 #include "enesim_converter_private.h"
 #include "enesim_mempool_aligned_private.h"
 #include "enesim_mempool_buddy_private.h"
+#include "enesim_cpu_private.h"
 /*============================================================================*
  *                                  Local                                     *
  *============================================================================*/
@@ -195,10 +196,8 @@ EAPI int enesim_init(void)
 		EINA_LOG_ERR("Enesim Can not create the log domains.");
 		goto shutdown_eina_threads;
 	}
-	/* TODO Dump the information about SIMD extensions
-	 * get the cpuid for this
-	 */
 	_enesim_init_count++;
+	enesim_cpu_init();
 	enesim_mempool_aligned_init();
 	enesim_mempool_buddy_init();
 	enesim_pool_init();
@@ -207,12 +206,6 @@ EAPI int enesim_init(void)
 	enesim_converter_init();
 	enesim_image_init();
 	enesim_text_init();
-#ifdef ENS_HAVE_MMX
-	/* EINA_ERROR_PINFO("MMX Drawer available\n"); */
-#endif
-#ifdef ENS_HAVE_SSE2
-	/* EINA_ERROR_PINFO("SSE2 Drawer available\n"); */
-#endif
 #if CHECK_FE
 	/* FIXME for some reason we are having several fp exaceptions
 	 * better disable the inexact case always
@@ -264,6 +257,7 @@ EAPI int enesim_shutdown(void)
 	enesim_pool_shutdown();
 	enesim_mempool_aligned_shutdown();
 	enesim_mempool_buddy_shutdown();
+	enesim_cpu_shutdown();
 	_unregister_domains();
 	eina_shutdown();
 #ifdef HAVE_EVIL
@@ -290,3 +284,72 @@ EAPI void enesim_version_get(unsigned int *major, unsigned int *minor, unsigned
 	if (minor) *minor = VERSION_MINOR;
 	if (micro) *micro = VERSION_MICRO;
 }
+
+/**
+ * @brief Set the number of threads used to draw
+ *
+ * @param[in] count The number of threads, 0 to use one thread per cpu
+ *
+ * By default the software backend uses as many threads as cpus are
+ * available. The thread that issues a draw is also used for drawing, so
+ * only @p count - 1 worker threads are created. A @p count of 1 draws
+ * everything on the calling thread; in that case an asynchronous draw
+ * only happens once it is waited for.
+ *
+ * The pending draws, the asynchronous ones included, are finished before
+ * the threads are replaced.
+ */
+EAPI void enesim_threads_set(unsigned int count)
+{
+	enesim_renderer_sw_threads_set(count);
+}
+
+/**
+ * @brief Get the number of threads used to draw
+ *
+ * @return The number of threads, including the one that issues the draw
+ */
+EAPI unsigned int enesim_threads_get(void)
+{
+	return enesim_renderer_sw_threads_get();
+}
+
+/**
+ * @brief Set the cpu affinity of the drawing threads
+ *
+ * @param[in] affinity The affinity policy
+ * @param[in] cpus The list of cpus to use when the policy is
+ * @ref ENESIM_THREAD_AFFINITY_CPUS
+ * @param[in] count The number of cpus in @p cpus
+ *
+ * By default every worker thread is pinned to its own cpu. On shared
+ * machines it might be better to let the system schedule the threads
+ * or to pin them only to a subset of the cpus. With a list of cpus the
+ * workers are pinned in order to the cpus of the list, wrapping around
+ * if there are more workers than cpus. An empty list is handled as
+ * @ref ENESIM_THREAD_AFFINITY_NONE.
+ *
+ * The pending draws, the asynchronous ones included, are finished before
+ * the threads are replaced.
+ *
+ * @return EINA_TRUE if the affinity is set, EINA_FALSE otherwise
+ */
+EAPI Eina_Bool enesim_threads_affinity_set(Enesim_Thread_Affinity affinity,
+		const unsigned int *cpus, unsigned int count)
+{
+	if (affinity >= ENESIM_THREAD_AFFINITY_LAST)
+		return EINA_FALSE;
+	if (affinity == ENESIM_THREAD_AFFINITY_CPUS && (!cpus || !count))
+		affinity = ENESIM_THREAD_AFFINITY_NONE;
+	return enesim_renderer_sw_threads_affinity_set(affinity, cpus, count);
+}
+
+/**
+ * @brief Get the cpu affinity policy of the drawing threads
+ *
+ * @return The affinity policy
+ */
+EAPI Enesim_Thread_Affinity enesim_threads_affinity_get(void)
+{
+	return enesim_renderer_sw_threads_affinity_get();
+}
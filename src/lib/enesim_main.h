@@ -50,6 +50,11 @@ typedef enum _Enesim_Rop
 {
 	ENESIM_ROP_BLEND, /**< D = S + D(1 - Sa) */
 	ENESIM_ROP_FILL, /**< D = S */
+	ENESIM_ROP_DST_OUT, /**< D = D(1 - Sa) */
+	ENESIM_ROP_SRC_IN, /**< D = S * Da */
+	ENESIM_ROP_DST_IN, /**< D = D * Sa */
+	ENESIM_ROP_MULTIPLY, /**< D = S * D + S(1 - Da) + D(1 - Sa) */
+	ENESIM_ROP_SCREEN, /**< D = S + D - S * D */
 	ENESIM_ROP_LAST
 } Enesim_Rop;
 
@@ -94,7 +99,7 @@ typedef enum _Enesim_Alpha_Hint
 {
 	ENESIM_ALPHA_HINT_NORMAL, /**< Alpha can be in the whole range */
 	ENESIM_ALPHA_HINT_SPARSE, /**< Alpha is sparsed only, that is or 0 or 255 */
-	ENESIM_ALPHA_HINT_OPAQUE, /**< Alpha is always 0 */
+	ENESIM_ALPHA_HINT_OPAQUE, /**< Alpha is always 255 */
 	ENESIM_ALPHA_HINT_LAST /**< The number of alpha hints */
 } Enesim_Alpha_Hint;
 
@@ -129,10 +134,27 @@ typedef enum _Enesim_Backend
  * @{
  */
 
+/**
+ * The cpu affinity policy of the drawing threads
+ */
+typedef enum _Enesim_Thread_Affinity
+{
+	ENESIM_THREAD_AFFINITY_PINNED, /**< Every thread is pinned to its own cpu */
+	ENESIM_THREAD_AFFINITY_NONE, /**< The threads can run on any cpu */
+	ENESIM_THREAD_AFFINITY_CPUS, /**< The threads are pinned to a list of cpus */
+	ENESIM_THREAD_AFFINITY_LAST
+} Enesim_Thread_Affinity;
+
 EAPI int enesim_init(void);
 EAPI int enesim_shutdown(void);
 EAPI void enesim_version_get(unsigned int *major, unsigned int *minor, unsigned int *micro);
 
+EAPI void enesim_threads_set(unsigned int count);
+EAPI unsigned int enesim_threads_get(void);
+EAPI Eina_Bool enesim_threads_affinity_set(Enesim_Thread_Affinity affinity,
+		const unsigned int *cpus, unsigned int count);
+EAPI Enesim_Thread_Affinity enesim_threads_affinity_get(void);
+
 /** @} */
 
 #endif /*ENESIM_MAIN_H_*/
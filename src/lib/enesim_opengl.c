@@ -109,6 +109,24 @@ void enesim_opengl_rop_set(Enesim_Rop rop)
 		glBlendFunc(GL_ONE, GL_ZERO);
 		break;
 
+		case ENESIM_ROP_DST_OUT:
+		glBlendFunc(GL_ZERO, GL_ONE_MINUS_SRC_ALPHA);
+		break;
+
+		case ENESIM_ROP_SRC_IN:
+		glBlendFunc(GL_DST_ALPHA, GL_ZERO);
+		break;
+
+		case ENESIM_ROP_DST_IN:
+		glBlendFunc(GL_ZERO, GL_SRC_ALPHA);
+		break;
+
+		case ENESIM_ROP_SCREEN:
+		glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_COLOR);
+		break;
+
+		/* TODO the multiply needs a shader */
+
 		default:
 		break;
 	}
@@ -211,6 +211,7 @@ void enesim_pool_shutdown(void)
 {
 	/* destroy the default pool */
 	enesim_pool_unref(_current_default_pool);
+	_current_default_pool = NULL;
 }
 /** @endcond */
 /*============================================================================*
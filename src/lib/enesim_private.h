@@ -55,23 +55,12 @@
 
 /* the libargb needed macros */
 /* SIMD intrinsics */
-#ifdef ENS_HAVE_MMX
-#define LIBARGB_MMX 1
-#else
+/* The generic functions must run on every cpu, the SIMD functions are
+ * selected at runtime by the compositor (see enesim_cpu.c)
+ */
 #define LIBARGB_MMX 0
-#endif
-
-#ifdef  ENS_HAVE_SSE
-#define LIBARGB_SSE 1
-#else
 #define LIBARGB_SSE 0
-#endif
-
-#ifdef ENS_HAVE_SSE2
-#define LIBARGB_SSE2 1
-#else
 #define LIBARGB_SSE2 0
-#endif
 
 #define LIBARGB_DEBUG 0
 
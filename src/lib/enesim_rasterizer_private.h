@@ -60,4 +60,6 @@ void enesim_rasterizer_basic_vectors_get(Enesim_Renderer *r, int *nvectors,
 Enesim_Renderer * enesim_rasterizer_bifigure_new(void);
 void enesim_rasterizer_bifigure_over_figure_set(Enesim_Renderer *r, const Enesim_Figure *figure);
 
+Enesim_Renderer * enesim_rasterizer_coverage_new(void);
+
 #endif
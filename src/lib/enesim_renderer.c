@@ -68,7 +68,18 @@ typedef struct _Enesim_Renderer_Factory
 	int id;
 } Enesim_Renderer_Factory;
 
+struct _Enesim_Renderer_Draw_Future
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *s;
+	Enesim_Backend backend;
+	/* NULL in case there is nothing to wait for */
+	Enesim_Renderer_Sw_Job *sw_job;
+};
+
 static Eina_Hash *_factories = NULL;
+/* renderers can be created from the workers, i.e on a parallel setup */
+static Eina_Lock _factories_lock;
 static Enesim_Quality _default_quality = ENESIM_QUALITY_BEST;
 
 static void _enesim_renderer_factory_free(void *data)
@@ -260,35 +271,30 @@ static void _draw_list_internal(Enesim_Renderer *r, Enesim_Surface *s,
 		int y)
 {
 	Enesim_Backend b;
-	Eina_Rectangle *clip;
-	Eina_List *l;
 
 	enesim_surface_lock(s, EINA_TRUE);
 	b = enesim_surface_backend_get(s);
 	switch (b)
 	{
 		case ENESIM_BACKEND_SOFTWARE:
-		EINA_LIST_FOREACH(clips, l, clip)
-		{
-			Eina_Rectangle final;
-
-			final = *clip;
-			if (!eina_rectangle_intersection(&final, area))
-				continue;
-			enesim_renderer_sw_draw_area(r, s, rop, &final, x, y);
-		}
+		enesim_renderer_sw_draw_list(r, s, rop, area, clips, x, y);
 		break;
 
 		case ENESIM_BACKEND_OPENGL:
 #if BUILD_OPENGL
-		EINA_LIST_FOREACH(clips, l, clip)
 		{
-			Eina_Rectangle final;
-
-			final = *clip;
-			if (!eina_rectangle_intersection(&final, area))
-				continue;
-			enesim_renderer_opengl_draw(r, s, rop, &final, x, y);
+			Eina_Rectangle *clip;
+			Eina_List *l;
+
+			EINA_LIST_FOREACH(clips, l, clip)
+			{
+				Eina_Rectangle final;
+
+				final = *clip;
+				if (!eina_rectangle_intersection(&final, area))
+					continue;
+				enesim_renderer_opengl_draw(r, s, rop, &final, x, y);
+			}
 		}
 #endif
 		break;
@@ -330,6 +336,7 @@ static void _enesim_renderer_factory_setup(Enesim_Renderer *r)
 	if (!_factories) return;
 
 	descriptor_name = _base_name_get(r);
+	eina_lock_take(&_factories_lock);
 	f = eina_hash_find(_factories, descriptor_name);
 	if (!f)
 	{
@@ -338,6 +345,7 @@ static void _enesim_renderer_factory_setup(Enesim_Renderer *r)
 	}
 	/* assign a new name for it automatically */
 	snprintf(renderer_name, PATH_MAX, "%s%d", descriptor_name, f->id++);
+	eina_lock_release(&_factories_lock);
 	enesim_renderer_name_set(r, renderer_name);
 }
 /*----------------------------------------------------------------------------*
@@ -379,6 +387,10 @@ static void _enesim_renderer_instance_init(void *o)
 	eina_rectangle_coords_from(&thiz->past_destination_bounds, INT_MIN / 2, INT_MIN / 2, INT_MAX, INT_MAX);
 	thiz->prv_data = eina_hash_string_superfast_new(NULL);
 	eina_lock_new(&thiz->lock);
+	eina_condition_new(&thiz->unlocked, &thiz->lock);
+	thiz->locked = EINA_FALSE;
+	thiz->threads_max = 0;
+	thiz->threads_rows_min = 0;
 	/* always set the first reference */
 	thiz = enesim_renderer_ref(thiz);
 	_enesim_renderer_factory_setup(thiz);
@@ -388,6 +400,7 @@ static void _enesim_renderer_instance_deinit(void *o)
 {
 	Enesim_Renderer *thiz = ENESIM_RENDERER(o);
 
+	eina_condition_free(&thiz->unlocked);
 	eina_lock_free(&thiz->lock);
 	eina_hash_free(thiz->prv_data);
 	/* remove all the private data */
@@ -414,6 +427,7 @@ void enesim_renderer_init(void)
 {
 	_factories = eina_hash_string_superfast_new(
 			_enesim_renderer_factory_free);
+	eina_lock_new(&_factories_lock);
 	enesim_renderer_sw_init();
 #if BUILD_OPENGL
 	enesim_renderer_opengl_init();
@@ -428,6 +442,7 @@ void enesim_renderer_shutdown(void)
 #endif
 	eina_hash_free(_factories);
 	_factories = NULL;
+	eina_lock_free(&_factories_lock);
 }
 
 /* FIXME export this */
@@ -644,11 +659,21 @@ EAPI int enesim_renderer_ref_count(Enesim_Renderer *r)
  *
  * @note The renderer is automatically locked before a drawing
  * operation
+ * @note The renderer can be unlocked from a different thread than the
+ * one that locked it
  */
 EAPI void enesim_renderer_lock(Enesim_Renderer *r)
 {
 	ENESIM_MAGIC_CHECK_RENDERER(r);
+	/* the setup of a renderer might happen on a worker thread while
+	 * the cleanup happens on the drawing thread, so we can not keep
+	 * a mutex taken between both
+	 */
 	eina_lock_take(&r->lock);
+	while (r->locked)
+		eina_condition_wait(&r->unlocked);
+	r->locked = EINA_TRUE;
+	eina_lock_release(&r->lock);
 }
 
 /**
@@ -661,6 +686,9 @@ EAPI void enesim_renderer_lock(Enesim_Renderer *r)
 EAPI void enesim_renderer_unlock(Enesim_Renderer *r)
 {
 	ENESIM_MAGIC_CHECK_RENDERER(r);
+	eina_lock_take(&r->lock);
+	r->locked = EINA_FALSE;
+	eina_condition_signal(&r->unlocked);
 	eina_lock_release(&r->lock);
 }
 
@@ -689,6 +717,27 @@ EAPI Enesim_Renderer_Feature enesim_renderer_features_get(Enesim_Renderer *r)
 	}
 	return features;
 }
+
+/**
+ * @brief Get the alpha hints of the pixels a renderer draws
+ * @param[in] r The renderer to get the alpha hints from
+ * @return The renderer alpha hints
+ *
+ * The hints are computed with the current state of the renderer,
+ * including its color, and are only valid inside its bounds
+ */
+EAPI Enesim_Alpha_Hint enesim_renderer_alpha_hints_get(Enesim_Renderer *r)
+{
+	Enesim_Renderer_Class *klass;
+	Enesim_Alpha_Hint hints = ENESIM_ALPHA_HINT_NORMAL;
+
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	klass = ENESIM_RENDERER_CLASS_GET(r);
+
+	if (klass->alpha_hints_get)
+		klass->alpha_hints_get(r, &hints);
+	return hints;
+}
 /**
  * @brief Sets the transformation matrix of a renderer
  * @param[in] r The renderer to set the transformation matrix on
@@ -940,6 +989,58 @@ EAPI Enesim_Quality enesim_renderer_quality_get(Enesim_Renderer *r)
 	return r->state.current.quality;
 }
 
+/**
+ * @brief Sets the maximum number of threads a draw of a renderer can use
+ * @param[in] r The renderer to set the maximum number of threads to
+ * @param[in] max The maximum number of threads, 0 for no limit
+ * @note This is a hint for the software backend, it does not change
+ * the result of a draw. The number of threads is also limited by
+ * enesim_threads_get()
+ */
+EAPI void enesim_renderer_threads_max_set(Enesim_Renderer *r, unsigned int max)
+{
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	r->threads_max = max;
+}
+
+/**
+ * @brief Gets the maximum number of threads a draw of a renderer can use
+ * @param[in] r The renderer to get the maximum number of threads from
+ * @return The maximum number of threads, 0 for no limit
+ */
+EAPI unsigned int enesim_renderer_threads_max_get(Enesim_Renderer *r)
+{
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	return r->threads_max;
+}
+
+/**
+ * @brief Sets the minimum number of rows every thread of a draw must draw
+ * @param[in] r The renderer to set the minimum number of rows to
+ * @param[in] rows The minimum number of rows, 0 for the default
+ * @note A draw is only split among as many threads as can draw at least
+ * @a rows rows each, so small draws happen on the calling thread without
+ * the cost of synchronizing with the workers. Use a higher value for cheap
+ * renderers and a lower one for expensive ones. This is a hint for the
+ * software backend, it does not change the result of a draw
+ */
+EAPI void enesim_renderer_threads_rows_min_set(Enesim_Renderer *r, unsigned int rows)
+{
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	r->threads_rows_min = rows;
+}
+
+/**
+ * @brief Gets the minimum number of rows every thread of a draw must draw
+ * @param[in] r The renderer to get the minimum number of rows from
+ * @return The minimum number of rows, 0 for the default
+ */
+EAPI unsigned int enesim_renderer_threads_rows_min_get(Enesim_Renderer *r)
+{
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	return r->threads_rows_min;
+}
+
 /**
  * @brief Gets the transformation type of the transformation attribute
  * of a renderer.
@@ -987,8 +1088,11 @@ EAPI Eina_Bool enesim_renderer_is_supported(Enesim_Renderer *r, Enesim_Surface *
 	}
 	/* the supported format */
 	fmt = enesim_surface_format_get(s);
+	/* the software argb8888 spans are composed into a8 surfaces too */
 	if ((fmt == ENESIM_FORMAT_A8) &&
-			!(features & ENESIM_RENDERER_FEATURE_A8))
+			!(features & ENESIM_RENDERER_FEATURE_A8) &&
+			!((backend == ENESIM_BACKEND_SOFTWARE) &&
+			(features & ENESIM_RENDERER_FEATURE_ARGB8888)))
 	{
 		WRN("A8 surfaces not supported");
 		return EINA_FALSE;
@@ -1210,6 +1314,134 @@ end:
 	return ret;
 }
 
+/**
+ * Start drawing a renderer into a surface without waiting for it to finish
+ * @param[in] r The renderer to draw
+ * @param[in] s The surface to draw the renderer into
+ * @param[in] rop The raster operation to use for drawing
+ * @param[in] clip The area on the destination surface to limit the drawing
+ * @param[in] x The x origin of the destination surface
+ * @param[in] y The y origin of the destination surface
+ * @param[in] log In case the drawing fails, the log to put messages on
+ * @return The handle to wait for the drawing or NULL if the drawing failed.
+ * In case the drawing fails the @p log is filled with the failed message
+ *
+ * The renderer and the surface are locked until the returned handle is
+ * waited for with enesim_renderer_draw_future_wait(), which must be called
+ * from the same thread that started the drawing. Until then the renderer
+ * must not be modified nor drawn again.
+ */
+EAPI Enesim_Renderer_Draw_Future * enesim_renderer_draw_async(Enesim_Renderer *r,
+		Enesim_Surface *s, Enesim_Rop rop, Eina_Rectangle *clip, int x,
+		int y, Enesim_Log **log)
+{
+	Enesim_Renderer_Draw_Future *f;
+	Eina_Rectangle final;
+
+	ENESIM_MAGIC_CHECK_RENDERER(r);
+	ENESIM_MAGIC_CHECK_SURFACE(s);
+
+	if (r->in_setup)
+	{
+		ENESIM_RENDERER_LOG(r, log, "Renderer '%s' is already being drawn", r->name);
+		return NULL;
+	}
+
+	if (!enesim_renderer_setup(r, s, rop, log))
+		goto end;
+
+	if (!clip)
+	{
+		_surface_bounds(s, &final);
+	}
+	else
+	{
+		Eina_Rectangle surface_size;
+
+		final.x = clip->x;
+		final.y = clip->y;
+		final.w = clip->w;
+		final.h = clip->h;
+		_surface_bounds(s, &surface_size);
+		if (!eina_rectangle_intersection(&final, &surface_size))
+		{
+			WRN("The clipping area does not intersect with the surface");
+			goto end;
+		}
+	}
+
+	f = calloc(1, sizeof(Enesim_Renderer_Draw_Future));
+	if (!f)
+	{
+		ENESIM_RENDERER_LOG(r, log, "Not enough memory to draw '%s'", r->name);
+		goto end;
+	}
+	f->backend = enesim_surface_backend_get(s);
+	/* only the software backend can draw in the background */
+	if (f->backend == ENESIM_BACKEND_SOFTWARE)
+	{
+		enesim_surface_lock(s, EINA_TRUE);
+		DBG("Drawing area %" EINA_RECTANGLE_FORMAT,
+				EINA_RECTANGLE_ARGS (&final));
+		if (!enesim_renderer_sw_draw_area_async(r, s, rop, &final,
+				x, y, &f->sw_job))
+		{
+			ENESIM_RENDERER_LOG(r, log, "Not enough memory to draw '%s'", r->name);
+			enesim_surface_unlock(s);
+			free(f);
+			goto end;
+		}
+	}
+	else
+	{
+		_draw_internal(r, s, rop, &final, x, y);
+	}
+	f->r = enesim_renderer_ref(r);
+	f->s = enesim_surface_ref(s);
+	return f;
+end:
+	enesim_renderer_cleanup(r, s);
+
+	return NULL;
+}
+
+/**
+ * Check if an asynchronous drawing has finished
+ * @param[in] f The handle returned by enesim_renderer_draw_async()
+ * @return EINA_TRUE if the drawing has finished, EINA_FALSE otherwise
+ *
+ * @note Even if the drawing has finished, the handle must be waited for
+ * to release it.
+ */
+EAPI Eina_Bool enesim_renderer_draw_future_is_done(Enesim_Renderer_Draw_Future *f)
+{
+	if (!f) return EINA_TRUE;
+	if (!f->sw_job) return EINA_TRUE;
+	return enesim_renderer_sw_job_is_done(f->sw_job);
+}
+
+/**
+ * Wait for an asynchronous drawing to finish
+ * @param[in] f The handle returned by enesim_renderer_draw_async()
+ *
+ * The calling thread helps drawing until the drawing is finished, then
+ * the renderer and the surface are unlocked and the handle is freed.
+ */
+EAPI void enesim_renderer_draw_future_wait(Enesim_Renderer_Draw_Future *f)
+{
+	if (!f) return;
+	if (f->backend == ENESIM_BACKEND_SOFTWARE)
+	{
+		if (f->sw_job)
+			enesim_renderer_sw_job_wait(f->sw_job);
+		enesim_surface_unlock(f->s);
+	}
+	enesim_renderer_cleanup(f->r, f->s);
+	enesim_surface_unref(f->s);
+	enesim_renderer_unref(f->r);
+	free(f);
+}
+
 /**
  * Draw a renderer into a surface
  * @param[in] r The renderer to draw
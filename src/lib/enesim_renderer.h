@@ -30,6 +30,7 @@
  */
 
 typedef struct _Enesim_Renderer Enesim_Renderer; /**< Renderer Handle */
+typedef struct _Enesim_Renderer_Draw_Future Enesim_Renderer_Draw_Future; /**< Asynchronous draw handle */
 
 /** Flags that specify what a renderer supports */
 typedef enum _Enesim_Renderer_Feature
@@ -86,6 +87,10 @@ EAPI void enesim_renderer_mask_set(Enesim_Renderer *r, Enesim_Renderer *mask);
 EAPI Enesim_Renderer * enesim_renderer_mask_get(Enesim_Renderer *r);
 EAPI void enesim_renderer_quality_set(Enesim_Renderer *r, Enesim_Quality quality);
 EAPI Enesim_Quality enesim_renderer_quality_get(Enesim_Renderer *r);
+EAPI void enesim_renderer_threads_max_set(Enesim_Renderer *r, unsigned int max);
+EAPI unsigned int enesim_renderer_threads_max_get(Enesim_Renderer *r);
+EAPI void enesim_renderer_threads_rows_min_set(Enesim_Renderer *r, unsigned int rows);
+EAPI unsigned int enesim_renderer_threads_rows_min_get(Enesim_Renderer *r);
 
 EAPI Eina_Bool enesim_renderer_is_supported(Enesim_Renderer *r, Enesim_Surface *s);
 
@@ -96,6 +101,7 @@ EAPI Eina_Bool enesim_renderer_destination_bounds_get(Enesim_Renderer *r, Eina_R
 EAPI Eina_Bool enesim_renderer_destination_bounds_get_extended(Enesim_Renderer *r, Eina_Rectangle *prev, Eina_Rectangle *curr, int x, int y);
 
 EAPI Enesim_Renderer_Feature enesim_renderer_features_get(Enesim_Renderer *r);
+EAPI Enesim_Alpha_Hint enesim_renderer_alpha_hints_get(Enesim_Renderer *r);
 EAPI Eina_Bool enesim_renderer_is_inside(Enesim_Renderer *r, double x, double y);
 EAPI Eina_Bool enesim_renderer_has_changed(Enesim_Renderer *r);
 EAPI Eina_Bool enesim_renderer_damages_get(Enesim_Renderer *r, Enesim_Renderer_Damage_Cb cb, void *data);
@@ -104,6 +110,11 @@ EAPI Eina_Bool enesim_renderer_draw(Enesim_Renderer *r, Enesim_Surface *s,
 		Enesim_Rop rop, Eina_Rectangle *clip, int x, int y, Enesim_Log **log);
 EAPI Eina_Bool enesim_renderer_draw_list(Enesim_Renderer *r, Enesim_Surface *s,
 		Enesim_Rop rop, Eina_List *clips, int x, int y, Enesim_Log **log);
+EAPI Enesim_Renderer_Draw_Future * enesim_renderer_draw_async(Enesim_Renderer *r,
+		Enesim_Surface *s, Enesim_Rop rop, Eina_Rectangle *clip, int x,
+		int y, Enesim_Log **log);
+EAPI Eina_Bool enesim_renderer_draw_future_is_done(Enesim_Renderer_Draw_Future *f);
+EAPI void enesim_renderer_draw_future_wait(Enesim_Renderer_Draw_Future *f);
 
 EAPI void enesim_renderer_default_quality_set(Enesim_Quality quality);
 
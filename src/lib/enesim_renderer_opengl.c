@@ -419,7 +419,8 @@ void enesim_renderer_opengl_draw(Enesim_Renderer *r, Enesim_Surface *s,
 
 	intersect = eina_rectangle_intersection(&sarea, &final);
 	/* when filling be sure to clear the the area that we dont draw */
-	if (rop == ENESIM_ROP_FILL)
+	if (rop == ENESIM_ROP_FILL || rop == ENESIM_ROP_SRC_IN ||
+			rop == ENESIM_ROP_DST_IN)
 	{
 		/* just clear the whole area */
 		if (!intersect)
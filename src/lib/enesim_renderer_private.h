@@ -120,6 +120,8 @@ typedef struct _Enesim_Renderer_Class
 	Enesim_Renderer_Sw_Hints_Get_Cb sw_hints_get;
 	Enesim_Renderer_Sw_Setup sw_setup;
 	Enesim_Renderer_Sw_Cleanup sw_cleanup;
+	Enesim_Renderer_Sw_Runs sw_runs;
+	Enesim_Renderer_Sw_Fill_Block sw_fill_block;
 	/* opencl based functions */
 	Enesim_Renderer_OpenCL_Setup opencl_setup;
 	Enesim_Renderer_OpenCL_Kernel_Setup opencl_kernel_setup;
@@ -142,6 +144,8 @@ struct _Enesim_Renderer
 	int ref;
 	/* the private data */
 	Eina_Lock lock;
+	Eina_Condition unlocked;
+	Eina_Bool locked;
 	Eina_Hash *prv_data;
 	Enesim_Renderer_Feature current_features_get;
 	Enesim_Rectangle current_bounds;
@@ -156,6 +160,9 @@ struct _Enesim_Renderer
 	 * surface or opencl surface, we need an array to keep *ALL* the
 	 * possible data */
 	void *backend_data[ENESIM_BACKEND_LAST];
+	/* the parallelism hints of a software draw */
+	unsigned int threads_max;
+	unsigned int threads_rows_min;
 	Eina_Bool in_setup : 1;
 };
 
@@ -21,6 +21,7 @@
  */
 
 #include "enesim_private.h"
+#include "libargb.h"
 
 #include "enesim_main.h"
 #include "enesim_log.h"
@@ -49,10 +50,111 @@
 /** @cond internal */
 #define ENESIM_LOG_DEFAULT enesim_log_renderer
 
+/* An area to draw, already clipped, in renderer coordinates */
+typedef struct _Enesim_Renderer_Sw_Area
+{
+	Eina_Rectangle area;
+	/* the destination pointer of the area origin */
+	uint8_t *dst;
+#ifdef BUILD_MULTI_CORE
+	/* the first band of the area */
+	unsigned int band;
+#endif
+} Enesim_Renderer_Sw_Area;
+
+static Enesim_Thread_Affinity _affinity = ENESIM_THREAD_AFFINITY_PINNED;
+
+/* The number of pixels filled and composed at once when the renderer
+ * allows splitting its spans, small enough to keep the scratch, the mask
+ * and the destination spans on the first level cache
+ */
+#define ENESIM_RENDERER_SW_CHUNK 1024
+/* The shortest solid run written with the streaming span, the shorter ones
+ * would only fill some of the write combining buffers
+ */
+#define ENESIM_RENDERER_SW_STREAM_RUN 64
+
 #ifdef BUILD_MULTI_CORE
+/* The minimum number of rows a band can have */
+#define ENESIM_RENDERER_SW_BAND_MIN 8
+/* The number of bands every thread receives initially */
+#define ENESIM_RENDERER_SW_BANDS_PER_THREAD 4
+/* The default minimum number of rows every thread must draw */
+#define ENESIM_RENDERER_SW_THREAD_ROWS_MIN 16
+
+/* A range of consecutive bands owned by a slot of a job */
+typedef struct _Enesim_Renderer_Sw_Range
+{
+	unsigned int next;
+	unsigned int end;
+} Enesim_Renderer_Sw_Range;
+
+/* A draw is split into bands of contiguous rows. The bands of every area
+ * to draw are numbered consecutively and distributed in contiguous ranges,
+ * one per slot. Every thread that runs the job takes a slot and draws the
+ * bands of its range from the top. Once the range is exhausted the thread
+ * steals the bottom half of the biggest range left
+ */
+struct _Enesim_Renderer_Sw_Job
+{
+	EINA_INLIST;
+	Enesim_Renderer_Thread_Operation op;
+	Enesim_Renderer_Sw_Area *areas;
+	unsigned int nareas;
+	Enesim_Renderer_Sw_Range *ranges;
+	unsigned int nslots;
+	unsigned int band_h;
+	/* the length of the scratch span */
+	size_t len;
+	/* in case the job is not a draw, the function to call per band */
+	Enesim_Renderer_Sw_Parallel_Cb cb;
+	void *data;
+	/* the number of slots already taken */
+	unsigned int started;
+	/* the number of threads running the job */
+	unsigned int running;
+	/* the number of bands not drawn yet */
+	unsigned int pending;
+	Eina_Bool queued;
+};
+
 static unsigned int _num_cpus;
+/* the number of threads that draw, the calling one included */
+static unsigned int _num_threads;
+static unsigned int *_affinity_cpus = NULL;
+static unsigned int _affinity_ncpus = 0;
+static Enesim_Renderer_Thread *_threads = NULL;
+static Eina_Bool _threads_done = EINA_FALSE;
+/* serializes the changes on the number of threads and their affinity */
+static Eina_Lock _pool_lock;
+/* the number of jobs with bands not drawn yet */
+static unsigned int _jobs_active = 0;
+/* the queue of jobs with bands not claimed yet */
+static Eina_Inlist *_jobs = NULL;
+static Eina_Lock _jobs_lock;
+/* signaled whenever a job is queued */
+static Eina_Condition _jobs_cond;
+/* signaled whenever a job is finished */
+static Eina_Condition _done_cond;
 #endif
 
+/* The renderers only know how to fill or blend, for any other operation
+ * the renderer fills and the compositor does the rest
+ */
+static inline Eina_Bool _sw_rop_is_native(Enesim_Rop rop)
+{
+	return (rop == ENESIM_ROP_BLEND || rop == ENESIM_ROP_FILL);
+}
+
+/* The operations that leave the destination transparent where there is
+ * nothing to draw
+ */
+static inline Eina_Bool _sw_rop_clears(Enesim_Rop rop)
+{
+	return (rop == ENESIM_ROP_FILL || rop == ENESIM_ROP_SRC_IN ||
+			rop == ENESIM_ROP_DST_IN);
+}
+
 static inline Eina_Bool _is_sw_draw_composed(Enesim_Color *color,
 		Enesim_Rop *rop, Enesim_Renderer_Sw_Hint hints)
 {
@@ -67,6 +169,28 @@ static inline Eina_Bool _is_sw_draw_composed(Enesim_Color *color,
 	return EINA_TRUE;
 }
 
+/* The solid runs of a fill composed with the pixel span of rop and color
+ * are composed with the color spans of the same rop. The pixel span
+ * multiplies every pixel with the color, in that case the runs are still
+ * composed with it to give the same result
+ */
+static void _sw_solid_setup(Enesim_Renderer_Sw_Solid *solid,
+		Enesim_Renderer_Sw_Runs runs, Enesim_Rop rop,
+		Enesim_Format dfmt, Enesim_Color color)
+{
+	solid->runs = NULL;
+	if (!runs)
+		return;
+	solid->color = color;
+	solid->span = enesim_compositor_span_get(rop, &dfmt,
+			ENESIM_FORMAT_NONE, 0x00000000, ENESIM_FORMAT_NONE);
+	solid->opaque_span = enesim_compositor_span_get(rop, &dfmt,
+			ENESIM_FORMAT_NONE, ENESIM_COLOR_FULL,
+			ENESIM_FORMAT_NONE);
+	if (solid->span && solid->opaque_span)
+		solid->runs = runs;
+}
+
 static inline void _sw_surface_setup(Enesim_Surface *s, Enesim_Format *dfmt, void **data, size_t *stride, size_t *bpp)
 {
 	Enesim_Buffer_Sw_Data *bdata;
@@ -87,46 +211,106 @@ static inline void _sw_surface_setup(Enesim_Surface *s, Enesim_Format *dfmt, voi
 	}
 }
 
-/* worst case, rop+color+mask(rop+color) */
-/* rop+color+mask */
-/* rop+mask */
-/* color+mask */
-/* mask */
-/* color */
-/* rop */
+/* Compose a span of a fill that gives runs of a solid color, the solid
+ * runs are composed directly with the color spans and only the rest is
+ * filled
+ */
+static inline void _sw_span_runs_draw(Enesim_Renderer *r,
+		Enesim_Renderer_Sw_Fill fill,
+		Enesim_Compositor_Span span,
+		const Enesim_Renderer_Sw_Solid *solid,
+		Eina_Bool span_clear,
+		Enesim_Color color,
+		int x, int y, int len,
+		uint8_t *ddata, size_t bpp,
+		uint8_t *tmp)
+{
+	while (len > 0)
+	{
+		Enesim_Color c;
+		int n;
+
+		n = solid->runs(r, x, y, len, &c);
+		if (n > 0 && solid->color != ENESIM_COLOR_FULL)
+		{
+			/* compose the run as the fill would, the pixel span
+			 * multiplies it with the color
+			 */
+			argb8888_sp_none_color_none_fill((uint32_t *)tmp, n,
+					NULL, c, NULL);
+			span((uint32_t *)ddata, n, (uint32_t *)tmp, color,
+					NULL);
+		}
+		else if (n > 0)
+		{
+			if ((c >> 24) == 0xff)
+				solid->opaque_span((uint32_t *)ddata, n, NULL, c,
+						NULL);
+			else
+				solid->span((uint32_t *)ddata, n, NULL, c,
+						NULL);
+		}
+		else
+		{
+			n = -n;
+			if (span_clear)
+				memset(tmp, 0, n * sizeof(uint32_t));
+			fill(r, x, y, n, tmp);
+			span((uint32_t *)ddata, n, (uint32_t *)tmp, color,
+					NULL);
+		}
+		x += n;
+		len -= n;
+		ddata += n * bpp;
+	}
+}
 
+/* rop = any
+ * color = any
+ * mask = any (~FLAG_MASK)
+ */
 static inline void _sw_surface_draw_rop_mask(Enesim_Renderer *r,
 		Enesim_Renderer_Sw_Fill fill,
-		Enesim_Renderer_Sw_Fill mask_fill,
+		Enesim_Renderer *mask,
 		Enesim_Compositor_Span span,
-		Enesim_Compositor_Span mask_span EINA_UNUSED,
-		uint8_t *ddata, size_t stride,
+		Enesim_Compositor_Span color_span,
+		Eina_Bool span_clear,
+		int chunk,
+		uint8_t *ddata, size_t stride, size_t bpp,
 		uint8_t *tmp,
 		uint8_t *tmp_mask,
-		size_t len,
 		Eina_Rectangle *area)
 {
-	Enesim_Renderer *mask;
 	Enesim_Color color;
 
-	mask = enesim_renderer_mask_get(r);
 	color = enesim_renderer_color_get(r);
-
+	if (!chunk)
+		chunk = area->w;
 	while (area->h--)
 	{
-		/* FIXME we should not memset this */
-		memset(tmp_mask, 0, len);
-		memset(tmp, 0, len);
+		int x;
 
-		fill(r, area->x, area->y, area->w, tmp);
-		mask_fill(mask, area->x, area->y, area->w, tmp_mask);
+		for (x = 0; x < area->w; x += chunk)
+		{
+			int w = area->w - x;
+
+			if (w > chunk)
+				w = chunk;
+			/* only clear the span for fills that skip pixels */
+			if (span_clear)
+				memset(tmp, 0, w * sizeof(uint32_t));
+			fill(r, area->x + x, area->y, w, tmp);
+			/* the pixel mask compositors do not handle the color */
+			if (color_span)
+				color_span((uint32_t *)tmp, w, (uint32_t *)tmp, color, NULL);
+			enesim_renderer_sw_draw(mask, area->x + x, area->y, w, (uint32_t *)tmp_mask);
+			/* compose the filled and the destination spans */
+			span((uint32_t *)(ddata + x * bpp), w, (uint32_t *)tmp,
+					color, (uint32_t *)tmp_mask);
+		}
 		area->y++;
-		/* compose the filled and the destination spans */
-		span((uint32_t *)ddata, area->w, (uint32_t *)tmp, color, (uint32_t *)tmp_mask);
 		ddata += stride;
 	}
-	if (mask)
-		enesim_renderer_unref(mask);
 }
 
 /* rop = any (~FLAG_ROP)
@@ -135,21 +319,45 @@ static inline void _sw_surface_draw_rop_mask(Enesim_Renderer *r,
 static inline void _sw_surface_draw_rop(Enesim_Renderer *r,
 		Enesim_Renderer_Sw_Fill fill,
 		Enesim_Compositor_Span span,
-		uint8_t *ddata, size_t stride,
-		uint8_t *tmp, size_t len,
+		const Enesim_Renderer_Sw_Solid *solid,
+		Eina_Bool span_clear,
+		int chunk,
+		uint8_t *ddata, size_t stride, size_t bpp,
+		uint8_t *tmp,
 		Eina_Rectangle *area)
 {
 	Enesim_Color color;
 
 	color = enesim_renderer_color_get(r);
+	if (!chunk)
+		chunk = area->w;
 	while (area->h--)
 	{
-		/* FIXME we should not memset this */
-		memset(tmp, 0, len);
-		fill(r, area->x, area->y, area->w, tmp);
+		int x;
+
+		for (x = 0; x < area->w; x += chunk)
+		{
+			int w = area->w - x;
+
+			if (w > chunk)
+				w = chunk;
+			if (solid->runs)
+			{
+				_sw_span_runs_draw(r, fill, span, solid,
+						span_clear, color, area->x + x,
+						area->y, w, ddata + x * bpp,
+						bpp, tmp);
+				continue;
+			}
+			/* only clear the span for fills that skip pixels */
+			if (span_clear)
+				memset(tmp, 0, w * sizeof(uint32_t));
+			fill(r, area->x + x, area->y, w, tmp);
+			/* compose the filled and the destination spans */
+			span((uint32_t *)(ddata + x * bpp), w, (uint32_t *)tmp,
+					color, NULL);
+		}
 		area->y++;
-		/* compose the filled and the destination spans */
-		span((uint32_t *)ddata, area->w, (uint32_t *)tmp, color, NULL);
 		ddata += stride;
 	}
 }
@@ -159,76 +367,403 @@ static inline void _sw_surface_draw_rop(Enesim_Renderer *r,
  * mask = none
  */
 static inline void _sw_surface_draw_simple(Enesim_Renderer *r,
-		Enesim_Renderer_Sw_Fill fill, uint8_t *ddata,
-		size_t stride, Eina_Rectangle *area)
+		Enesim_Renderer_Sw_Fill fill,
+		Enesim_Renderer_Sw_Fill_Block fill_block,
+		const Enesim_Renderer_Sw_Solid *solid,
+		uint8_t *ddata, size_t stride, Eina_Rectangle *area)
 {
+	/* the whole area at once */
+	if (fill_block && !solid->runs)
+	{
+		fill_block(r, area->x, area->y, area->w, area->h, ddata,
+				stride);
+		return;
+	}
 	while (area->h--)
 	{
-		fill(r, area->x, area->y, area->w, ddata);
+		uint8_t *d = ddata;
+		int x = area->x;
+		int len = area->w;
+
+		/* the long solid runs are written with the streaming span */
+		while (solid->runs && len > 0)
+		{
+			Enesim_Color c;
+			int n;
+
+			n = solid->runs(r, x, area->y, len, &c);
+			if (n >= ENESIM_RENDERER_SW_STREAM_RUN)
+				solid->span((uint32_t *)d, n, NULL, c, NULL);
+			else
+			{
+				n = n > 0 ? n : -n;
+				fill(r, x, area->y, n, d);
+			}
+			x += n;
+			len -= n;
+			d += n * sizeof(uint32_t);
+		}
+		if (len > 0)
+			fill(r, x, area->y, len, d);
 		area->y++;
 		ddata += stride;
 	}
 }
 
-static inline void _sw_clear(uint8_t *ddata, size_t stride, int bpp,
-		Eina_Rectangle *area)
+static inline void _sw_clear(Enesim_Compositor_Span stream_span,
+		uint8_t *ddata, size_t stride, int bpp, Eina_Rectangle *area)
 {
 	ddata = ddata + (area->y * stride) + (area->x * bpp);
 	while (area->h--)
 	{
-		memset(ddata, 0x00, area->w * bpp);
+		if (stream_span)
+			stream_span((uint32_t *)ddata, area->w, NULL,
+					0x00000000, NULL);
+		else
+			memset(ddata, 0x00, area->w * bpp);
 		ddata += stride;
 	}
 }
+/*----------------------------------------------------------------------------*
+ *                          No threaded rendering                             *
+ *----------------------------------------------------------------------------*/
+static void _sw_draw_no_threaded(Enesim_Renderer *r,
+		Enesim_Renderer_Sw_Area *areas, unsigned int nareas,
+		size_t stride, Enesim_Format dfmt EINA_UNUSED)
+{
+	Enesim_Renderer_Sw_Data *sw_data;
+	uint8_t *fdata = NULL;
+	size_t len = 0;
+	unsigned int i;
+
+	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
+	if (sw_data->span)
+	{
+		/* the scratch buffer must fit the widest area or a chunk */
+		for (i = 0; i < nareas; i++)
+		{
+			if (areas[i].area.w * sizeof(uint32_t) > len)
+				len = areas[i].area.w * sizeof(uint32_t);
+		}
+		if (sw_data->chunk && len > sw_data->chunk * sizeof(uint32_t))
+			len = sw_data->chunk * sizeof(uint32_t);
+		/* the mask is drawn right after the span */
+		fdata = alloca(sw_data->mask ? len * 2 : len);
+	}
+
+	for (i = 0; i < nareas; i++)
+	{
+		if (sw_data->mask)
+		{
+			_sw_surface_draw_rop_mask(r, sw_data->fill,
+					sw_data->mask, sw_data->span,
+					sw_data->color_span,
+					sw_data->span_clear, sw_data->chunk,
+					areas[i].dst, stride, sw_data->bpp,
+					fdata, fdata + len, &areas[i].area);
+		}
+		else if (sw_data->span)
+		{
+			_sw_surface_draw_rop(r, sw_data->fill, sw_data->span,
+					&sw_data->solid, sw_data->span_clear, sw_data->chunk,
+					areas[i].dst, stride, sw_data->bpp,
+					fdata, &areas[i].area);
+		}
+		else
+		{
+			_sw_surface_draw_simple(r, sw_data->fill,
+					sw_data->fill_block, &sw_data->solid,
+					areas[i].dst, stride, &areas[i].area);
+		}
+	}
+}
 /*----------------------------------------------------------------------------*
  *                            Threaded rendering                              *
  *----------------------------------------------------------------------------*/
 #ifdef BUILD_MULTI_CORE
-static inline void _sw_surface_draw_full_threaded(Enesim_Renderer *r,
-		unsigned int thread,
-		Enesim_Renderer_Sw_Fill fill, Enesim_Compositor_Span span,
-		uint8_t *ddata, size_t stride,
-		uint8_t *tmp, size_t len, Eina_Rectangle *area)
+static void _sw_job_band_draw(Enesim_Renderer_Sw_Job *job, unsigned int band,
+		uint8_t *tmp, size_t len)
 {
-	Enesim_Color color;
-	int h = area->h;
-	int y = area->y;
+	Enesim_Renderer_Thread_Operation *op = &job->op;
+	Enesim_Renderer_Sw_Area *sw_area;
+	Eina_Rectangle area;
+	uint8_t *ddata;
+	unsigned int lo = 0;
+	unsigned int hi = job->nareas;
+	unsigned int y;
 
-	color = enesim_renderer_color_get(r);
-	while (h)
+	/* look for the area the band belongs to */
+	while (hi - lo > 1)
 	{
-		if (h % _num_cpus != thread) goto end;
+		unsigned int mid = (lo + hi) / 2;
 
-		/* FIXME we should not memset this */
-		memset(tmp, 0, len);
-		fill(r, area->x, y, area->w, tmp);
-		/* compose the filled and the destination spans */
-		span((uint32_t *)ddata, area->w, (uint32_t *)tmp, color, NULL);
-end:
-		ddata += stride;
-		h--;
-		y++;
+		if (job->areas[mid].band <= band)
+			lo = mid;
+		else
+			hi = mid;
+	}
+	sw_area = &job->areas[lo];
+
+	area = sw_area->area;
+	y = (band - sw_area->band) * job->band_h;
+	area.y += y;
+	area.h -= y;
+	if (area.h > (int)job->band_h)
+		area.h = job->band_h;
+	ddata = sw_area->dst + (y * op->stride);
+
+	if (op->mask)
+	{
+		_sw_surface_draw_rop_mask(op->renderer, op->fill, op->mask,
+				op->span, op->color_span, op->span_clear,
+				op->chunk, ddata, op->stride, op->bpp, tmp,
+				tmp + len, &area);
+	}
+	else if (op->span)
+	{
+		_sw_surface_draw_rop(op->renderer, op->fill, op->span,
+				&op->solid, op->span_clear, op->chunk, ddata, op->stride,
+				op->bpp, tmp, &area);
+	}
+	else
+	{
+		_sw_surface_draw_simple(op->renderer, op->fill, op->fill_block,
+				&op->solid, ddata, op->stride, &area);
 	}
 }
 
-static inline void _sw_surface_draw_simple_threaded(Enesim_Renderer *r,
-		unsigned int thread,
-		Enesim_Renderer_Sw_Fill fill, uint8_t *ddata,
-		size_t stride, Eina_Rectangle *area)
+/* Must be called with the jobs lock taken. Gets the next band to draw
+ * for the thread that owns the @a slot, a negative slot means that the
+ * thread does not own any range and can only steal single bands
+ */
+static Eina_Bool _sw_job_band_get(Enesim_Renderer_Sw_Job *job, int slot,
+		unsigned int *band)
 {
-	int h = area->h;
-	int y = area->y;
+	Enesim_Renderer_Sw_Range *victim = NULL;
+	unsigned int max = 0;
+	unsigned int i;
 
-	while (h)
+	if (slot >= 0 && job->ranges[slot].next < job->ranges[slot].end)
 	{
-		if (h % _num_cpus != thread) goto end;
+		*band = job->ranges[slot].next++;
+		return EINA_TRUE;
+	}
 
-		fill(r, area->x, y, area->w, ddata);
-end:
-		ddata += stride;
-		h--;
-		y++;
+	/* steal from the range with more bands left */
+	for (i = 0; i < job->nslots; i++)
+	{
+		Enesim_Renderer_Sw_Range *range = &job->ranges[i];
+		unsigned int left = range->end - range->next;
+
+		if (left > max)
+		{
+			max = left;
+			victim = range;
+		}
 	}
+	if (!victim)
+	{
+		/* nothing else to hand out, no need to keep it queued */
+		if (job->queued)
+		{
+			_jobs = eina_inlist_remove(_jobs, EINA_INLIST_GET(job));
+			job->queued = EINA_FALSE;
+		}
+		return EINA_FALSE;
+	}
+
+	if (slot >= 0)
+	{
+		Enesim_Renderer_Sw_Range *range = &job->ranges[slot];
+		unsigned int half = (max + 1) / 2;
+
+		victim->end -= half;
+		range->next = victim->end;
+		range->end = victim->end + half;
+		*band = range->next++;
+	}
+	else
+	{
+		*band = --victim->end;
+	}
+	return EINA_TRUE;
+}
+
+/* Must be called with the jobs lock taken. The lock is released while
+ * the bands are being drawn. The @a thread is the worker running the job
+ * or NULL if the job is run by the thread that submitted it
+ */
+static void _sw_job_run(Enesim_Renderer_Sw_Job *job,
+		Enesim_Renderer_Thread *thread)
+{
+	unsigned int band;
+	uint8_t *tmp = NULL;
+	int slot = -1;
+
+	if (job->started < job->nslots)
+	{
+		slot = job->started++;
+		if (job->started == job->nslots && job->queued)
+		{
+			_jobs = eina_inlist_remove(_jobs, EINA_INLIST_GET(job));
+			job->queued = EINA_FALSE;
+		}
+	}
+	job->running++;
+
+	if (job->op.span)
+	{
+		size_t len = job->len;
+
+		/* the mask is drawn right after the span */
+		if (job->op.mask)
+			len *= 2;
+		/* the workers keep the scratch span between draws, the
+		 * submitter might be drawing from inside a fill so use
+		 * the stack there
+		 */
+		if (thread)
+		{
+			if (thread->tmp_len < len)
+			{
+				free(thread->tmp);
+				thread->tmp = malloc(len);
+				thread->tmp_len = thread->tmp ? len : 0;
+			}
+			tmp = thread->tmp;
+			/* use the stack, the next job allocates it again */
+			if (!tmp)
+				tmp = alloca(len);
+		}
+		else
+		{
+			tmp = alloca(len);
+		}
+	}
+
+	while (_sw_job_band_get(job, slot, &band))
+	{
+		eina_lock_release(&_jobs_lock);
+		if (job->cb)
+			job->cb(job->data, band);
+		else
+			_sw_job_band_draw(job, band, tmp, job->len);
+		eina_lock_take(&_jobs_lock);
+		job->pending--;
+		if (!job->pending && !--_jobs_active)
+			eina_condition_broadcast(&_done_cond);
+	}
+
+	job->running--;
+	if (!job->pending && !job->running)
+		eina_condition_broadcast(&_done_cond);
+}
+
+/* The number of threads that draw, the workers might be changed from
+ * any thread
+ */
+static unsigned int _sw_threads_get(void)
+{
+	unsigned int ret;
+
+	eina_lock_take(&_jobs_lock);
+	ret = _num_threads;
+	eina_lock_release(&_jobs_lock);
+	return ret;
+}
+
+/* The number of threads out of @a threads a draw of @a rows rows can be
+ * split into
+ */
+static unsigned int _sw_job_slots_get(Enesim_Renderer *r, unsigned int rows,
+		unsigned int threads)
+{
+	unsigned int slots = threads;
+	unsigned int rows_min;
+
+	if (r->threads_max && r->threads_max < slots)
+		slots = r->threads_max;
+	rows_min = r->threads_rows_min;
+	if (!rows_min)
+		rows_min = ENESIM_RENDERER_SW_THREAD_ROWS_MIN;
+	if (rows / rows_min < slots)
+		slots = rows / rows_min;
+	if (!slots)
+		slots = 1;
+	return slots;
+}
+
+/* Split the areas of a draw job in bands and set the number of slots of
+ * the job, at most @a threads. Returns the number of bands
+ */
+static unsigned int _sw_job_areas_split(Enesim_Renderer_Sw_Job *job,
+		unsigned int threads)
+{
+	unsigned int nbands;
+	unsigned int rows = 0;
+	unsigned int i;
+
+	/* split the areas in bands, keep a minimum of rows per band to
+	 * not lose the locality of the rows. The scratch span must fit
+	 * the widest area or a chunk
+	 */
+	job->len = 0;
+	for (i = 0; i < job->nareas; i++)
+	{
+		rows += job->areas[i].area.h;
+		if (job->areas[i].area.w * sizeof(uint32_t) > job->len)
+			job->len = job->areas[i].area.w * sizeof(uint32_t);
+	}
+	if (job->op.chunk && job->len > job->op.chunk * sizeof(uint32_t))
+		job->len = job->op.chunk * sizeof(uint32_t);
+	job->nslots = _sw_job_slots_get(job->op.renderer, rows, threads);
+	job->band_h = rows / (job->nslots * ENESIM_RENDERER_SW_BANDS_PER_THREAD);
+	if (job->band_h < ENESIM_RENDERER_SW_BAND_MIN)
+		job->band_h = ENESIM_RENDERER_SW_BAND_MIN;
+	nbands = 0;
+	for (i = 0; i < job->nareas; i++)
+	{
+		job->areas[i].band = nbands;
+		nbands += (job->areas[i].area.h + job->band_h - 1) / job->band_h;
+	}
+	return nbands;
+}
+
+static void _sw_job_submit(Enesim_Renderer_Sw_Job *job, unsigned int nbands)
+{
+	unsigned int i;
+
+	/* give every slot a contiguous range of bands */
+	for (i = 0; i < job->nslots; i++)
+	{
+		job->ranges[i].next = (nbands * i) / job->nslots;
+		job->ranges[i].end = (nbands * (i + 1)) / job->nslots;
+	}
+	job->started = 0;
+	job->running = 0;
+	job->pending = nbands;
+
+	eina_lock_take(&_jobs_lock);
+	if (nbands)
+		_jobs_active++;
+	job->queued = EINA_TRUE;
+	_jobs = eina_inlist_append(_jobs, EINA_INLIST_GET(job));
+	eina_condition_broadcast(&_jobs_cond);
+	eina_lock_release(&_jobs_lock);
+}
+
+/* The waiting thread does not sleep while the job still has bands to
+ * be claimed, it helps the workers instead. That also makes a draw
+ * issued from inside a worker (i.e a fill that draws another renderer)
+ * complete even if every worker is busy
+ */
+static void _sw_job_wait(Enesim_Renderer_Sw_Job *job)
+{
+	eina_lock_take(&_jobs_lock);
+	_sw_job_run(job, NULL);
+	while (job->pending || job->running)
+		eina_condition_wait(&_done_cond);
+	eina_lock_release(&_jobs_lock);
 }
 
 #ifdef _WIN32
@@ -237,51 +772,22 @@ static DWORD WINAPI _thread_run(void *data)
 static void * _thread_run(void *data)
 #endif
 {
-	Enesim_Renderer_Thread *thiz = data;
-	Enesim_Renderer_Sw_Data *sw_data = thiz->sw_data;
-	Enesim_Renderer_Thread_Operation *op = &sw_data->op;
+	Enesim_Renderer_Thread *thread = data;
 
-	do
+	eina_lock_take(&_jobs_lock);
+	while (!_threads_done)
 	{
-		enesim_barrier_wait(&sw_data->start);
-		if (thiz->done) goto end;
+		Enesim_Renderer_Sw_Job *job;
 
-		if (op->span)
+		if (!_jobs)
 		{
-			uint8_t *tmp;
-			size_t len;
-
-			len = op->area.w * sizeof(uint32_t);
-			/* FIXME remove this malloc. or we either
-			 * make the tmp buffer part of the renderer
-			 * and make it grow until we reach the span len
-			 * or alloca everytime
-			 */
-			tmp = malloc(len);
-			_sw_surface_draw_full_threaded(op->renderer,
-					thiz->cpuidx,
-					sw_data->fill,
-					op->span,
-					op->dst,
-					op->stride,
-					tmp,
-					len,
-					&op->area);
-			free(tmp);
+			eina_condition_wait(&_jobs_cond);
+			continue;
 		}
-		else
-		{
-			_sw_surface_draw_simple_threaded(op->renderer,
-					thiz->cpuidx,
-					sw_data->fill,
-					op->dst,
-					op->stride,
-					&op->area);
-		}
-		enesim_barrier_wait(&sw_data->end);
-	} while (1);
-
-end:
+		job = EINA_INLIST_CONTAINER_GET(_jobs, Enesim_Renderer_Sw_Job);
+		_sw_job_run(job, thread);
+	}
+	eina_lock_release(&_jobs_lock);
 #ifdef _WIN32
 	return 0;
 #else
@@ -289,98 +795,202 @@ end:
 #endif
 }
 
-static void _sw_draw_threaded(Enesim_Renderer *r, Eina_Rectangle *area,
-		uint8_t *ddata, size_t stride,
-		Enesim_Format dfmt EINA_UNUSED)
+static void _sw_job_setup(Enesim_Renderer_Sw_Job *job, Enesim_Renderer *r,
+		Enesim_Renderer_Sw_Area *areas, unsigned int nareas,
+		size_t stride)
 {
 	Enesim_Renderer_Sw_Data *sw_data;
 	Enesim_Renderer_Thread_Operation *op;
 
 	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
-	op = &sw_data->op;
+	op = &job->op;
 	/* fill the data needed for every threaded renderer */
 	op->renderer = r;
-	op->dst = ddata;
+	op->mask = sw_data->mask;
+	op->fill = sw_data->fill;
+	op->fill_block = sw_data->fill_block;
 	op->stride = stride;
-	op->area = *area;
-	op->mask_fill = NULL;
 	op->span = sw_data->span;
-
-	enesim_barrier_wait(&sw_data->start);
-	enesim_barrier_wait(&sw_data->end);
+	op->color_span = sw_data->color_span;
+	op->span_clear = sw_data->span_clear;
+	op->chunk = sw_data->chunk;
+	op->bpp = sw_data->bpp;
+	op->solid = sw_data->solid;
+	job->areas = areas;
+	job->nareas = nareas;
+	job->cb = NULL;
 }
-#else
-/*----------------------------------------------------------------------------*
- *                          No threaded rendering                             *
- *----------------------------------------------------------------------------*/
-static void _sw_draw_no_threaded(Enesim_Renderer *r,
-		Eina_Rectangle *area,
-		uint8_t *ddata, size_t stride,
-		Enesim_Format dfmt EINA_UNUSED)
+
+static void _sw_draw_threaded(Enesim_Renderer *r,
+		Enesim_Renderer_Sw_Area *areas, unsigned int nareas,
+		size_t stride, Enesim_Format dfmt)
 {
-	Enesim_Renderer_Sw_Data *sw_data;
+	Enesim_Renderer_Sw_Job job;
+	unsigned int nbands;
 
-	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
-	if (sw_data->span)
+	_sw_job_setup(&job, r, areas, nareas, stride);
+	nbands = _sw_job_areas_split(&job, _sw_threads_get());
+	/* not worth to synchronize with the workers */
+	if (job.nslots == 1)
 	{
-		uint8_t *fdata;
-		size_t len;
+		_sw_draw_no_threaded(r, areas, nareas, stride, dfmt);
+		return;
+	}
+	job.ranges = alloca(sizeof(Enesim_Renderer_Sw_Range) * job.nslots);
 
-		len = area->w * sizeof(uint32_t);
-		fdata = alloca(len);
-		_sw_surface_draw_rop(r, sw_data->fill, sw_data->span, ddata, stride, fdata, len, area);
+	_sw_job_submit(&job, nbands);
+	_sw_job_wait(&job);
+}
+
+/* Same as the above but the job is not waited for. The job, the
+ * slot ranges and the area are allocated in a single block, with room
+ * for the maximum number of slots. Returns NULL if the job can not be
+ * allocated
+ */
+static Enesim_Renderer_Sw_Job * _sw_draw_threaded_async(Enesim_Renderer *r,
+		Enesim_Renderer_Sw_Area *area, size_t stride)
+{
+	Enesim_Renderer_Sw_Job *job;
+	Enesim_Renderer_Sw_Area *job_area;
+	unsigned int threads;
+
+	threads = _sw_threads_get();
+	job = malloc(sizeof(Enesim_Renderer_Sw_Job) +
+			sizeof(Enesim_Renderer_Sw_Range) * threads +
+			sizeof(Enesim_Renderer_Sw_Area));
+	if (!job) return NULL;
+	job->ranges = (Enesim_Renderer_Sw_Range *)(job + 1);
+	job_area = (Enesim_Renderer_Sw_Area *)(job->ranges + threads);
+	*job_area = *area;
+	_sw_job_setup(job, r, job_area, 1, stride);
+
+	_sw_job_submit(job, _sw_job_areas_split(job, threads));
+	return job;
+}
+
+static void _sw_workers_start(void)
+{
+	unsigned int i;
+
+	_threads_done = EINA_FALSE;
+	/* the thread that draws also runs jobs, so we only need
+	 * as many workers as remaining threads
+	 */
+	_threads = malloc(sizeof(Enesim_Renderer_Thread) * _num_threads);
+	if (!_threads)
+	{
+		WRN("Not enough memory for the workers, drawing on a single thread");
+		eina_lock_take(&_jobs_lock);
+		_num_threads = 1;
+		eina_lock_release(&_jobs_lock);
+		return;
 	}
-	else
+	for (i = 0; i < _num_threads - 1; i++)
 	{
-		_sw_surface_draw_simple(r, sw_data->fill, ddata, stride, area);
+		_threads[i].cpuidx = i;
+		_threads[i].tmp = NULL;
+		_threads[i].tmp_len = 0;
+		enesim_thread_new(&_threads[i].tid, _thread_run, &_threads[i]);
+		switch (_affinity)
+		{
+			case ENESIM_THREAD_AFFINITY_PINNED:
+			enesim_thread_affinity_set(_threads[i].tid,
+					(i + 1) % _num_cpus);
+			break;
+
+			case ENESIM_THREAD_AFFINITY_CPUS:
+			enesim_thread_affinity_set(_threads[i].tid,
+					_affinity_cpus[i % _affinity_ncpus]);
+			break;
+
+			default:
+			break;
+		}
 	}
 }
-#endif
-/*============================================================================*
- *                                 Global                                     *
- *============================================================================*/
-void enesim_renderer_sw_init(void)
+
+/* Draw every job submitted so far, helping the workers. The jobs of an
+ * asynchronous draw are drawn too, so the drawing thread can call it
+ * even if it has not waited for its own draws
+ */
+static void _sw_workers_drain(void)
 {
-#ifdef BUILD_MULTI_CORE
-	_num_cpus = eina_cpu_count();
-#endif
+	eina_lock_take(&_jobs_lock);
+	while (_jobs_active)
+	{
+		if (_jobs)
+			_sw_job_run(EINA_INLIST_CONTAINER_GET(_jobs,
+					Enesim_Renderer_Sw_Job), NULL);
+		else
+			eina_condition_wait(&_done_cond);
+	}
+	eina_lock_release(&_jobs_lock);
 }
 
-void enesim_renderer_sw_shutdown(void)
+/* The jobs still queued are kept, the next workers or the threads
+ * waiting for them will draw them
+ */
+static void _sw_workers_stop(void)
 {
-#ifdef BUILD_MULTI_CORE
-#endif
+	unsigned int i;
+
+	/* first mark all the threads to leave and wake them up */
+	eina_lock_take(&_jobs_lock);
+	_threads_done = EINA_TRUE;
+	eina_condition_broadcast(&_jobs_cond);
+	eina_lock_release(&_jobs_lock);
+	/* destroy the threads */
+	for (i = 0; i < _num_threads - 1; i++)
+	{
+		enesim_thread_free(_threads[i].tid);
+		free(_threads[i].tmp);
+	}
+	free(_threads);
+	_threads = NULL;
 }
 
-void enesim_renderer_sw_hints_get(Enesim_Renderer *r, Enesim_Rop rop, Enesim_Renderer_Sw_Hint *hints)
+static void _sw_threads_init(void)
 {
-	Enesim_Renderer_Class *klass;
+	_num_cpus = eina_cpu_count();
+	if (!_num_cpus) _num_cpus = 1;
+	_num_threads = _num_cpus;
+
+	eina_lock_new(&_pool_lock);
+	eina_lock_new(&_jobs_lock);
+	eina_condition_new(&_jobs_cond, &_jobs_lock);
+	eina_condition_new(&_done_cond, &_jobs_lock);
+	_sw_workers_start();
+}
 
-	klass = ENESIM_RENDERER_CLASS_GET(r);
-	if (!hints) return;
-	if (klass->sw_hints_get)
-		klass->sw_hints_get(r, rop, hints);
-	else
-		*hints = 0;
+static void _sw_threads_shutdown(void)
+{
+	_sw_workers_stop();
+	free(_affinity_cpus);
+	_affinity_cpus = NULL;
+	_affinity_ncpus = 0;
+	_affinity = ENESIM_THREAD_AFFINITY_PINNED;
+
+	eina_condition_free(&_done_cond);
+	eina_condition_free(&_jobs_cond);
+	eina_lock_free(&_jobs_lock);
+	eina_lock_free(&_pool_lock);
 }
+#endif
 
-void enesim_renderer_sw_draw_area(Enesim_Renderer *r, Enesim_Surface *s,
-		Enesim_Rop rop, Eina_Rectangle *area, int x, int y)
+/* Clip the area to draw against the renderer bounds, clearing the part of
+ * the area that is not going to be drawn in case of a fill. Returns
+ * EINA_TRUE if there is something to draw on the returned sw area
+ */
+static Eina_Bool _sw_area_setup(Enesim_Renderer *r, Enesim_Rop rop,
+		uint8_t *ddata, size_t stride, size_t bpp,
+		Eina_Rectangle *area, int x, int y,
+		Enesim_Renderer_Sw_Area *sw_area)
 {
-	Enesim_Format dfmt;
+	Enesim_Renderer_Sw_Data *sw_data;
 	Eina_Rectangle final;
-	Eina_Bool visible;
 	Eina_Bool intersect;
-	uint8_t *ddata;
-	size_t stride;
-	size_t bpp;
-#ifdef BUILD_MULTI_CORE
-	Enesim_Renderer_Sw_Data *sw_data;
-#endif
-
-	/* get the destination pointer */
-	_sw_surface_setup(s, &dfmt, (void **)&ddata, &stride, &bpp);
 
+	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
 	/* be sure to clip the area to the renderer bounds */
 	final = r->current_destination_bounds;
 	/* final translation */
@@ -389,13 +999,16 @@ void enesim_renderer_sw_draw_area(Enesim_Renderer *r, Enesim_Surface *s,
 
 	intersect = eina_rectangle_intersection(&final, area);
 	/* when filling be sure to clear the the area that we dont draw */
-	if (rop == ENESIM_ROP_FILL)
+	if (_sw_rop_clears(rop))
 	{
 		/* just memset the whole area */
 		if (!intersect)
 		{
-			_sw_clear(ddata, stride, bpp, area);
-			return;
+			Eina_Rectangle clear = *area;
+
+			_sw_clear(sw_data->stream_span, ddata, stride, bpp,
+					&clear);
+			return EINA_FALSE;
 		}
 		/* clear the difference rectangle */
 		else
@@ -408,47 +1021,267 @@ void enesim_renderer_sw_draw_area(Enesim_Renderer *r, Enesim_Surface *s,
 			{
 				if (!eina_rectangle_is_valid(&subs[i]))
 					continue;
-				_sw_clear(ddata, stride, bpp, &subs[i]);
+				_sw_clear(sw_data->stream_span, ddata, stride,
+						bpp, &subs[i]);
 			}
 		}
 	}
 
-	visible = enesim_renderer_visibility_get(r);
-	if (!visible)
-		return;
 	if (!intersect || !eina_rectangle_is_valid(&final))
-		return;
+		return EINA_FALSE;
 
-	ddata = ddata + (final.y * stride) + (final.x * bpp);
+	sw_area->dst = ddata + (final.y * stride) + (final.x * bpp);
 	/* we know have the final area on surface coordinates
 	 * add again the offset because the draw functions use
 	 * the area on the renderer coordinate space
 	 */
 	final.x -= x;
 	final.y -= y;
+	sw_area->area = final;
+	return EINA_TRUE;
+}
+
+static void _sw_draw(Enesim_Renderer *r, Enesim_Renderer_Sw_Area *areas,
+		unsigned int nareas, size_t stride, Enesim_Format dfmt)
+{
 #ifdef BUILD_MULTI_CORE
-	/* create the threads in case those are not created yet */
-	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
-	if (!sw_data->threads)
+	unsigned int i, j;
+
+	/* the bands of a job are drawn in any order, so in case some areas
+	 * overlap draw them one after the other as the order matters
+	 */
+	for (i = 0; i < nareas; i++)
 	{
-		unsigned int i;
+		for (j = i + 1; j < nareas; j++)
+		{
+			Eina_Rectangle *a = &areas[i].area;
+			Eina_Rectangle *b = &areas[j].area;
 
-		sw_data->threads = malloc(sizeof(Enesim_Renderer_Thread) * _num_cpus);
+			if (eina_rectangles_intersect(a, b))
+				goto overlap;
+		}
+	}
+	_sw_draw_threaded(r, areas, nareas, stride, dfmt);
+	return;
+overlap:
+	for (i = 0; i < nareas; i++)
+		_sw_draw_threaded(r, &areas[i], 1, stride, dfmt);
+#else
+	_sw_draw_no_threaded(r, areas, nareas, stride, dfmt);
+#endif
+}
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_renderer_sw_init(void)
+{
+#ifdef BUILD_MULTI_CORE
+	_sw_threads_init();
+#endif
+}
 
-		enesim_barrier_new(&sw_data->start, _num_cpus + 1);
-		enesim_barrier_new(&sw_data->end, _num_cpus + 1);
-		for (i = 0; i < _num_cpus; i++)
+void enesim_renderer_sw_shutdown(void)
+{
+#ifdef BUILD_MULTI_CORE
+	_sw_threads_shutdown();
+#endif
+}
+
+/* The workers are replaced once every pending draw is done, the draws
+ * submitted meanwhile are kept queued for the new workers
+ */
+void enesim_renderer_sw_threads_set(unsigned int count EINA_UNUSED)
+{
+#ifdef BUILD_MULTI_CORE
+	if (!count) count = _num_cpus;
+	eina_lock_take(&_pool_lock);
+	if (count != _num_threads)
+	{
+		_sw_workers_drain();
+		_sw_workers_stop();
+		eina_lock_take(&_jobs_lock);
+		_num_threads = count;
+		eina_lock_release(&_jobs_lock);
+		_sw_workers_start();
+	}
+	eina_lock_release(&_pool_lock);
+#endif
+}
+
+unsigned int enesim_renderer_sw_threads_get(void)
+{
+#ifdef BUILD_MULTI_CORE
+	return _sw_threads_get();
+#else
+	return 1;
+#endif
+}
+
+Eina_Bool enesim_renderer_sw_threads_affinity_set(Enesim_Thread_Affinity affinity,
+		const unsigned int *cpus EINA_UNUSED,
+		unsigned int count EINA_UNUSED)
+{
+#ifdef BUILD_MULTI_CORE
+	unsigned int *affinity_cpus = NULL;
+
+	if (affinity == ENESIM_THREAD_AFFINITY_CPUS)
+	{
+		affinity_cpus = malloc(sizeof(unsigned int) * count);
+		if (!affinity_cpus)
 		{
-			sw_data->threads[i].cpuidx = i;
-			sw_data->threads[i].done = EINA_FALSE;
-			sw_data->threads[i].sw_data = sw_data;
-			enesim_thread_new(&sw_data->threads[i].tid, _thread_run, (void *)&sw_data->threads[i]);
-			enesim_thread_affinity_set(sw_data->threads[i].tid, i);
+			WRN("Not enough memory for the cpus");
+			return EINA_FALSE;
 		}
+		memcpy(affinity_cpus, cpus, sizeof(unsigned int) * count);
+	}
+	else
+	{
+		count = 0;
+	}
+	/* the affinity is set when the workers are created */
+	eina_lock_take(&_pool_lock);
+	_sw_workers_drain();
+	_sw_workers_stop();
+	free(_affinity_cpus);
+	_affinity_cpus = affinity_cpus;
+	_affinity_ncpus = count;
+	_affinity = affinity;
+	_sw_workers_start();
+	eina_lock_release(&_pool_lock);
+#else
+	_affinity = affinity;
+#endif
+	return EINA_TRUE;
+}
+
+Enesim_Thread_Affinity enesim_renderer_sw_threads_affinity_get(void)
+{
+	return _affinity;
+}
+
+void enesim_renderer_sw_hints_get(Enesim_Renderer *r, Enesim_Rop rop, Enesim_Renderer_Sw_Hint *hints)
+{
+	Enesim_Renderer_Class *klass;
+
+	klass = ENESIM_RENDERER_CLASS_GET(r);
+	if (!hints) return;
+	if (klass->sw_hints_get)
+		klass->sw_hints_get(r, rop, hints);
+	else
+		*hints = 0;
+}
+
+void enesim_renderer_sw_draw_area(Enesim_Renderer *r, Enesim_Surface *s,
+		Enesim_Rop rop, Eina_Rectangle *area, int x, int y)
+{
+	Enesim_Renderer_Sw_Area sw_area;
+	Enesim_Format dfmt;
+	uint8_t *ddata;
+	size_t stride;
+	size_t bpp;
+
+	/* get the destination pointer */
+	_sw_surface_setup(s, &dfmt, (void **)&ddata, &stride, &bpp);
+	if (!_sw_area_setup(r, rop, ddata, stride, bpp, area, x, y, &sw_area))
+		return;
+	if (!enesim_renderer_visibility_get(r))
+		return;
+	_sw_draw(r, &sw_area, 1, stride, dfmt);
+}
+
+/* Draw every clip that intersects with the area in a single pass, that way
+ * the pool only needs to be synchronized once for the whole list
+ */
+void enesim_renderer_sw_draw_list(Enesim_Renderer *r, Enesim_Surface *s,
+		Enesim_Rop rop, Eina_Rectangle *area, Eina_List *clips,
+		int x, int y)
+{
+	Enesim_Renderer_Sw_Area *sw_areas;
+	Enesim_Format dfmt;
+	Eina_Rectangle *clip;
+	Eina_List *l;
+	unsigned int nareas = 0;
+	uint8_t *ddata;
+	size_t stride;
+	size_t bpp;
+
+	if (!clips)
+		return;
+	sw_areas = malloc(sizeof(Enesim_Renderer_Sw_Area) * eina_list_count(clips));
+	if (!sw_areas)
+	{
+		WRN("Not enough memory to draw '%s'", r->name);
+		return;
+	}
+	/* get the destination pointer */
+	_sw_surface_setup(s, &dfmt, (void **)&ddata, &stride, &bpp);
+	EINA_LIST_FOREACH(clips, l, clip)
+	{
+		Eina_Rectangle final;
+
+		final = *clip;
+		if (!eina_rectangle_intersection(&final, area))
+			continue;
+		if (!_sw_area_setup(r, rop, ddata, stride, bpp, &final, x, y,
+				&sw_areas[nareas]))
+			continue;
+		nareas++;
 	}
-	_sw_draw_threaded(r, &final, ddata, stride, dfmt);
+	if (nareas && enesim_renderer_visibility_get(r))
+		_sw_draw(r, sw_areas, nareas, stride, dfmt);
+	free(sw_areas);
+}
+
+/* Same as enesim_renderer_sw_draw_area() but the drawing is done on the
+ * workers. The @a job is set to NULL in case there is nothing left to wait
+ * for. Returns EINA_FALSE if the drawing can not be started
+ */
+Eina_Bool enesim_renderer_sw_draw_area_async(Enesim_Renderer *r,
+		Enesim_Surface *s, Enesim_Rop rop, Eina_Rectangle *area,
+		int x, int y, Enesim_Renderer_Sw_Job **job)
+{
+	Enesim_Renderer_Sw_Area sw_area;
+	Enesim_Format dfmt;
+	uint8_t *ddata;
+	size_t stride;
+	size_t bpp;
+
+	*job = NULL;
+	/* get the destination pointer */
+	_sw_surface_setup(s, &dfmt, (void **)&ddata, &stride, &bpp);
+	if (!_sw_area_setup(r, rop, ddata, stride, bpp, area, x, y, &sw_area))
+		return EINA_TRUE;
+	if (!enesim_renderer_visibility_get(r))
+		return EINA_TRUE;
+#ifdef BUILD_MULTI_CORE
+	*job = _sw_draw_threaded_async(r, &sw_area, stride);
+	return *job != NULL;
 #else
-	_sw_draw_no_threaded(r, &final, ddata, stride, dfmt);
+	_sw_draw_no_threaded(r, &sw_area, 1, stride, dfmt);
+	return EINA_TRUE;
+#endif
+}
+
+Eina_Bool enesim_renderer_sw_job_is_done(Enesim_Renderer_Sw_Job *job EINA_UNUSED)
+{
+#ifdef BUILD_MULTI_CORE
+	Eina_Bool ret;
+
+	eina_lock_take(&_jobs_lock);
+	ret = !job->pending && !job->running;
+	eina_lock_release(&_jobs_lock);
+	return ret;
+#else
+	return EINA_TRUE;
+#endif
+}
+
+/* Waits for the job to finish and frees it */
+void enesim_renderer_sw_job_wait(Enesim_Renderer_Sw_Job *job EINA_UNUSED)
+{
+#ifdef BUILD_MULTI_CORE
+	_sw_job_wait(job);
+	free(job);
 #endif
 }
 
@@ -458,16 +1291,22 @@ Eina_Bool enesim_renderer_sw_setup(Enesim_Renderer *r,
 	Enesim_Renderer_Class *klass;
 	Enesim_Renderer_Sw_Fill fill = NULL;
 	Enesim_Compositor_Span span = NULL;
+	Enesim_Compositor_Span draw_span;
+	Enesim_Renderer_Sw_Runs runs = NULL;
 	Enesim_Renderer_Sw_Data *sw_data;
 	Enesim_Renderer_Sw_Hint hints;
 	Enesim_Renderer *mask;
 	Enesim_Color color;
+	Enesim_Format dfmt;
+	Enesim_Rop frop;
+	Enesim_Rop drop;
 	const char *name;
 
 	klass = ENESIM_RENDERER_CLASS_GET(r);
 	name = enesim_renderer_name_get(r);
 	mask = enesim_renderer_mask_get(r);
 	color = enesim_renderer_color_get(r);
+	dfmt = enesim_surface_format_get(s);
 
 	/* do the setup on the mask */
 	/* FIXME later this should be merged on the common renderer code */
@@ -483,8 +1322,19 @@ Eina_Bool enesim_renderer_sw_setup(Enesim_Renderer *r,
 			return EINA_FALSE;
 		}
 	}
+	/* blending opaque pixels is the same as filling them */
+	if (rop == ENESIM_ROP_BLEND && !mask && (color >> 24) == 0xff &&
+			enesim_renderer_alpha_hints_get(r) ==
+			ENESIM_ALPHA_HINT_OPAQUE)
+		rop = ENESIM_ROP_FILL;
+	frop = drop = rop;
+	/* the renderers only fill argb8888 spans, the compositor does the
+	 * rest of the operations and the conversion to other formats
+	 */
+	if (!_sw_rop_is_native(rop) || dfmt != ENESIM_FORMAT_ARGB8888)
+		frop = ENESIM_ROP_FILL;
 	if (!klass->sw_setup) return EINA_FALSE;
-	if (!klass->sw_setup(r, s, rop, &fill, error))
+	if (!klass->sw_setup(r, s, frop, &fill, error))
 	{
 		WRN("Setup callback on '%s' failed", name);
 		return EINA_FALSE;
@@ -504,12 +1354,49 @@ Eina_Bool enesim_renderer_sw_setup(Enesim_Renderer *r,
 		enesim_renderer_backend_data_set(r, ENESIM_BACKEND_SOFTWARE, sw_data);	
 	}
 
-	enesim_renderer_sw_hints_get(r, rop, &hints);
-	if (_is_sw_draw_composed(&color, &rop, hints))
+	enesim_renderer_sw_hints_get(r, frop, &hints);
+	/* the compositor is the one that does the operation */
+	if (frop != rop)
+		hints &= ~ENESIM_RENDERER_SW_HINT_ROP;
+	/* the runs tell what the fill writes, a fill that does another
+	 * operation by itself does not write the run color
+	 */
+	if ((hints & ENESIM_RENDERER_SW_HINT_RUNS) &&
+			(frop == ENESIM_ROP_FILL ||
+			!(hints & ENESIM_RENDERER_SW_HINT_ROP)))
+		runs = klass->sw_runs;
+	sw_data->mask = NULL;
+	sw_data->color_span = NULL;
+	if (mask && !(hints & ENESIM_RENDERER_SW_HINT_MASK))
 	{
-		Enesim_Format dfmt;
+		Enesim_Format tfmt = ENESIM_FORMAT_ARGB8888;
 
-		dfmt = enesim_surface_format_get(s);
+		/* the renderer can not draw the mask by itself, so compose
+		 * the filled span with the mask span
+		 */
+		if (hints & ENESIM_RENDERER_SW_HINT_COLORIZE)
+			color = ENESIM_COLOR_FULL;
+		if (color != ENESIM_COLOR_FULL)
+		{
+			sw_data->color_span = enesim_compositor_span_get(
+					ENESIM_ROP_FILL, &tfmt,
+					ENESIM_FORMAT_ARGB8888, color,
+					ENESIM_FORMAT_NONE);
+		}
+		span = enesim_compositor_span_get(rop, &dfmt, ENESIM_FORMAT_ARGB8888,
+				ENESIM_COLOR_FULL, ENESIM_FORMAT_ARGB8888);
+		if (!span || (color != ENESIM_COLOR_FULL && !sw_data->color_span))
+		{
+			WRN("No suitable span compositor to render %p with rop "
+					"%d, color %08x and a mask", r, rop, color);
+			return EINA_FALSE;
+		}
+		sw_data->mask = mask;
+	}
+	/* a destination that is not argb8888 is always composed */
+	else if (_is_sw_draw_composed(&color, &rop, hints) ||
+			dfmt != ENESIM_FORMAT_ARGB8888)
+	{
 		span = enesim_compositor_span_get(rop, &dfmt, ENESIM_FORMAT_ARGB8888,
 				color, ENESIM_FORMAT_NONE);
 		if (!span)
@@ -520,9 +1407,100 @@ Eina_Bool enesim_renderer_sw_setup(Enesim_Renderer *r,
 		}
 	}
 
+	/* the mask spans do not use the runs */
+	_sw_solid_setup(&sw_data->solid, span && !sw_data->mask ? runs : NULL,
+			rop, dfmt, color);
+	/* other renderers draw this one on argb8888 spans no matter the
+	 * format of the surface
+	 */
+	draw_span = span;
+	sw_data->draw_solid = sw_data->solid;
+	if (dfmt != ENESIM_FORMAT_ARGB8888)
+	{
+		Enesim_Format tfmt = ENESIM_FORMAT_ARGB8888;
+
+		color = enesim_renderer_color_get(r);
+		draw_span = NULL;
+		if (sw_data->mask)
+		{
+			draw_span = enesim_compositor_span_get(drop, &tfmt,
+					ENESIM_FORMAT_ARGB8888,
+					ENESIM_COLOR_FULL,
+					ENESIM_FORMAT_ARGB8888);
+			if (!draw_span)
+			{
+				WRN("No suitable span compositor to render %p "
+						"with rop %d and a mask", r,
+						drop);
+				return EINA_FALSE;
+			}
+		}
+		else if (_is_sw_draw_composed(&color, &drop, hints))
+		{
+			draw_span = enesim_compositor_span_get(drop, &tfmt,
+					ENESIM_FORMAT_ARGB8888, color,
+					ENESIM_FORMAT_NONE);
+			if (!draw_span)
+			{
+				WRN("No suitable span compositor to render %p "
+						"with rop %d and color %08x", r,
+						drop, color);
+				return EINA_FALSE;
+			}
+		}
+		_sw_solid_setup(&sw_data->draw_solid,
+				draw_span && !sw_data->mask ? runs : NULL,
+				drop, tfmt, color);
+	}
+
+	/* a destination bigger than the cache is cleared and filled with
+	 * streaming stores, in case the fill writes directly on it the solid
+	 * runs are filled with them too
+	 */
+	sw_data->stream_span = NULL;
+	if (dfmt == ENESIM_FORMAT_ARGB8888)
+	{
+		Enesim_Buffer_Sw_Data *bdata;
+		int h;
+
+		bdata = enesim_surface_backend_data_get(s);
+		enesim_surface_size_get(s, NULL, &h);
+		sw_data->stream_span = enesim_compositor_span_stream_get(dfmt,
+				ENESIM_FORMAT_NONE,
+				bdata->argb8888_pre.plane0_stride * h);
+	}
+	if (!span && runs && sw_data->stream_span)
+	{
+		sw_data->solid.runs = runs;
+		sw_data->solid.color = ENESIM_COLOR_FULL;
+		sw_data->solid.span = sw_data->stream_span;
+		sw_data->solid.opaque_span = sw_data->stream_span;
+	}
+
 	/* TODO add a real_draw function that will compose the two ... or not :) */
 	sw_data->span = span;
+	sw_data->draw_span = draw_span;
+	sw_data->span_clear = !(hints & ENESIM_RENDERER_SW_HINT_FULL_SPAN);
 	sw_data->fill = fill;
+	/* the blocks are only filled directly on the destination */
+	sw_data->fill_block = NULL;
+	if (!span && (hints & ENESIM_RENDERER_SW_HINT_BLOCK))
+		sw_data->fill_block = klass->sw_fill_block;
+	sw_data->bpp = dfmt == ENESIM_FORMAT_A8 ? 1 : 4;
+	/* compose in pieces that stay on the cache, the mask is drawn
+	 * in pieces too
+	 */
+	sw_data->chunk = 0;
+	if (span && (hints & ENESIM_RENDERER_SW_HINT_SPLIT_SPAN))
+	{
+		Enesim_Renderer_Sw_Hint mask_hints = ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
+
+		if (sw_data->mask)
+			enesim_renderer_sw_hints_get(sw_data->mask,
+					ENESIM_ROP_FILL, &mask_hints);
+		if (mask_hints & ENESIM_RENDERER_SW_HINT_SPLIT_SPAN)
+			sw_data->chunk = ENESIM_RENDERER_SW_CHUNK;
+	}
 	return EINA_TRUE;
 }
 
@@ -543,33 +1521,53 @@ void enesim_renderer_sw_cleanup(Enesim_Renderer *r, Enesim_Surface *s)
 	if (klass->sw_cleanup) klass->sw_cleanup(r, s);
 }
 
-void enesim_renderer_sw_free(Enesim_Renderer *r)
+/* Call the function for every item from 0 to count on the workers, the
+ * calling thread also processes items. Returns once every item has been
+ * processed
+ */
+void enesim_renderer_sw_parallel_run(Enesim_Renderer_Sw_Parallel_Cb cb,
+		void *data, unsigned int count)
 {
+#ifdef BUILD_MULTI_CORE
+	Enesim_Renderer_Sw_Job job;
+
+	if (!count) return;
+	job.op.span = NULL;
+	job.op.mask = NULL;
+	job.areas = NULL;
+	job.nareas = 0;
+	job.len = 0;
+	job.cb = cb;
+	job.data = data;
+	job.nslots = _sw_threads_get();
+	if (job.nslots > count)
+		job.nslots = count;
+	if (job.nslots == 1)
+	{
+		unsigned int i;
 
-	Enesim_Renderer_Sw_Data *sw_data;
-#if BUILD_MULTI_CORE
+		for (i = 0; i < count; i++)
+			cb(data, i);
+		return;
+	}
+	job.ranges = alloca(sizeof(Enesim_Renderer_Sw_Range) * job.nslots);
+
+	_sw_job_submit(&job, count);
+	_sw_job_wait(&job);
+#else
 	unsigned int i;
+
+	for (i = 0; i < count; i++)
+		cb(data, i);
 #endif
+}
+
+void enesim_renderer_sw_free(Enesim_Renderer *r)
+{
+	Enesim_Renderer_Sw_Data *sw_data;
 
 	sw_data = enesim_renderer_backend_data_get(r, ENESIM_BACKEND_SOFTWARE);
 	if (!sw_data) return;
-#if BUILD_MULTI_CORE
-	if (sw_data->threads)
-	{
-		/* first mark all the threads to leave */
-		for (i = 0; i < _num_cpus; i++)
-			sw_data->threads[i].done = EINA_TRUE;
-
-		/* now increment the barrier so the threads start again */
-		enesim_barrier_wait(&sw_data->start);
-		/* destroy the threads */
-		for (i = 0; i < _num_cpus; i++)
-			enesim_thread_free(sw_data->threads[i].tid);
-		free(sw_data->threads);
-		enesim_barrier_free(&sw_data->start);
-		enesim_barrier_free(&sw_data->end);
-	}
-#endif
 	free(sw_data);
 }
 
@@ -596,7 +1594,7 @@ void enesim_renderer_sw_draw(Enesim_Renderer *r,  int x, int y,
 				"'%s'", EINA_RECTANGLE_ARGS (&span),
 				EINA_RECTANGLE_ARGS (&rbounds),
 				r->name);
-		if (r->current_rop == ENESIM_ROP_FILL)
+		if (_sw_rop_clears(r->current_rop))
 		{
 			memset(data, 0, len * sizeof(uint32_t));
 		}
@@ -608,29 +1606,64 @@ void enesim_renderer_sw_draw(Enesim_Renderer *r,  int x, int y,
 			EINA_RECTANGLE_FORMAT, EINA_RECTANGLE_ARGS (&span),
 			r->name,  EINA_RECTANGLE_ARGS (&rbounds));
 
-	if (sw_data->span)
+	if (sw_data->draw_span)
 	{
 		Enesim_Color color;
 		uint32_t *tmp;
-		size_t bytes;
+		uint32_t *tmp_mask = NULL;
+		int chunk;
+		int off;
 
 		color = enesim_renderer_color_get(r);
-		bytes = rbounds.w * sizeof(uint32_t);
-		tmp = alloca(bytes);
+		chunk = sw_data->chunk ? (int)sw_data->chunk : rbounds.w;
+		if (chunk > rbounds.w)
+			chunk = rbounds.w;
+		tmp = alloca(chunk * sizeof(uint32_t));
+		/* the draw span takes the mask span */
+		if (sw_data->mask)
+			tmp_mask = alloca(chunk * sizeof(uint32_t));
+
+		for (off = 0; off < rbounds.w; off += chunk)
+		{
+			int w = rbounds.w - off;
 
-		/* We dont need to zero the buffer given that a fill will
-		 * draw every pixel in case the span is inside the bounds
-		 */
-		sw_data->fill(r, rbounds.x, rbounds.y, rbounds.w, tmp);
-		/* compose the filled and the destination spans */
-		sw_data->span(data + left, rbounds.w, tmp, color, NULL);
+			if (w > chunk)
+				w = chunk;
+			if (sw_data->draw_solid.runs)
+			{
+				_sw_span_runs_draw(r, sw_data->fill,
+						sw_data->draw_span,
+						&sw_data->draw_solid, EINA_FALSE,
+						color, rbounds.x + off, rbounds.y,
+						w, (uint8_t *)(data + left + off),
+						sizeof(uint32_t), (uint8_t *)tmp);
+				continue;
+			}
+			/* We dont need to zero the buffer given that a fill will
+			 * draw every pixel in case the span is inside the bounds
+			 */
+			sw_data->fill(r, rbounds.x + off, rbounds.y, w, tmp);
+			if (tmp_mask)
+			{
+				/* the pixel mask spans do not handle the color */
+				if (sw_data->color_span)
+					sw_data->color_span(tmp, w, tmp, color,
+							NULL);
+				enesim_renderer_sw_draw(sw_data->mask,
+						rbounds.x + off, rbounds.y, w,
+						tmp_mask);
+			}
+			/* compose the filled and the destination spans */
+			sw_data->draw_span(data + left + off, w, tmp, color,
+					tmp_mask);
+		}
 	}
 	else
 	{
 		sw_data->fill(r, rbounds.x, rbounds.y, rbounds.w, data + left);
 	}
 
-	if (r->current_rop == ENESIM_ROP_FILL)
+	if (_sw_rop_clears(r->current_rop))
 	{
 		unsigned int right;
 
@@ -19,7 +19,6 @@
 #define ENESIM_RENDERER_SW_PRIVATE_H_
 
 #include "enesim_thread_private.h"
-#include "enesim_barrier_private.h"
 
 /**
  * The fill function that every software based renderer should implement
@@ -33,7 +32,54 @@
  */
 typedef void (*Enesim_Renderer_Sw_Fill)(Enesim_Renderer *r,
 		int x, int y, int len, void *dst);
+/**
+ * The function a software based renderer can implement to tell where the
+ * fill writes a single color
+ * @param r The renderer to draw
+ * @param x The x coordinate of the span
+ * @param y The y coordinate of the span
+ * @param len The length of the span, always greater than zero
+ * @param color The color of the run in case it is solid
+ * @return The length of the run that starts at x, between 1 and len for a
+ * run where the fill writes @a color on every pixel, between -1 and -len for
+ * a run of pixels that must be filled
+ */
+typedef int (*Enesim_Renderer_Sw_Runs)(Enesim_Renderer *r,
+		int x, int y, int len, Enesim_Color *color);
+/**
+ * The function a software based renderer can implement to fill a block of
+ * rows at once, with the same pixels the fill writes on every row
+ * @param r The renderer to draw
+ * @param x The x coordinate of the block
+ * @param y The y coordinate of the first row of the block
+ * @param w The width of the block, always greater than zero
+ * @param h The number of rows of the block, always greater than zero
+ * @param dst The destination buffer of the first row
+ * @param stride The number of bytes between two rows of the destination
+ */
+typedef void (*Enesim_Renderer_Sw_Fill_Block)(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *dst, size_t stride);
 typedef struct _Enesim_Renderer_Sw_Data Enesim_Renderer_Sw_Data;
+typedef struct _Enesim_Renderer_Sw_Job Enesim_Renderer_Sw_Job;
+
+/**
+ * The function called for every item of a parallel run
+ * @param data The user provided data
+ * @param idx The index of the item to process
+ */
+typedef void (*Enesim_Renderer_Sw_Parallel_Cb)(void *data, unsigned int idx);
+
+/* The spans to compose the solid runs of a fill */
+typedef struct _Enesim_Renderer_Sw_Solid
+{
+	/* NULL in case the runs are not used */
+	Enesim_Renderer_Sw_Runs runs;
+	/* the color the span multiplies the filled pixels with */
+	Enesim_Color color;
+	/* for the translucent and the opaque colors */
+	Enesim_Compositor_Span span;
+	Enesim_Compositor_Span opaque_span;
+} Enesim_Renderer_Sw_Solid;
 
 #if BUILD_THREAD
 typedef struct _Enesim_Renderer_Thread_Operation
@@ -41,20 +87,30 @@ typedef struct _Enesim_Renderer_Thread_Operation
 	/* common attributes */
 	Enesim_Renderer *renderer;
 	Enesim_Renderer *mask;
-	Enesim_Renderer_Sw_Fill mask_fill;
-	uint8_t * dst;
+	Enesim_Renderer_Sw_Fill fill;
+	Enesim_Renderer_Sw_Fill_Block fill_block;
 	size_t stride;
-	Eina_Rectangle area;
 	/* in case the renderer needs to use a composer */
 	Enesim_Compositor_Span span;
+	/* in case the color must be applied before the mask */
+	Enesim_Compositor_Span color_span;
+	/* in case the fill does not write every pixel of the span */
+	Eina_Bool span_clear;
+	/* the pixels to fill and compose at once, 0 for the whole span */
+	unsigned int chunk;
+	/* the bytes per pixel of the destination */
+	size_t bpp;
+	/* in case the fill gives runs of a solid color */
+	Enesim_Renderer_Sw_Solid solid;
 } Enesim_Renderer_Thread_Operation;
 
 typedef struct _Enesim_Renderer_Thread
 {
 	int cpuidx;
 	Enesim_Thread tid;
-	Eina_Bool done;
-	Enesim_Renderer_Sw_Data *sw_data;
+	/* the scratch span, it only grows */
+	uint8_t *tmp;
+	size_t tmp_len;
 } Enesim_Renderer_Thread;
 #endif
 
@@ -63,30 +119,62 @@ typedef enum _Enesim_Renderer_Sw_Hint
 	ENESIM_RENDERER_SW_HINT_COLORIZE 		= (1 << 0), /* Can draw directly using the color property */
 	ENESIM_RENDERER_SW_HINT_ROP 		= (1 << 1), /* Can draw directly using the raster operation */
 	ENESIM_RENDERER_SW_HINT_MASK 		= (1 << 2), /* Can draw directly using the mask renderer */
+	ENESIM_RENDERER_SW_HINT_FULL_SPAN 	= (1 << 3), /* The fill writes every pixel of the span */
+	ENESIM_RENDERER_SW_HINT_SPLIT_SPAN 	= (1 << 4), /* The span can be filled in pieces at no extra cost */
+	ENESIM_RENDERER_SW_HINT_RUNS 		= (1 << 5), /* The sw_runs function gives the solid runs of the fill */
+	ENESIM_RENDERER_SW_HINT_BLOCK 		= (1 << 6), /* The sw_fill_block function fills blocks of rows */
 } Enesim_Renderer_Sw_Hint;
 
 struct _Enesim_Renderer_Sw_Data
 {
-#if BUILD_THREAD
-	/* the threaded information */
-	Enesim_Renderer_Thread *threads;
-	Enesim_Renderer_Thread_Operation op;
-	Enesim_Barrier start;
-	Enesim_Barrier end;
-#endif
 	/* TODO for later we might need a pointer to the function that calls
 	 *  the fill only or both, to avoid the if
 	 */
 	Enesim_Renderer_Sw_Fill fill;
+	/* in case the fill writes directly on the destination rows */
+	Enesim_Renderer_Sw_Fill_Block fill_block;
 	Enesim_Compositor_Span span;
+	/* the span to use when drawing on argb8888 spans */
+	Enesim_Compositor_Span draw_span;
+	/* in case the renderer can not draw the mask by itself */
+	Enesim_Renderer *mask;
+	Enesim_Compositor_Span color_span;
+	/* the span must be cleared before the fill */
+	Eina_Bool span_clear;
+	/* the pixels to fill and compose at once, 0 for the whole span */
+	unsigned int chunk;
+	/* the bytes per pixel of the destination */
+	size_t bpp;
+	/* in case the fill gives runs of a solid color, for the span and
+	 * for the draw_span
+	 */
+	Enesim_Renderer_Sw_Solid solid;
+	Enesim_Renderer_Sw_Solid draw_solid;
+	/* to fill a destination bigger than the cache, NULL otherwise */
+	Enesim_Compositor_Span stream_span;
 };
 
 void enesim_renderer_sw_hints_get(Enesim_Renderer *r, Enesim_Rop rop, Enesim_Renderer_Sw_Hint *hints);
 void enesim_renderer_sw_draw(Enesim_Renderer *r, int x, int y, int len, uint32_t *data);
 void enesim_renderer_sw_init(void);
 void enesim_renderer_sw_shutdown(void);
+void enesim_renderer_sw_threads_set(unsigned int count);
+unsigned int enesim_renderer_sw_threads_get(void);
+Eina_Bool enesim_renderer_sw_threads_affinity_set(Enesim_Thread_Affinity affinity,
+		const unsigned int *cpus, unsigned int count);
+Enesim_Thread_Affinity enesim_renderer_sw_threads_affinity_get(void);
 void enesim_renderer_sw_draw_area(Enesim_Renderer *r, Enesim_Surface *s,
 		Enesim_Rop rop, Eina_Rectangle *area, int x, int y);
+void enesim_renderer_sw_draw_list(Enesim_Renderer *r, Enesim_Surface *s,
+		Enesim_Rop rop, Eina_Rectangle *area, Eina_List *clips,
+		int x, int y);
+Eina_Bool enesim_renderer_sw_draw_area_async(Enesim_Renderer *r,
+		Enesim_Surface *s, Enesim_Rop rop, Eina_Rectangle *area,
+		int x, int y, Enesim_Renderer_Sw_Job **job);
+Eina_Bool enesim_renderer_sw_job_is_done(Enesim_Renderer_Sw_Job *job);
+void enesim_renderer_sw_job_wait(Enesim_Renderer_Sw_Job *job);
+void enesim_renderer_sw_parallel_run(Enesim_Renderer_Sw_Parallel_Cb cb,
+		void *data, unsigned int count);
 void enesim_renderer_sw_free(Enesim_Renderer *r);
 
 Eina_Bool enesim_renderer_sw_setup(Enesim_Renderer *r, Enesim_Surface *s, Enesim_Rop rop, Enesim_Log **error);
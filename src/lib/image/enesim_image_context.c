@@ -35,25 +35,45 @@
 # define pipe_write(fd, buffer, size) send((fd), (char *)(buffer), size, 0)
 # define pipe_read(fd, buffer, size)  recv((fd), (char *)(buffer), size, 0)
 # define pipe_close(fd)               closesocket(fd)
-# define ENESIM_IMAGE_THREAD_CREATE(x, f, d) x = CreateThread(NULL, 0, f, d, 0, NULL);
+# define ENESIM_IMAGE_THREAD_CREATE(x, f, d) ((x = CreateThread(NULL, 0, f, d, 0, NULL)) != NULL)
+# define ENESIM_IMAGE_THREAD_JOIN(x) WaitForSingleObject(x, INFINITE); CloseHandle(x);
 #else
 # define pipe_write(fd, buffer, size) write((fd), buffer, size)
 # define pipe_read(fd, buffer, size)  read((fd), buffer, size)
 # define pipe_close(fd)               close(fd)
-# define ENESIM_IMAGE_THREAD_CREATE(x, f, d) pthread_create(&(x), NULL, (void *)f, d)
+# define ENESIM_IMAGE_THREAD_CREATE(x, f, d) (pthread_create(&(x), NULL, (void *)f, d) == 0)
+# define ENESIM_IMAGE_THREAD_JOIN(x) pthread_join(x, NULL);
 #endif /* ! _WIN32 */
 
 #define ENESIM_LOG_DEFAULT enesim_log_image
 
+/* The priority of a job in case none is set */
+#define ENESIM_IMAGE_JOB_PRIORITY_DEFAULT ENESIM_PRIORITY_SECONDARY
+
+#ifdef _WIN32
+typedef HANDLE Enesim_Image_Thread;
+#else
+typedef pthread_t Enesim_Image_Thread;
+#endif
+
 struct _Enesim_Image_Context
 {
 	/* the communication between the main thread and the async ones */
 	int fifo[2];
-#ifdef _WIN32
-	HANDLE tid;
-#else
-	pthread_t tid;
-#endif
+	/* the pool of threads, created on demand up to the maximum */
+	Enesim_Image_Thread *threads;
+	unsigned int nthreads;
+	unsigned int max;
+	/* the number of threads waiting for a job */
+	unsigned int idle;
+	/* the number of jobs being loaded or saved */
+	unsigned int running;
+	/* the jobs not started yet, sorted by priority */
+	Eina_Inlist *jobs;
+	unsigned int queued;
+	Eina_Lock lock;
+	Eina_Condition cond;
+	Eina_Bool done;
 };
 
 typedef enum _Enesim_Image_Job_Type
@@ -63,8 +83,16 @@ typedef enum _Enesim_Image_Job_Type
 	ENESIM_IMAGE_JOB_TYPES,
 } Enesim_Image_Job_Type;
 
-typedef struct _Enesim_Image_Job
+typedef enum _Enesim_Image_Job_State
 {
+	ENESIM_IMAGE_JOB_QUEUED,
+	ENESIM_IMAGE_JOB_RUNNING,
+	ENESIM_IMAGE_JOB_FINISHED,
+} Enesim_Image_Job_State;
+
+struct _Enesim_Image_Job
+{
+	EINA_INLIST;
 	Enesim_Image_Context *thiz;
 	Enesim_Image_Provider *prov;
 	Enesim_Stream *data;
@@ -72,6 +100,8 @@ typedef struct _Enesim_Image_Job
 	void *user_data;
 	Eina_Error err;
 	Enesim_Image_Job_Type type;
+	Enesim_Image_Job_State state;
+	Enesim_Priority priority;
 	char *options;
 
 	union {
@@ -83,11 +113,41 @@ typedef struct _Enesim_Image_Job
 			Enesim_Buffer *b;
 		} save;
 	} op;
-} Enesim_Image_Job;
+};
+
+static void _job_free(Enesim_Image_Job *j)
+{
+	if (j->options)
+		free(j->options);
+	free(j);
+}
+
+/* Must be called with the lock taken */
+static void _job_enqueue(Enesim_Image_Context *thiz, Enesim_Image_Job *j)
+{
+	Enesim_Image_Job *after = NULL;
+	Enesim_Image_Job *l;
+
+	/* keep the order of the jobs with the same priority */
+	EINA_INLIST_FOREACH(thiz->jobs, l)
+	{
+		if (l->priority < j->priority)
+			break;
+		after = l;
+	}
+	if (after)
+		thiz->jobs = eina_inlist_append_relative(thiz->jobs,
+				EINA_INLIST_GET(j), EINA_INLIST_GET(after));
+	else
+		thiz->jobs = eina_inlist_prepend(thiz->jobs, EINA_INLIST_GET(j));
+}
 
 /*----------------------------------------------------------------------------*
  *                        Thread related functions                            *
  *----------------------------------------------------------------------------*/
+/* The write might block if the main thread is not dispatching, so it must
+ * be called without the lock taken
+ */
 static int _thread_finish(Enesim_Image_Job *j)
 {
 	int ret;
@@ -96,16 +156,51 @@ static int _thread_finish(Enesim_Image_Job *j)
 }
 
 #ifdef _WIN32
-static DWORD WINAPI _thread_load(LPVOID data)
+static DWORD WINAPI _thread_run(LPVOID data)
 #else
-static void * _thread_load(void *data)
+static void * _thread_run(void *data)
 #endif
 {
-	Enesim_Image_Job *j = data;
+	Enesim_Image_Context *thiz = data;
 
-	enesim_image_provider_load(j->prov, j->data, &j->op.load.b,
-		j->op.load.pool, j->options, &j->err);
-	_thread_finish(j);
+	eina_lock_take(&thiz->lock);
+	while (!thiz->done)
+	{
+		Enesim_Image_Job *j;
+
+		if (!thiz->jobs || thiz->running >= thiz->max)
+		{
+			thiz->idle++;
+			eina_condition_wait(&thiz->cond);
+			thiz->idle--;
+			continue;
+		}
+		j = EINA_INLIST_CONTAINER_GET(thiz->jobs, Enesim_Image_Job);
+		thiz->jobs = eina_inlist_remove(thiz->jobs, EINA_INLIST_GET(j));
+		thiz->queued--;
+		thiz->running++;
+		j->state = ENESIM_IMAGE_JOB_RUNNING;
+		eina_lock_release(&thiz->lock);
+
+		if (j->type == ENESIM_IMAGE_LOAD)
+			enesim_image_provider_load(j->prov, j->data,
+					&j->op.load.b, j->op.load.pool,
+					j->options, &j->err);
+		else
+			enesim_image_provider_save(j->prov, j->data,
+					j->op.save.b, j->options, &j->err);
+
+		eina_lock_take(&thiz->lock);
+		j->state = ENESIM_IMAGE_JOB_FINISHED;
+		thiz->running--;
+		/* in case some thread is waiting for the limit */
+		if (thiz->jobs)
+			eina_condition_signal(&thiz->cond);
+		eina_lock_release(&thiz->lock);
+		_thread_finish(j);
+		eina_lock_take(&thiz->lock);
+	}
+	eina_lock_release(&thiz->lock);
 
 #ifdef _WIN32
 	return 0;
@@ -114,23 +209,37 @@ static void * _thread_load(void *data)
 #endif
 }
 
-#ifdef _WIN32
-static DWORD WINAPI _thread_save(LPVOID data)
-#else
-static void * _thread_save(void *data)
-#endif
+static void _job_submit(Enesim_Image_Context *thiz, Enesim_Image_Job *j)
 {
-	Enesim_Image_Job *j = data;
+	Eina_Bool created = EINA_FALSE;
 
-	enesim_image_provider_save(j->prov, j->data, j->op.save.b, j->options,
-		&j->err);
-	_thread_finish(j);
+	eina_lock_take(&thiz->lock);
+	j->state = ENESIM_IMAGE_JOB_QUEUED;
+	_job_enqueue(thiz, j);
+	thiz->queued++;
+	/* only create a new thread if the ones waiting are not enough */
+	if (thiz->queued > thiz->idle && thiz->nthreads < thiz->max)
+	{
+		Enesim_Image_Thread *threads;
 
-#ifdef _WIN32
-	return 1;
-#else
-	return NULL;
-#endif
+		threads = realloc(thiz->threads,
+				sizeof(Enesim_Image_Thread) * (thiz->nthreads + 1));
+		if (threads)
+		{
+			thiz->threads = threads;
+			created = ENESIM_IMAGE_THREAD_CREATE(
+					threads[thiz->nthreads], _thread_run,
+					thiz);
+		}
+		/* the job waits for the threads already created */
+		if (created)
+			thiz->nthreads++;
+		else
+			WRN("Can not create a new thread");
+	}
+	if (!created)
+		eina_condition_signal(&thiz->cond);
+	eina_lock_release(&thiz->lock);
 }
 /** @endcond */
 /*============================================================================*
@@ -140,7 +249,8 @@ static void * _thread_save(void *data)
  * @brief Create a new context
  *
  * Create a new context. A context is the holder of every asynchronous
- * operation done. 
+ * operation done. The operations are done on a pool of threads owned
+ * by the context. By default the pool has as many threads as cpus.
  */
 EAPI Enesim_Image_Context * enesim_image_context_new(void)
 {
@@ -156,17 +266,47 @@ EAPI Enesim_Image_Context * enesim_image_context_new(void)
 	}
 
 	fcntl(thiz->fifo[0], F_SETFL, O_NONBLOCK);
-	/* TODO the pool of threads */
+	/* the pool of threads */
+	thiz->max = eina_cpu_count();
+	if (!thiz->max) thiz->max = 1;
+	eina_lock_new(&thiz->lock);
+	eina_condition_new(&thiz->cond, &thiz->lock);
 	return thiz;
 }
 	
 /**
  * @brief Free a context
  *
+ * The operations not started yet are discarded, the ones in progress are
+ * waited for. No callback is called for any of them.
  */
 EAPI void enesim_image_context_free(Enesim_Image_Context *thiz)
 {
-	/* TODO what if we shutdown while some thread is active? */
+	Enesim_Image_Job *j;
+	unsigned int i;
+
+	/* stop the threads */
+	eina_lock_take(&thiz->lock);
+	thiz->done = EINA_TRUE;
+	eina_condition_broadcast(&thiz->cond);
+	eina_lock_release(&thiz->lock);
+	for (i = 0; i < thiz->nthreads; i++)
+	{
+		ENESIM_IMAGE_THREAD_JOIN(thiz->threads[i]);
+	}
+	free(thiz->threads);
+	/* the jobs never started */
+	while (thiz->jobs)
+	{
+		j = EINA_INLIST_CONTAINER_GET(thiz->jobs, Enesim_Image_Job);
+		thiz->jobs = eina_inlist_remove(thiz->jobs, thiz->jobs);
+		_job_free(j);
+	}
+	/* the jobs not dispatched */
+	while (pipe_read(thiz->fifo[0], &j, sizeof(j)) > 0)
+		_job_free(j);
+	eina_condition_free(&thiz->cond);
+	eina_lock_free(&thiz->lock);
 	/* the fifo */
 	pipe_close(thiz->fifo[0]);
 	pipe_close(thiz->fifo[1]);
@@ -185,8 +325,11 @@ EAPI void enesim_image_context_free(Enesim_Image_Context *thiz)
  * @param cb The function that will get called once the load is done
  * @param user_data User provided data
  * @param options Any option the provider might require
+ * @return The job of the load, valid until the callback is called. NULL
+ * in case the load can not be done, the callback is called with the error
+ * before returning
  */
-EAPI void enesim_image_context_load_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
+EAPI Enesim_Image_Job * enesim_image_context_load_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
 		const char *mime, Enesim_Buffer *b, Enesim_Pool *mpool,
 		Enesim_Image_Callback cb, void *user_data,
 		const char *options)
@@ -198,7 +341,7 @@ EAPI void enesim_image_context_load_async(Enesim_Image_Context *thiz, Enesim_Str
 	if (!prov)
 	{
 		cb(NULL, user_data, ENESIM_IMAGE_ERROR_PROVIDER);
-		return;
+		return NULL;
 	}
 
 	j = calloc(1, sizeof(Enesim_Image_Job));
@@ -211,12 +354,13 @@ EAPI void enesim_image_context_load_async(Enesim_Image_Context *thiz, Enesim_Str
 		j->options = strdup(options);
 	j->err = 0;
 	j->type = ENESIM_IMAGE_LOAD;
+	j->priority = ENESIM_IMAGE_JOB_PRIORITY_DEFAULT;
 	j->op.load.b = b;
 	j->op.load.pool = mpool;
-	/* FIXME we need to block the thread */
-	/* create a thread that loads the image on background and sends
+	/* one thread of the pool loads the image on background and sends
 	 * a command into the fifo fd */
-	ENESIM_IMAGE_THREAD_CREATE(thiz->tid, _thread_load, j);
+	_job_submit(thiz, j);
+	return j;
 }
 
 /**
@@ -229,9 +373,11 @@ EAPI void enesim_image_context_load_async(Enesim_Image_Context *thiz, Enesim_Str
  * @param cb The function that will get called once the save is done
  * @param user_data User provided data
  * @param options Any option the provider might require
- *
+ * @return The job of the save, valid until the callback is called. NULL
+ * in case the save can not be done, the callback is called with the error
+ * before returning
  */
-EAPI void enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
+EAPI Enesim_Image_Job * enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Stream *data,
 		const char *mime, Enesim_Buffer *b, Enesim_Image_Callback cb,
 		void *user_data, const char *options)
 {
@@ -242,10 +388,10 @@ EAPI void enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Str
 	if (!prov)
 	{
 		cb(NULL, user_data, ENESIM_IMAGE_ERROR_PROVIDER);
-		return;
+		return NULL;
 	}
 
-	j = malloc(sizeof(Enesim_Image_Job));
+	j = calloc(1, sizeof(Enesim_Image_Job));
 	j->thiz = thiz;
 	j->prov = prov;
 	j->data = data;
@@ -255,11 +401,12 @@ EAPI void enesim_image_context_save_async(Enesim_Image_Context *thiz, Enesim_Str
 		j->options = strdup(options);
 	j->err = 0;
 	j->type = ENESIM_IMAGE_SAVE;
+	j->priority = ENESIM_IMAGE_JOB_PRIORITY_DEFAULT;
 	j->op.save.b = b;
-	/* FIXME we need to block the thread */
-	/* create a thread that saves the image on background and sends
+	/* one thread of the pool saves the image on background and sends
 	 * a command into the fifo fd */
-	ENESIM_IMAGE_THREAD_CREATE(thiz->tid, _thread_save, j);
+	_job_submit(thiz, j);
+	return j;
 }
 
 /**
@@ -291,8 +438,98 @@ EAPI void enesim_image_context_dispatch(Enesim_Image_Context *thiz)
 			j->cb(j->op.load.b, j->user_data, j->err);
 		else
 			j->cb(j->op.save.b, j->user_data, j->err);
-		if (j->options)
-			free(j->options);
-		free(j);
+		_job_free(j);
+	}
+}
+
+/**
+ * @brief Set the priority of an asynchronous job
+ *
+ * The jobs with a higher priority are started first. Jobs with the same
+ * priority are started in the order they were requested. By default
+ * every job has a @ref ENESIM_PRIORITY_SECONDARY priority. Changing the
+ * priority of a job that has already started has no effect.
+ *
+ * @param thiz The context of the job
+ * @param j The job to set the priority to
+ * @param priority The priority to set
+ */
+EAPI void enesim_image_context_job_priority_set(Enesim_Image_Context *thiz,
+		Enesim_Image_Job *j, Enesim_Priority priority)
+{
+	eina_lock_take(&thiz->lock);
+	j->priority = priority;
+	if (j->state == ENESIM_IMAGE_JOB_QUEUED)
+	{
+		thiz->jobs = eina_inlist_remove(thiz->jobs, EINA_INLIST_GET(j));
+		_job_enqueue(thiz, j);
 	}
+	eina_lock_release(&thiz->lock);
+}
+
+/**
+ * @brief Cancel an asynchronous job
+ *
+ * Only the jobs that have not started yet can be cancelled. The callback
+ * of a cancelled job is still called on the next dispatch, with the
+ * @ref ENESIM_IMAGE_ERROR_CANCELLED error.
+ *
+ * @param thiz The context of the job
+ * @param j The job to cancel
+ * @return EINA_TRUE if the job has been cancelled, EINA_FALSE if it has
+ * already started
+ */
+EAPI Eina_Bool enesim_image_context_job_cancel(Enesim_Image_Context *thiz,
+		Enesim_Image_Job *j)
+{
+	Eina_Bool ret = EINA_FALSE;
+
+	eina_lock_take(&thiz->lock);
+	if (j->state == ENESIM_IMAGE_JOB_QUEUED)
+	{
+		thiz->jobs = eina_inlist_remove(thiz->jobs, EINA_INLIST_GET(j));
+		thiz->queued--;
+		j->state = ENESIM_IMAGE_JOB_FINISHED;
+		j->err = ENESIM_IMAGE_ERROR_CANCELLED;
+		ret = EINA_TRUE;
+	}
+	eina_lock_release(&thiz->lock);
+	if (ret)
+		_thread_finish(j);
+	return ret;
+}
+
+/**
+ * @brief Set the maximum number of jobs a context runs at the same time
+ *
+ * The context creates a new thread for a job only when the current threads
+ * are busy and the maximum has not been reached yet.
+ *
+ * @param thiz The context to set the maximum to
+ * @param max The maximum number of concurrent jobs, 0 for one per cpu
+ */
+EAPI void enesim_image_context_threads_max_set(Enesim_Image_Context *thiz,
+		unsigned int max)
+{
+	if (!max)
+	{
+		max = eina_cpu_count();
+		if (!max) max = 1;
+	}
+	eina_lock_take(&thiz->lock);
+	thiz->max = max;
+	/* wake up the threads waiting for the limit */
+	eina_condition_broadcast(&thiz->cond);
+	eina_lock_release(&thiz->lock);
+}
+
+/**
+ * @brief Get the maximum number of jobs a context runs at the same time
+ *
+ * @param thiz The context to get the maximum from
+ * @return The maximum number of concurrent jobs
+ */
+EAPI unsigned int enesim_image_context_threads_max_get(Enesim_Image_Context *thiz)
+{
+	return thiz->max;
 }
@@ -1,4 +1,5 @@
 
 src_lib_libenesim_la_SOURCES += \
 src/lib/rasterizer/enesim_rasterizer_basic.c \
-src/lib/rasterizer/enesim_rasterizer_bifigure.c
+src/lib/rasterizer/enesim_rasterizer_bifigure.c \
+src/lib/rasterizer/enesim_rasterizer_coverage.c
@@ -39,6 +39,7 @@
 #include "enesim_vector_private.h"
 #include "enesim_renderer_private.h"
 #include "enesim_rasterizer_private.h"
+#include "enesim_atomic_private.h"
 /*============================================================================*
  *                                  Local                                     *
  *============================================================================*/
@@ -103,12 +104,42 @@ typedef struct _Enesim_Rasterizer_Basic_State
 	Enesim_Color color;
 } Enesim_Rasterizer_Basic_State;
 
+/* The number of rows of the bands the vectors are binned on */
+#define ENESIM_RASTERIZER_BASIC_BAND_H 32
+
+/* The active edge table. The vectors are sorted by their top, so going down
+ * they enter the table in order and leave it once the row is below their
+ * bottom. Every span advances the table from the row it was left at, and
+ * going up or to another band it is built again from the vectors of the
+ * band
+ */
+typedef struct _Enesim_Rasterizer_Basic_Aet
+{
+	Enesim_Atomic busy;
+	/* the row the table is at */
+	Enesim_Atomic yy;
+	/* the first vector that has not entered the table */
+	int next;
+	int *active;
+	int nactive;
+} Enesim_Rasterizer_Basic_Aet;
+
 typedef struct _Enesim_Rasterizer_Basic
 {
 	Enesim_Rasterizer parent;
 	/* private */
 	Enesim_F16p16_Vector *vectors;
 	int nvectors;
+	/* one table for every thread that draws */
+	Enesim_Rasterizer_Basic_Aet *aets;
+	int naets;
+	/* the vectors that touch every band of rows, the ones of a band go
+	 * from bands[n] to bands[n + 1]
+	 */
+	int *band_vectors;
+	int *bands;
+	int nbands;
+	int band_yy;
 	const Enesim_Figure *figure;
 	Eina_Bool changed : 1;
 
@@ -125,71 +156,250 @@ typedef struct _Enesim_Rasterizer_Basic_Class {
 	Enesim_Rasterizer_Class parent;
 } Enesim_Rasterizer_Basic_Class;
 
+static int _basic_band_get(Enesim_Rasterizer_Basic *thiz, int yy)
+{
+	long long int band;
+
+	if (!thiz->nbands || (yy < thiz->band_yy))
+		return -1;
+	band = ((long long int)yy - thiz->band_yy) /
+			(ENESIM_RASTERIZER_BASIC_BAND_H << 16);
+	if (band >= thiz->nbands)
+		return -1;
+	return band;
+}
+
+static Eina_Bool _basic_bands_setup(Enesim_Rasterizer_Basic *thiz)
+{
+	Enesim_F16p16_Vector *v;
+	int yy1 = INT_MIN;
+	int n, i;
+
+	if (!thiz->nvectors)
+		return EINA_TRUE;
+	for (n = 0, v = thiz->vectors; n < thiz->nvectors; n++, v++)
+	{
+		if (v->yy1 > yy1)
+			yy1 = v->yy1;
+	}
+	/* the vectors are sorted by their top */
+	thiz->band_yy = thiz->vectors[0].yy0 - 0xffff;
+	thiz->nbands = (((long long int)yy1 + 0xffff - thiz->band_yy) /
+			(ENESIM_RASTERIZER_BASIC_BAND_H << 16)) + 1;
+
+	thiz->bands = calloc(thiz->nbands + 1, sizeof(int));
+	if (!thiz->bands)
+		return EINA_FALSE;
+	/* count the vectors of every band, then place them in order using the
+	 * start of every band as the cursor, which leaves it at the start of the
+	 * next one
+	 */
+	for (n = 0, v = thiz->vectors; n < thiz->nvectors; n++, v++)
+	{
+		int b0 = _basic_band_get(thiz, v->yy0 - 0xffff);
+		int b1 = _basic_band_get(thiz, v->yy1 + 0xffff);
+
+		for (i = b0; i <= b1; i++)
+			thiz->bands[i + 1]++;
+	}
+	for (i = 0; i < thiz->nbands; i++)
+		thiz->bands[i + 1] += thiz->bands[i];
+	thiz->band_vectors = malloc(thiz->bands[thiz->nbands] * sizeof(int));
+	if (!thiz->band_vectors)
+		return EINA_FALSE;
+	for (n = 0, v = thiz->vectors; n < thiz->nvectors; n++, v++)
+	{
+		int b0 = _basic_band_get(thiz, v->yy0 - 0xffff);
+		int b1 = _basic_band_get(thiz, v->yy1 + 0xffff);
+
+		for (i = b0; i <= b1; i++)
+			thiz->band_vectors[thiz->bands[i]++] = n;
+	}
+	for (i = thiz->nbands - 1; i > 0; i--)
+		thiz->bands[i] = thiz->bands[i - 1];
+	thiz->bands[0] = 0;
+	return EINA_TRUE;
+}
+
+/* Build the table from the vectors of the band of the row, or empty if the
+ * row is outside of the bands
+ */
+static void _basic_aet_build(Enesim_Rasterizer_Basic *thiz,
+		Enesim_Rasterizer_Basic_Aet *aet, int yy)
+{
+	Enesim_F16p16_Vector *vectors = thiz->vectors;
+	int band;
+	int lo, hi;
+	int n;
+
+	aet->next = 0;
+	aet->nactive = 0;
+	band = _basic_band_get(thiz, yy);
+	if (band < 0)
+		return;
+
+	/* the vectors that have entered the table */
+	lo = 0;
+	hi = thiz->nvectors;
+	while (lo < hi)
+	{
+		int mid = (lo + hi) / 2;
+
+		if (yy + 0xffff < vectors[mid].yy0)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	aet->next = lo;
+
+	for (n = thiz->bands[band]; n < thiz->bands[band + 1]; n++)
+	{
+		int i = thiz->band_vectors[n];
+
+		if (i >= aet->next)
+			break;
+		if (yy <= (vectors[i].yy1 + 0xffff))
+			aet->active[aet->nactive++] = i;
+	}
+}
+
+static void _basic_aet_advance(Enesim_Rasterizer_Basic *thiz,
+		Enesim_Rasterizer_Basic_Aet *aet, int yy)
+{
+	Enesim_F16p16_Vector *vectors = thiz->vectors;
+	int nactive = 0;
+	int n;
+
+	/* remove the vectors that end above the row */
+	for (n = 0; n < aet->nactive; n++)
+	{
+		Enesim_F16p16_Vector *v = &vectors[aet->active[n]];
+
+		if (yy <= (v->yy1 + 0xffff))
+			aet->active[nactive++] = aet->active[n];
+	}
+	/* and add the ones that start on it, keeping the order */
+	while (aet->next < thiz->nvectors)
+	{
+		Enesim_F16p16_Vector *v = &vectors[aet->next];
+
+		if (yy + 0xffff < v->yy0)
+			break;
+		if (yy <= (v->yy1 + 0xffff))
+			aet->active[nactive++] = aet->next;
+		aet->next++;
+	}
+	aet->nactive = nactive;
+	enesim_atomic_set(&aet->yy, yy);
+}
+
+/* Claim the table left closest above the row, or any free one, and advance
+ * it to the row. Release it once the edges are set up
+ */
+static Enesim_Rasterizer_Basic_Aet * _basic_aet_get(
+		Enesim_Rasterizer_Basic *thiz, int yy)
+{
+	Enesim_Rasterizer_Basic_Aet *aet = NULL;
+	int best = -1;
+	int besty = 0;
+	int i;
+
+	for (i = 0; i < thiz->naets; i++)
+	{
+		int ayy = enesim_atomic_get(&thiz->aets[i].yy);
+
+		if ((ayy <= yy) && ((best < 0) || (ayy > besty)))
+		{
+			best = i;
+			besty = ayy;
+		}
+	}
+	if ((best >= 0) && enesim_atomic_cas(&thiz->aets[best].busy, 0, 1))
+		aet = &thiz->aets[best];
+	for (i = 0; !aet && (i < thiz->naets); i++)
+	{
+		if (enesim_atomic_cas(&thiz->aets[i].busy, 0, 1))
+			aet = &thiz->aets[i];
+	}
+	if (!aet)
+		return NULL;
+
+	if ((aet->yy > yy) ||
+			(_basic_band_get(thiz, aet->yy) != _basic_band_get(thiz, yy)))
+		_basic_aet_build(thiz, aet, yy);
+	_basic_aet_advance(thiz, aet, yy);
+	return aet;
+}
+
 #define SETUP_EDGES \
-	edges = alloca(nvectors * sizeof(Enesim_F16p16_Edge)); \
+	aet = _basic_aet_get(thiz, yy); \
+	if (!aet) \
+	{ \
+		aet = &local; \
+		aet->active = alloca(nvectors * sizeof(int)); \
+		_basic_aet_build(thiz, aet, yy); \
+		_basic_aet_advance(thiz, aet, yy); \
+	} \
+	edges = alloca(aet->nactive * sizeof(Enesim_F16p16_Edge)); \
 	edge = edges; \
 	n = 0; \
-	while (n < nvectors) \
+	while (n < aet->nactive) \
 	{ \
-		if (yy + 0xffff < v->yy0) \
-			break; \
-		if (((yy + 0xffff) >= v->yy0) & (yy <= (v->yy1 + 0xffff))) \
+		v = thiz->vectors + aet->active[n]; \
+		edge->xx0 = v->xx0; \
+		edge->xx1 = v->xx1; \
+		edge->yy0 = v->yy0; \
+		edge->yy1 = v->yy1; \
+		edge->de = (v->a * (long long int) axx) >> 16; \
+		edge->e = ((v->a * (long long int) xx) >> 16) + \
+				((v->b * (long long int) yy) >> 16) + \
+				v->c; \
+		edge->counted = ((yy >= edge->yy0) & (yy < edge->yy1)); \
+		if (v->sgn) \
 		{ \
-			edge->xx0 = v->xx0; \
-			edge->xx1 = v->xx1; \
-			edge->yy0 = v->yy0; \
-			edge->yy1 = v->yy1; \
-			edge->de = (v->a * (long long int) axx) >> 16; \
-			edge->e = ((v->a * (long long int) xx) >> 16) + \
-					((v->b * (long long int) yy) >> 16) + \
-					v->c; \
-			edge->counted = ((yy >= edge->yy0) & (yy < edge->yy1)); \
-			if (v->sgn) \
-			{ \
-				int dxx = (v->xx1 - v->xx0); \
-				double dd = dxx / (double)(v->yy1 - v->yy0); \
-				int lxxc, lyyc = yy - 0xffff; \
-				int rxxc, ryyc = yy + 0xffff; \
+			int dxx = (v->xx1 - v->xx0); \
+			double dd = dxx / (double)(v->yy1 - v->yy0); \
+			int lxxc, lyyc = yy - 0xffff; \
+			int rxxc, ryyc = yy + 0xffff; \
  \
-				if (v->sgn < 0) \
-				{ \
-					lyyc = yy + 0xffff; \
-					ryyc = yy - 0xffff; \
-				} \
+			if (v->sgn < 0) \
+			{ \
+				lyyc = yy + 0xffff; \
+				ryyc = yy - 0xffff; \
+			} \
  \
-				lxxc = (lyyc - v->yy0) * dd; \
-				rxxc = (ryyc - v->yy0) * dd; \
+			lxxc = (lyyc - v->yy0) * dd; \
+			rxxc = (ryyc - v->yy0) * dd; \
  \
-				if (v->sgn < 0) \
-				{ \
-					lxxc = dxx - lxxc; \
-					rxxc = dxx - rxxc; \
-				} \
+			if (v->sgn < 0) \
+			{ \
+				lxxc = dxx - lxxc; \
+				rxxc = dxx - rxxc; \
+			} \
  \
-				lxxc += v->xx0; \
-				rxxc += v->xx0; \
+			lxxc += v->xx0; \
+			rxxc += v->xx0; \
  \
-				if (lxxc < v->xx0) \
-					lxxc = v->xx0; \
-				if (rxxc > v->xx1) \
-					rxxc = v->xx1; \
+			if (lxxc < v->xx0) \
+				lxxc = v->xx0; \
+			if (rxxc > v->xx1) \
+				rxxc = v->xx1; \
  \
-				if (lx > lxxc)  lx = lxxc; \
-				if (rx < rxxc)  rx = rxxc; \
-				edge->lx = (lxxc >> 16); \
-			} \
-			else \
-			{ \
-				if (lx > v->xx0)  lx = v->xx0; \
-				if (rx < v->xx1)  rx = v->xx1; \
-				edge->lx = (v->xx0 >> 16); \
-			} \
-			edge++; \
-			nedges++; \
+			if (lx > lxxc)  lx = lxxc; \
+			if (rx < rxxc)  rx = rxxc; \
+			edge->lx = (lxxc >> 16); \
+		} \
+		else \
+		{ \
+			if (lx > v->xx0)  lx = v->xx0; \
+			if (rx < v->xx1)  rx = v->xx1; \
+			edge->lx = (v->xx0 >> 16); \
 		} \
+		edge++; \
+		nedges++; \
 		n++; \
-		v++; \
 	} \
+	enesim_atomic_set(&aet->busy, 0); \
  \
 	if (!nedges) \
 		goto get_out; \
@@ -302,8 +512,9 @@ static void _stroke_fill_paint_nz(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -466,8 +677,9 @@ static void _stroke_paint_fill_nz(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -573,8 +785,9 @@ static void _stroke_paint_fill_paint_nz(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -748,8 +961,9 @@ static void _stroke_fill_paint_eo(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -913,8 +1127,9 @@ static void _stroke_paint_fill_eo(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -1021,8 +1236,9 @@ static void _stroke_paint_fill_paint_eo(Enesim_Renderer *r,
 	int sww;
 	uint32_t *dst = ddata;
 	uint32_t *d = dst, *e = d + len;
+	Enesim_Rasterizer_Basic_Aet *aet, local;
 	Enesim_F16p16_Edge *edges, *edge;
-	Enesim_F16p16_Vector *v = thiz->vectors;
+	Enesim_F16p16_Vector *v;
 	int nvectors = thiz->nvectors, n = 0, nedges = 0;
 	double ox, oy;
 	int lx = INT_MAX / 2, rx = -lx;
@@ -1164,6 +1380,8 @@ static Eina_Bool _basic_sw_setup(Enesim_Renderer *r,
 	Enesim_Renderer_Shape_Draw_Mode draw_mode;
 	Enesim_Renderer_Shape_Fill_Rule fill_rule;
 	Enesim_Matrix matrix;
+	int naets;
+	int i;
 
 	thiz = ENESIM_RASTERIZER_BASIC(r);
 	state = &thiz->state;
@@ -1195,6 +1413,18 @@ static Eina_Bool _basic_sw_setup(Enesim_Renderer *r,
 			free(thiz->vectors);
 			thiz->vectors = NULL;
 		}
+		/* the tables are sized to the vectors */
+		if (thiz->aets)
+		{
+			free(thiz->aets);
+			thiz->aets = NULL;
+			thiz->naets = 0;
+		}
+		free(thiz->bands);
+		free(thiz->band_vectors);
+		thiz->bands = NULL;
+		thiz->band_vectors = NULL;
+		thiz->nbands = 0;
 
 		EINA_LIST_FOREACH(thiz->figure->polygons, l1, p)
 		{
@@ -1393,9 +1623,45 @@ static Eina_Bool _basic_sw_setup(Enesim_Renderer *r,
 			}
 		}
 		qsort(thiz->vectors, thiz->nvectors, sizeof(Enesim_F16p16_Vector), _tysort);
+		if (!_basic_bands_setup(thiz))
+		{
+			ENESIM_RENDERER_LOG(r, error, "Not enough memory for the bands");
+			return EINA_FALSE;
+		}
 		thiz->changed = EINA_FALSE;
 	}
 
+	/* the tables start empty on every draw */
+	naets = enesim_renderer_sw_threads_get();
+	if (naets != thiz->naets)
+	{
+		int *active;
+
+		free(thiz->aets);
+		thiz->naets = 0;
+		thiz->aets = malloc(naets * (sizeof(Enesim_Rasterizer_Basic_Aet) +
+				thiz->nvectors * sizeof(int)));
+		if (!thiz->aets)
+		{
+			ENESIM_RENDERER_LOG(r, error, "Not enough memory for the edge tables");
+			return EINA_FALSE;
+		}
+		thiz->naets = naets;
+		active = (int *)(thiz->aets + naets);
+		for (i = 0; i < naets; i++)
+		{
+			thiz->aets[i].active = active;
+			active += thiz->nvectors;
+		}
+	}
+	for (i = 0; i < thiz->naets; i++)
+	{
+		thiz->aets[i].busy = 0;
+		thiz->aets[i].yy = INT_MAX;
+		thiz->aets[i].next = 0;
+		thiz->aets[i].nactive = 0;
+	}
+
 	enesim_renderer_transformation_get(r, &matrix);
 	enesim_matrix_matrix_f16p16_to(&matrix,
 			&thiz->matrix);
@@ -1484,6 +1750,10 @@ static void _enesim_rasterizer_basic_instance_deinit(void *o)
 	thiz = ENESIM_RASTERIZER_BASIC(o);
 	if (thiz->vectors)
 		free(thiz->vectors);
+	if (thiz->aets)
+		free(thiz->aets);
+	free(thiz->bands);
+	free(thiz->band_vectors);
 }
 /*============================================================================*
  *                                 Global                                     *
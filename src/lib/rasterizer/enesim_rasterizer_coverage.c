@@ -0,0 +1,649 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "enesim_private.h"
+#include "libargb.h"
+
+#include <math.h>
+
+#include "enesim_main.h"
+#include "enesim_log.h"
+#include "enesim_color.h"
+#include "enesim_rectangle.h"
+#include "enesim_matrix.h"
+#include "enesim_pool.h"
+#include "enesim_buffer.h"
+#include "enesim_format.h"
+#include "enesim_surface.h"
+#include "enesim_renderer.h"
+#include "enesim_renderer_shape.h"
+#include "enesim_object_descriptor.h"
+#include "enesim_object_class.h"
+#include "enesim_object_instance.h"
+
+#include "enesim_list_private.h"
+#include "enesim_vector_private.h"
+#include "enesim_renderer_private.h"
+#include "enesim_rasterizer_private.h"
+
+/*
+ * This rasterizer computes the exact area of every pixel covered by the
+ * figure. Every edge is split on the pixels it crosses, and each piece
+ * accumulates on the pixel cell its signed height (the cover) and the part
+ * of it that is on the right of the edge (the area). Only the cells crossed
+ * by an edge are kept, sorted by row and column, and the covers are added
+ * from left to right: the coverage of a pixel is the cover of the cells on
+ * its left, plus the part of its own cell that is on the right of the edges
+ * that cross it. The coverage is kept as runs of pixels, so the spans only
+ * expand them, and the runs are reused on the next draws until the figure
+ * changes.
+ *
+ * The coordinates are in 24.8 fixed point, and a fully covered pixel has a
+ * winding of 256 * 512, so everything is integer and exact.
+ */
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#define ENESIM_RASTERIZER_COVERAGE(o) ENESIM_OBJECT_INSTANCE_CHECK(o,		\
+		Enesim_Rasterizer_Coverage,					\
+		enesim_rasterizer_coverage_descriptor_get())
+
+/* the winding of a pixel fully covered */
+#define COVERAGE_FULL (256 * 512)
+
+typedef struct _Enesim_Rasterizer_Coverage_Cell
+{
+	int y;
+	int x;
+	int cover;
+	int area;
+} Enesim_Rasterizer_Coverage_Cell;
+
+/* a run of pixels with the same coverage */
+typedef struct _Enesim_Rasterizer_Coverage_Run
+{
+	int x;
+	int len;
+	int a;
+} Enesim_Rasterizer_Coverage_Run;
+
+typedef struct _Enesim_Rasterizer_Coverage_State
+{
+	struct {
+		Enesim_Renderer *r;
+		Enesim_Color color;
+	} fill;
+} Enesim_Rasterizer_Coverage_State;
+
+typedef struct _Enesim_Rasterizer_Coverage
+{
+	Enesim_Rasterizer parent;
+	/* private */
+	const Enesim_Figure *figure;
+	Eina_Bool changed : 1;
+	/* the cells sorted by row and column */
+	Enesim_Rasterizer_Coverage_Cell *cells;
+	int ncells;
+	int acells;
+	/* the mask of the last rasterization, kept while only the colors,
+	 * the renderers or an integer translation change
+	 */
+	Enesim_Rasterizer_Coverage_Run *runs;
+	int nruns;
+	int aruns;
+	/* the offset of the first run of every row */
+	int *rows;
+	int nrows;
+	int ty;
+	/* what the mask was generated with */
+	Enesim_Matrix matrix;
+	double ox;
+	double oy;
+	Eina_Bool even_odd;
+	/* the translation of the mask since it was generated */
+	int dx;
+	int dy;
+
+	Enesim_Rasterizer_Coverage_State state;
+} Enesim_Rasterizer_Coverage;
+
+typedef struct _Enesim_Rasterizer_Coverage_Class {
+	Enesim_Rasterizer_Class parent;
+} Enesim_Rasterizer_Coverage_Class;
+
+static int _coverage_cell_cmp(const void *l, const void *r)
+{
+	const Enesim_Rasterizer_Coverage_Cell *lc = l;
+	const Enesim_Rasterizer_Coverage_Cell *rc = r;
+
+	if (lc->y != rc->y)
+		return lc->y < rc->y ? -1 : 1;
+	if (lc->x != rc->x)
+		return lc->x < rc->x ? -1 : 1;
+	return 0;
+}
+
+static Eina_Bool _coverage_cell_add(Enesim_Rasterizer_Coverage *thiz,
+		int x, int y, int cover, int area)
+{
+	Enesim_Rasterizer_Coverage_Cell *cell;
+
+	if (thiz->ncells == thiz->acells)
+	{
+		Enesim_Rasterizer_Coverage_Cell *cells;
+		int acells = thiz->acells ? thiz->acells * 2 : 1024;
+
+		cells = realloc(thiz->cells, acells * sizeof(Enesim_Rasterizer_Coverage_Cell));
+		if (!cells)
+			return EINA_FALSE;
+		thiz->cells = cells;
+		thiz->acells = acells;
+	}
+	cell = &thiz->cells[thiz->ncells++];
+	cell->x = x;
+	cell->y = y;
+	cell->cover = cover;
+	cell->area = area;
+	return EINA_TRUE;
+}
+
+/* Add the piece of an edge that is inside a row, splitting it on the
+ * columns it crosses
+ */
+static Eina_Bool _coverage_row_add(Enesim_Rasterizer_Coverage *thiz,
+		int row, int x0, int y0, int x1, int y1, int sgn)
+{
+	int cx;
+
+	if (x0 == x1)
+	{
+		cx = x0 >> 8;
+		return _coverage_cell_add(thiz, cx, row, sgn * (y1 - y0) * 512,
+				sgn * (y1 - y0) * (x0 + x1 - (cx * 512)));
+	}
+	if (x0 < x1)
+	{
+		int px = x0, py = y0;
+
+		for (cx = x0 >> 8; (cx + 1) * 256 < x1; cx++)
+		{
+			int nx = (cx + 1) * 256;
+			int ny = y0 + (int)(((long long int)(nx - x0) * (y1 - y0)) / (x1 - x0));
+
+			if (!_coverage_cell_add(thiz, cx, row, sgn * (ny - py) * 512,
+					sgn * (ny - py) * (px + nx - (cx * 512))))
+				return EINA_FALSE;
+			px = nx;
+			py = ny;
+		}
+		return _coverage_cell_add(thiz, cx, row, sgn * (y1 - py) * 512,
+				sgn * (y1 - py) * (px + x1 - (cx * 512)));
+	}
+	else
+	{
+		int px = x0, py = y0;
+
+		for (cx = (x0 - 1) >> 8; cx * 256 > x1; cx--)
+		{
+			int nx = cx * 256;
+			int ny = y0 + (int)(((long long int)(x0 - nx) * (y1 - y0)) / (x0 - x1));
+
+			if (!_coverage_cell_add(thiz, cx, row, sgn * (ny - py) * 512,
+					sgn * (ny - py) * (px + nx - (cx * 512))))
+				return EINA_FALSE;
+			px = nx;
+			py = ny;
+		}
+		return _coverage_cell_add(thiz, cx, row, sgn * (y1 - py) * 512,
+				sgn * (y1 - py) * (px + x1 - (cx * 512)));
+	}
+}
+
+/* Add an edge, splitting it on the rows it crosses */
+static Eina_Bool _coverage_edge_add(Enesim_Rasterizer_Coverage *thiz,
+		int x0, int y0, int x1, int y1)
+{
+	int sgn = 1;
+	int row;
+	int px, py;
+
+	if (y0 == y1)
+		return EINA_TRUE;
+	if (y0 > y1)
+	{
+		int tmp;
+
+		tmp = x0; x0 = x1; x1 = tmp;
+		tmp = y0; y0 = y1; y1 = tmp;
+		sgn = -1;
+	}
+
+	px = x0;
+	py = y0;
+	for (row = y0 >> 8; (row + 1) * 256 < y1; row++)
+	{
+		int ny = (row + 1) * 256;
+		int nx = x0 + (int)(((long long int)(ny - y0) * (x1 - x0)) / (y1 - y0));
+
+		if (!_coverage_row_add(thiz, row, px, py, nx, ny, sgn))
+			return EINA_FALSE;
+		px = nx;
+		py = ny;
+	}
+	return _coverage_row_add(thiz, row, px, py, x1, y1, sgn);
+}
+
+/* the coverage of a winding, from 0 to 256 */
+static inline int _coverage_alpha(int winding, Eina_Bool even_odd)
+{
+	if (winding < 0)
+		winding = -winding;
+	if (even_odd)
+	{
+		winding &= (2 * COVERAGE_FULL) - 1;
+		if (winding > COVERAGE_FULL)
+			winding = (2 * COVERAGE_FULL) - winding;
+	}
+	else if (winding > COVERAGE_FULL)
+		winding = COVERAGE_FULL;
+	return winding >> 9;
+}
+
+static Eina_Bool _coverage_run_add(Enesim_Rasterizer_Coverage *thiz,
+		int x, int len, int a)
+{
+	Enesim_Rasterizer_Coverage_Run *run;
+
+	if (!a)
+		return EINA_TRUE;
+	/* merge it with the previous run of the same row */
+	if (thiz->nruns > thiz->rows[thiz->nrows])
+	{
+		run = &thiz->runs[thiz->nruns - 1];
+		if ((run->a == a) && (run->x + run->len == x))
+		{
+			run->len += len;
+			return EINA_TRUE;
+		}
+	}
+	if (thiz->nruns == thiz->aruns)
+	{
+		Enesim_Rasterizer_Coverage_Run *runs;
+		int aruns = thiz->aruns ? thiz->aruns * 2 : 1024;
+
+		runs = realloc(thiz->runs, aruns * sizeof(Enesim_Rasterizer_Coverage_Run));
+		if (!runs)
+			return EINA_FALSE;
+		thiz->runs = runs;
+		thiz->aruns = aruns;
+	}
+	run = &thiz->runs[thiz->nruns++];
+	run->x = x;
+	run->len = len;
+	run->a = a;
+	return EINA_TRUE;
+}
+
+static Eina_Bool _coverage_generate(Enesim_Rasterizer_Coverage *thiz)
+{
+	Enesim_Polygon *p;
+	Enesim_Matrix inverse;
+	Eina_List *l1;
+	int nrows;
+	int i, j;
+
+	thiz->ncells = 0;
+	thiz->nruns = 0;
+	thiz->nrows = 0;
+	thiz->dx = 0;
+	thiz->dy = 0;
+	enesim_matrix_inverse(&thiz->matrix, &inverse);
+	/* every polygon is closed to fill it */
+	EINA_LIST_FOREACH(thiz->figure->polygons, l1, p)
+	{
+		Enesim_Point *pt;
+		Eina_List *l2;
+		int fx = 0, fy = 0;
+		int lx = 0, ly = 0;
+		int n = 0;
+
+		EINA_LIST_FOREACH(p->points, l2, pt)
+		{
+			double x, y;
+			int xx, yy;
+
+			enesim_matrix_point_transform(&inverse,
+					pt->x + thiz->ox,
+					pt->y + thiz->oy, &x, &y);
+			xx = lround(x * 256);
+			yy = lround(y * 256);
+			if (!n++)
+			{
+				fx = xx;
+				fy = yy;
+			}
+			else if (!_coverage_edge_add(thiz, lx, ly, xx, yy))
+				return EINA_FALSE;
+			lx = xx;
+			ly = yy;
+		}
+		if (n && !_coverage_edge_add(thiz, lx, ly, fx, fy))
+			return EINA_FALSE;
+	}
+	if (!thiz->ncells)
+		return EINA_TRUE;
+
+	/* merge the cells of the same pixel */
+	qsort(thiz->cells, thiz->ncells, sizeof(Enesim_Rasterizer_Coverage_Cell),
+			_coverage_cell_cmp);
+	for (i = 1, j = 0; i < thiz->ncells; i++)
+	{
+		Enesim_Rasterizer_Coverage_Cell *c = &thiz->cells[i];
+		Enesim_Rasterizer_Coverage_Cell *last = &thiz->cells[j];
+
+		if (c->y == last->y && c->x == last->x)
+		{
+			last->cover += c->cover;
+			last->area += c->area;
+		}
+		else
+		{
+			thiz->cells[++j] = *c;
+		}
+	}
+	thiz->ncells = j + 1;
+
+	/* integrate the cells of every row into runs of coverage */
+	thiz->ty = thiz->cells[0].y;
+	nrows = thiz->cells[thiz->ncells - 1].y - thiz->ty + 1;
+	free(thiz->rows);
+	thiz->rows = malloc((nrows + 1) * sizeof(int));
+	if (!thiz->rows)
+		return EINA_FALSE;
+	thiz->rows[0] = 0;
+	for (i = 0, j = 0; thiz->nrows < nrows; thiz->nrows++)
+	{
+		int winding = 0;
+		int x = INT_MIN;
+
+		for (; (j < thiz->ncells) && (thiz->cells[j].y == thiz->ty + thiz->nrows); j++)
+		{
+			Enesim_Rasterizer_Coverage_Cell *c = &thiz->cells[j];
+
+			if ((x != INT_MIN) && (c->x > x) &&
+					!_coverage_run_add(thiz, x, c->x - x,
+					_coverage_alpha(winding, thiz->even_odd)))
+				return EINA_FALSE;
+			if (!_coverage_run_add(thiz, c->x, 1,
+					_coverage_alpha(winding + c->cover - c->area,
+					thiz->even_odd)))
+				return EINA_FALSE;
+			winding += c->cover;
+			x = c->x + 1;
+		}
+		thiz->rows[thiz->nrows + 1] = thiz->nruns;
+	}
+	return EINA_TRUE;
+}
+
+static inline void _coverage_run(uint32_t *d, int len, int a,
+		Enesim_Color color, Enesim_Renderer *paint)
+{
+	uint32_t *e = d + len;
+
+	if (!paint)
+	{
+		if (a < 256)
+			color = argb8888_mul_256(a, color);
+		while (d < e)
+			*d++ = color;
+		return;
+	}
+	while (d < e)
+	{
+		uint32_t p0 = *d;
+
+		if (color != 0xffffffff)
+			p0 = argb8888_mul4_sym(color, p0);
+		if (a < 256)
+			p0 = argb8888_mul_256(a, p0);
+		*d++ = p0;
+	}
+}
+
+/* Move the mask when the origin has moved an integer number of pixels */
+static Eina_Bool _coverage_translate(Enesim_Rasterizer_Coverage *thiz,
+		double ox, double oy)
+{
+	double dx = ox - thiz->ox;
+	double dy = oy - thiz->oy;
+
+	if (!dx && !dy)
+	{
+		thiz->dx = 0;
+		thiz->dy = 0;
+		return EINA_TRUE;
+	}
+	/* otherwise the origin is not on the destination space */
+	if (enesim_matrix_type_get(&thiz->matrix) != ENESIM_MATRIX_TYPE_IDENTITY)
+		return EINA_FALSE;
+	if ((dx != floor(dx)) || (dy != floor(dy)) ||
+			(fabs(dx) > INT_MAX / 512) || (fabs(dy) > INT_MAX / 512))
+		return EINA_FALSE;
+	thiz->dx = dx;
+	thiz->dy = dy;
+	return EINA_TRUE;
+}
+
+static void _coverage_span(Enesim_Renderer *r,
+		int x, int y, int len, void *ddata)
+{
+	Enesim_Rasterizer_Coverage *thiz = ENESIM_RASTERIZER_COVERAGE(r);
+	Enesim_Rasterizer_Coverage_State *state = &thiz->state;
+	Enesim_Rasterizer_Coverage_Run *run, *end;
+	uint32_t *dst = ddata;
+	int row = y - thiz->dy - thiz->ty;
+	int rx;
+
+	if ((row < 0) || (row >= thiz->nrows) ||
+			(thiz->rows[row] == thiz->rows[row + 1]))
+	{
+		memset(dst, 0, sizeof(uint32_t) * len);
+		return;
+	}
+	run = thiz->runs + thiz->rows[row];
+	end = thiz->runs + thiz->rows[row + 1];
+
+	if (state->fill.r)
+		enesim_renderer_sw_draw(state->fill.r, x, y, len, dst);
+	/* go to the coordinates of the runs */
+	rx = x - thiz->dx;
+	while ((run < end) && (run->x + run->len <= rx))
+		run++;
+	while (len)
+	{
+		int n;
+
+		/* the gaps between the runs are not covered */
+		if ((run == end) || (run->x >= rx + len))
+		{
+			memset(dst, 0, sizeof(uint32_t) * len);
+			return;
+		}
+		if (run->x > rx)
+		{
+			n = run->x - rx;
+			memset(dst, 0, sizeof(uint32_t) * n);
+		}
+		else
+		{
+			n = run->x + run->len - rx;
+			if (n > len)
+				n = len;
+			_coverage_run(dst, n, run->a, state->fill.color,
+					state->fill.r);
+			run++;
+		}
+		dst += n;
+		rx += n;
+		len -= n;
+	}
+}
+/*----------------------------------------------------------------------------*
+ *                           Rasterizer interface                             *
+ *----------------------------------------------------------------------------*/
+static void _coverage_figure_set(Enesim_Renderer *r, const Enesim_Figure *figure)
+{
+	Enesim_Rasterizer_Coverage *thiz;
+
+	thiz = ENESIM_RASTERIZER_COVERAGE(r);
+	thiz->figure = figure;
+	thiz->changed = EINA_TRUE;
+}
+/*----------------------------------------------------------------------------*
+ *                    The Enesim's rasterizer interface                       *
+ *----------------------------------------------------------------------------*/
+static const char * _coverage_name(Enesim_Renderer *r EINA_UNUSED)
+{
+	return "coverage";
+}
+
+static Eina_Bool _coverage_sw_setup(Enesim_Renderer *r,
+		Enesim_Surface *s EINA_UNUSED, Enesim_Rop rop EINA_UNUSED,
+		Enesim_Renderer_Sw_Fill *draw, Enesim_Log **error)
+{
+	Enesim_Rasterizer_Coverage *thiz;
+	Enesim_Rasterizer_Coverage_State *state;
+	Enesim_Matrix matrix;
+	Enesim_Color color;
+	Eina_Bool even_odd;
+	double ox, oy;
+
+	thiz = ENESIM_RASTERIZER_COVERAGE(r);
+	state = &thiz->state;
+	if (!thiz->figure)
+	{
+		ENESIM_RENDERER_LOG(r, error, "No figure to rasterize");
+		return EINA_FALSE;
+	}
+	/* the strokes are given as figures to fill */
+	if (enesim_renderer_shape_draw_mode_get(r) != ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL)
+	{
+		ENESIM_RENDERER_LOG(r, error, "Only the fill draw mode is supported");
+		return EINA_FALSE;
+	}
+
+	enesim_renderer_transformation_get(r, &matrix);
+	enesim_renderer_origin_get(r, &ox, &oy);
+	even_odd = enesim_renderer_shape_fill_rule_get(r) ==
+			ENESIM_RENDERER_SHAPE_FILL_RULE_EVEN_ODD;
+	if (thiz->changed || (even_odd != thiz->even_odd) ||
+			!enesim_matrix_is_equal(&matrix, &thiz->matrix) ||
+			!_coverage_translate(thiz, ox, oy))
+	{
+		thiz->matrix = matrix;
+		thiz->ox = ox;
+		thiz->oy = oy;
+		thiz->even_odd = even_odd;
+		if (!_coverage_generate(thiz))
+		{
+			ENESIM_RENDERER_LOG(r, error, "Not enough memory for the cells");
+			thiz->changed = EINA_TRUE;
+			return EINA_FALSE;
+		}
+		thiz->changed = EINA_FALSE;
+	}
+
+	color = enesim_renderer_color_get(r);
+	state->fill.color = enesim_renderer_shape_fill_color_get(r);
+	if (color != 0xffffffff)
+		state->fill.color = argb8888_mul4_sym(color, state->fill.color);
+	state->fill.r = enesim_renderer_shape_fill_renderer_get(r);
+
+	*draw = _coverage_span;
+	return EINA_TRUE;
+}
+
+static void _coverage_sw_cleanup(Enesim_Renderer *r, Enesim_Surface *s EINA_UNUSED)
+{
+	Enesim_Rasterizer_Coverage *thiz;
+	Enesim_Rasterizer_Coverage_State *state;
+
+	thiz = ENESIM_RASTERIZER_COVERAGE(r);
+	state = &thiz->state;
+	if (state->fill.r)
+	{
+		enesim_renderer_unref(state->fill.r);
+		state->fill.r = NULL;
+	}
+}
+
+static void _coverage_sw_hints(Enesim_Renderer *r EINA_UNUSED,
+		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
+{
+	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
+}
+/*----------------------------------------------------------------------------*
+ *                            Object definition                               *
+ *----------------------------------------------------------------------------*/
+ENESIM_OBJECT_INSTANCE_BOILERPLATE(ENESIM_RASTERIZER_DESCRIPTOR,
+		Enesim_Rasterizer_Coverage, Enesim_Rasterizer_Coverage_Class,
+		enesim_rasterizer_coverage);
+
+static void _enesim_rasterizer_coverage_class_init(void *k)
+{
+	Enesim_Renderer_Class *r_klass;
+	Enesim_Rasterizer_Class *klass;
+
+	r_klass = ENESIM_RENDERER_CLASS(k);
+	r_klass->base_name_get = _coverage_name;
+	r_klass->sw_setup = _coverage_sw_setup;
+	r_klass->sw_cleanup = _coverage_sw_cleanup;
+	r_klass->sw_hints_get = _coverage_sw_hints;
+
+	klass = ENESIM_RASTERIZER_CLASS(k);
+	klass->figure_set = _coverage_figure_set;
+}
+
+static void _enesim_rasterizer_coverage_instance_init(void *o EINA_UNUSED)
+{
+}
+
+static void _enesim_rasterizer_coverage_instance_deinit(void *o)
+{
+	Enesim_Rasterizer_Coverage *thiz;
+
+	thiz = ENESIM_RASTERIZER_COVERAGE(o);
+	free(thiz->cells);
+	free(thiz->runs);
+	free(thiz->rows);
+}
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+Enesim_Renderer * enesim_rasterizer_coverage_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = ENESIM_OBJECT_INSTANCE_NEW(enesim_rasterizer_coverage);
+	return r;
+}
+/** @endcond */
+/*============================================================================*
+ *                                   API                                      *
+ *============================================================================*/
@@ -75,6 +75,15 @@ static void _background_span(Enesim_Renderer *r,
 	thiz->span(dst, len, NULL, thiz->final_color, NULL);
 }
 
+static int _background_runs(Enesim_Renderer *r, int x EINA_UNUSED,
+		int y EINA_UNUSED, int len, Enesim_Color *color)
+{
+	Enesim_Renderer_Background *thiz = ENESIM_RENDERER_BACKGROUND(r);
+
+	*color = thiz->final_color;
+	return len;
+}
+
 #if BUILD_OPENGL
 
 /* the only shader */
@@ -256,10 +265,23 @@ static void _background_features_get(Enesim_Renderer *r EINA_UNUSED,
 			ENESIM_RENDERER_FEATURE_ARGB8888;
 }
 
+static void _background_alpha_hints_get(Enesim_Renderer *r,
+		Enesim_Alpha_Hint *hints)
+{
+	Enesim_Renderer_Background *thiz;
+	Enesim_Color color;
+
+	thiz = ENESIM_RENDERER_BACKGROUND(r);
+	color = enesim_renderer_color_get(r);
+	if ((color >> 24) == 0xff && (thiz->color >> 24) == 0xff)
+		*hints = ENESIM_ALPHA_HINT_OPAQUE;
+}
+
 static void _background_sw_hints(Enesim_Renderer *r EINA_UNUSED,
 		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
 {
-	*hints = ENESIM_RENDERER_SW_HINT_ROP | ENESIM_RENDERER_SW_HINT_COLORIZE;
+	*hints = ENESIM_RENDERER_SW_HINT_ROP | ENESIM_RENDERER_SW_HINT_COLORIZE |
+			ENESIM_RENDERER_SW_HINT_RUNS;
 }
 
 static Eina_Bool _background_has_changed(Enesim_Renderer *r)
@@ -289,10 +311,11 @@ static void _enesim_renderer_background_class_init(void *k)
 	klass->is_inside = NULL;
 	klass->damages_get = NULL;
 	klass->has_changed =  _background_has_changed;
-	klass->alpha_hints_get = NULL;
+	klass->alpha_hints_get = _background_alpha_hints_get;
 	klass->sw_hints_get = _background_sw_hints;
 	klass->sw_setup = _background_sw_setup;
 	klass->sw_cleanup = _background_sw_cleanup;
+	klass->sw_runs = _background_runs;
 #if BUILD_OPENCL
 	klass->opencl_setup = _background_opencl_setup;
 	klass->opencl_kernel_setup = _background_opencl_kernel_setup;
@@ -489,7 +489,15 @@ static Eina_Bool _blur_sw_setup(Enesim_Renderer *r,
 	if (!_blur_state_setup(thiz, r, s, rop, l))
 		return EINA_FALSE;
 	if (thiz->src_r)
-		enesim_draw_cache_setup_sw(thiz->cache, ENESIM_FORMAT_ARGB8888, NULL);
+	{
+		if (!enesim_draw_cache_setup_sw(thiz->cache,
+				ENESIM_FORMAT_ARGB8888, NULL))
+		{
+			ENESIM_RENDERER_LOG(r, l, "The cache of the source can not setup");
+			_blur_state_cleanup(thiz, r, s);
+			return EINA_FALSE;
+		}
+	}
 	else
 	{
 		if (!enesim_surface_map(thiz->src, (void **)&thiz->ssrc, &thiz->sstride))
@@ -269,6 +269,88 @@ static void _span_identity(Enesim_Renderer *r,
 	}
 }
 
+/* Without a transformation there are only two different rows, the rows of
+ * a band of cells are copied from the first one filled
+ */
+static void _block_identity(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *ddata, size_t stride)
+{
+	Enesim_Renderer_Checker *thiz;
+	Eina_F16p16 yy, xx;
+	uint8_t *dst = ddata;
+	uint8_t *rows[2] = { NULL, NULL };
+	int h2;
+	int sy;
+
+	thiz = ENESIM_RENDERER_CHECKER(r);
+	h2 = thiz->current.sh * 2;
+
+	enesim_coord_identity_setup(&xx, &yy, x, y, thiz->ox, thiz->oy);
+	sy = ((yy >> 16) % h2);
+	if (sy < 0)
+	{
+		sy += h2;
+	}
+	while (h--)
+	{
+		int swap = sy >= thiz->current.sh;
+
+		if (rows[swap])
+		{
+			memcpy(dst, rows[swap], w * sizeof(uint32_t));
+		}
+		else
+		{
+			_span_identity(r, x, y, w, dst);
+			rows[swap] = dst;
+		}
+		dst += stride;
+		y++;
+		if (++sy == h2)
+			sy = 0;
+	}
+}
+
+/* Without a transformation every cell is a run of a solid color */
+static int _checker_runs(Enesim_Renderer *r, int x, int y, int len,
+		Enesim_Color *color)
+{
+	Enesim_Renderer_Checker *thiz;
+	Eina_F16p16 yy, xx;
+	Eina_Bool odd;
+	int w2;
+	int h2;
+	int sx, sy;
+	int n;
+
+	thiz = ENESIM_RENDERER_CHECKER(r);
+	w2 = thiz->current.sw * 2;
+	h2 = thiz->current.sh * 2;
+
+	/* same as the identity span */
+	enesim_coord_identity_setup(&xx, &yy, x, y, thiz->ox, thiz->oy);
+	sy = ((yy >> 16) % h2);
+	if (sy < 0)
+	{
+		sy += h2;
+	}
+	sx = ((xx >> 16) % w2);
+	if (sx < 0)
+	{
+		sx += w2;
+	}
+	odd = sx < thiz->current.sw;
+	if (sy >= thiz->current.sh)
+		odd = !odd;
+	*color = odd ? thiz->final_color2 : thiz->final_color1;
+
+	/* until the end of the cell */
+	n = sx < thiz->current.sw ? thiz->current.sw - sx : w2 - sx;
+	if (n > len)
+		n = len;
+	return n;
+}
+
 static void _span_affine(Enesim_Renderer *r,
 		int x, int y, int len, void *ddata)
 {
@@ -535,10 +617,29 @@ static void _checker_features_get(Enesim_Renderer *r EINA_UNUSED,
 			ENESIM_RENDERER_FEATURE_ARGB8888;
 }
 
-static void _checker_sw_hints(Enesim_Renderer *r EINA_UNUSED,
+static void _checker_alpha_hints_get(Enesim_Renderer *r,
+		Enesim_Alpha_Hint *hints)
+{
+	Enesim_Renderer_Checker *thiz;
+	Enesim_Color color;
+
+	thiz = ENESIM_RENDERER_CHECKER(r);
+	color = enesim_renderer_color_get(r);
+	/* the pixels between both colors are opaque too */
+	if ((color >> 24) == 0xff && (thiz->current.color1 >> 24) == 0xff &&
+			(thiz->current.color2 >> 24) == 0xff)
+		*hints = ENESIM_ALPHA_HINT_OPAQUE;
+}
+
+static void _checker_sw_hints(Enesim_Renderer *r,
 		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
 {
-	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
+	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE | ENESIM_RENDERER_SW_HINT_FULL_SPAN |
+			ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
+	if (enesim_renderer_transformation_type_get(r) ==
+			ENESIM_MATRIX_TYPE_IDENTITY)
+		*hints |= ENESIM_RENDERER_SW_HINT_RUNS |
+				ENESIM_RENDERER_SW_HINT_BLOCK;
 }
 
 #if BUILD_OPENGL
@@ -593,10 +694,12 @@ static void _enesim_renderer_checker_class_init(void *k)
 	klass->is_inside = NULL;
 	klass->damages_get = NULL;
 	klass->has_changed = _checker_has_changed;
-	klass->alpha_hints_get = NULL;
+	klass->alpha_hints_get = _checker_alpha_hints_get;
 	klass->sw_hints_get = _checker_sw_hints;
 	klass->sw_setup = _checker_sw_setup;
 	klass->sw_cleanup = _checker_sw_cleanup;
+	klass->sw_runs = _checker_runs;
+	klass->sw_fill_block = _block_identity;
 	klass->opencl_setup = NULL;
 	klass->opencl_kernel_setup = NULL;
 	klass->opencl_cleanup =	NULL;
@@ -135,6 +135,25 @@ static Eina_Bool _circle_setup(Enesim_Renderer *r, Enesim_Path *path)
 	return EINA_TRUE;
 }
 
+static Eina_Bool _circle_rounded_get(Enesim_Renderer *r,
+		Enesim_Renderer_Shape_Path_Rounded *rounded)
+{
+	Enesim_Renderer_Circle *thiz;
+	double rad;
+
+	thiz = ENESIM_RENDERER_CIRCLE(r);
+	rad = thiz->current.r;
+	if (rad <= 0)
+		return EINA_FALSE;
+	rounded->x = thiz->current.x - rad;
+	rounded->y = thiz->current.y - rad;
+	rounded->w = rounded->h = rad * 2;
+	rounded->rx = rounded->ry = rad;
+	rounded->tl = rounded->tr = EINA_TRUE;
+	rounded->bl = rounded->br = EINA_TRUE;
+	return EINA_TRUE;
+}
+
 static void _circle_cleanup(Enesim_Renderer *r)
 {
 	Enesim_Renderer_Circle *thiz;
@@ -207,6 +226,7 @@ static void _enesim_renderer_circle_class_init(void *k)
 	klass->has_changed = _circle_has_changed;
 	klass->setup = _circle_setup;
 	klass->cleanup = _circle_cleanup;
+	klass->rounded_get = _circle_rounded_get;
 }
 
 static void _enesim_renderer_circle_instance_init(void *o)
@@ -38,6 +38,7 @@
 #include "enesim_opengl_private.h"
 #endif
 
+#include "enesim_log_private.h"
 #include "enesim_renderer_private.h"
 #include "enesim_buffer_private.h"
 #include "enesim_surface_private.h"
@@ -45,9 +46,8 @@
 /**
  * @todo
  * - Handle the case whenever the renderer supports the ROP itself
- * - Another way to optmize this is to make the setup() function of every
- *   layer thread safe, that way given that each layer does not depend on the other
- *   the setup can be done on parallel
+ * - Find a way to know if the layers share renderers, that way we can
+ *   always do the setup in parallel
  */
 /*============================================================================*
  *                                  Local                                     *
@@ -88,8 +88,20 @@ typedef struct _Enesim_Renderer_Compound
 
 	Eina_Bool changed : 1;
 	Eina_Bool background_enabled : 1;
+	Eina_Bool parallel_setup : 1;
 } Enesim_Renderer_Compound;
 
+/* The data shared between the threads when doing the setup of every
+ * layer in parallel
+ */
+typedef struct _Enesim_Renderer_Compound_Setup
+{
+	Enesim_Renderer_Compound_Layer **layers;
+	Eina_Bool *ret;
+	Enesim_Log **logs;
+	Enesim_Surface *s;
+} Enesim_Renderer_Compound_Setup;
+
 typedef struct _Enesim_Renderer_Compound_Class {
 	Enesim_Renderer_Class parent;
 } Enesim_Renderer_Compound_Class;
@@ -137,11 +149,123 @@ static inline void _compound_layer_span_draw(Enesim_Renderer_Compound_Layer *l,
 	enesim_renderer_sw_draw(l->r, lbounds.x, lbounds.y, lbounds.w, dst + offset);
 }
 
+static void _compound_layer_visible_add(Enesim_Renderer_Compound *thiz,
+		Enesim_Renderer *r, Enesim_Renderer_Compound_Layer *layer)
+{
+	Eina_Bool visible;
+
+	/* set the span given the color */
+	/* FIXME fix the resulting format */
+	/* FIXME what about the surface formats here? */
+	enesim_renderer_destination_bounds_get(layer->r, &layer->destination_bounds, 0, 0);
+	visible = enesim_renderer_visibility_get(layer->r);
+	if (!visible)
+	{
+		DBG("Layer '%s' on '%s' not visible, not adding it",
+				layer->r->name, r->name);
+		return;
+	}
+
+	/* ok the layer pass the whole pre/post/setup process, add it to the visible layers */
+	DBG("Adding layer '%s' on '%s'", layer->r->name, r->name);
+	thiz->visible_layers = eina_list_append(thiz->visible_layers, layer);
+}
+
+static void _compound_layers_setup(Enesim_Renderer_Compound *thiz,
+		Enesim_Renderer *r, Enesim_Surface *s, Enesim_Log **l)
+{
+	Enesim_Renderer_Compound_Layer *layer;
+	Eina_List *ll;
+
+	EINA_LIST_FOREACH(thiz->layers, ll, layer)
+	{
+		if (!enesim_renderer_setup(layer->r, s, layer->rop, l))
+		{
+			ENESIM_RENDERER_LOG(r, l, "Layer '%s' can not setup",
+					enesim_renderer_name_get(layer->r));
+			DBG("Layer '%s' on '%s' failed to setup",
+					layer->r->name, r->name);
+			continue;
+		}
+		_compound_layer_visible_add(thiz, r, layer);
+	}
+}
+
+static void _compound_layer_parallel_setup(void *data, unsigned int idx)
+{
+	Enesim_Renderer_Compound_Setup *setup = data;
+	Enesim_Renderer_Compound_Layer *layer = setup->layers[idx];
+
+	setup->ret[idx] = enesim_renderer_setup(layer->r, setup->s,
+			layer->rop, setup->logs ? &setup->logs[idx] : NULL);
+}
+
+/* Do the setup of every layer on the software workers. The layers are
+ * added to the visible layers on the same order as in the serial case
+ */
+static void _compound_layers_parallel_setup(Enesim_Renderer_Compound *thiz,
+		Enesim_Renderer *r, Enesim_Surface *s, Enesim_Log **l)
+{
+	Enesim_Renderer_Compound_Setup setup;
+	Enesim_Renderer_Compound_Layer *layer;
+	Eina_List *ll;
+	unsigned int count;
+	unsigned int i = 0;
+
+	count = eina_list_count(thiz->layers);
+	if (count < 2)
+	{
+		_compound_layers_setup(thiz, r, s, l);
+		return;
+	}
+
+	setup.layers = malloc(sizeof(Enesim_Renderer_Compound_Layer *) * count);
+	setup.ret = malloc(sizeof(Eina_Bool) * count);
+	/* every layer logs on its own log to not mix the messages */
+	setup.logs = l ? calloc(count, sizeof(Enesim_Log *)) : NULL;
+	if (!setup.layers || !setup.ret || (l && !setup.logs))
+	{
+		DBG("Not enough memory to setup the layers of '%s' in parallel",
+				r->name);
+		free(setup.logs);
+		free(setup.ret);
+		free(setup.layers);
+		_compound_layers_setup(thiz, r, s, l);
+		return;
+	}
+	setup.s = s;
+	EINA_LIST_FOREACH(thiz->layers, ll, layer)
+		setup.layers[i++] = layer;
+
+	enesim_renderer_sw_parallel_run(_compound_layer_parallel_setup,
+			&setup, count);
+
+	for (i = 0; i < count; i++)
+	{
+		layer = setup.layers[i];
+		if (l)
+			*l = enesim_log_join(*l, setup.logs[i]);
+
+		if (!setup.ret[i])
+		{
+			ENESIM_RENDERER_LOG(r, l, "Layer '%s' can not setup",
+					enesim_renderer_name_get(layer->r));
+			DBG("Layer '%s' on '%s' failed to setup",
+					layer->r->name, r->name);
+			continue;
+		}
+		_compound_layer_visible_add(thiz, r, layer);
+	}
+
+	free(setup.logs);
+	free(setup.ret);
+	free(setup.layers);
+}
+
 static Eina_Bool _compound_state_setup(Enesim_Renderer_Compound *thiz,
 		Enesim_Renderer *r, Enesim_Surface *s, Enesim_Rop rop EINA_UNUSED,
 		Enesim_Log **l)
 {
-	Eina_List *ll;
 	Enesim_Renderer_Compound_Layer *layer;
 
 	/* setup the background */
@@ -166,34 +290,10 @@ static Eina_Bool _compound_state_setup(Enesim_Renderer_Compound *thiz,
 		thiz->layers = eina_list_append(thiz->layers, layer);
 	}
 	/* setup every layer */
-	EINA_LIST_FOREACH(thiz->layers, ll, layer)
-	{
-		Eina_Bool visible;
-
-		if (!enesim_renderer_setup(layer->r, s, layer->rop, l))
-		{
-			ENESIM_RENDERER_LOG(r, l, "Layer '%s' can not setup",
-					enesim_renderer_name_get(layer->r));
-			DBG("Layer '%s' on '%s' failed to setup",
-					layer->r->name, r->name);
-			continue;
-		}
-		/* set the span given the color */
-		/* FIXME fix the resulting format */
-		/* FIXME what about the surface formats here? */
-		enesim_renderer_destination_bounds_get(layer->r, &layer->destination_bounds, 0, 0);
-		visible = enesim_renderer_visibility_get(layer->r);
-		if (!visible)
-		{
-			DBG("Layer '%s' on '%s' not visible, not adding it",
-					layer->r->name, r->name);
-			continue;
-		}
-
-		/* ok the layer pass the whole pre/post/setup process, add it to the visible layers */
-		DBG("Adding layer '%s' on '%s'", layer->r->name, r->name);
-		thiz->visible_layers = eina_list_append(thiz->visible_layers, layer);
-	}
+	if (thiz->parallel_setup && enesim_surface_backend_get(s) == ENESIM_BACKEND_SOFTWARE)
+		_compound_layers_parallel_setup(thiz, r, s, l);
+	else
+		_compound_layers_setup(thiz, r, s, l);
 
 	return EINA_TRUE;
 }
@@ -1101,3 +1201,35 @@ EAPI Enesim_Color enesim_renderer_compound_background_color_get(Enesim_Renderer
 	thiz = ENESIM_RENDERER_COMPOUND(r);
 	return enesim_renderer_background_color_get(thiz->background.r);
 }
+
+/**
+ * @brief Enables or disables the setup of the layers in parallel
+ * @ender_prop{parallel_setup}
+ * @param[in] r The compound renderer
+ * @param[in] enable @c EINA_TRUE to enable, @c EINA_FALSE to disable
+ *
+ * When enabled, the setup of every layer is done on the software workers
+ * instead of one layer after the other. Only enable it when the layers
+ * do not share any renderer, including their fill or mask renderers.
+ */
+EAPI void enesim_renderer_compound_parallel_setup_set(Enesim_Renderer *r, Eina_Bool enable)
+{
+	Enesim_Renderer_Compound *thiz;
+
+	thiz = ENESIM_RENDERER_COMPOUND(r);
+	thiz->parallel_setup = enable;
+}
+
+/**
+ * @brief Gets the parallel setup flag of the layers
+ * @ender_prop{parallel_setup}
+ * @param[in] r The compound renderer
+ * @return @c EINA_TRUE if the parallel setup is enabled, @c EINA_FALSE otherwise
+ */
+EAPI Eina_Bool enesim_renderer_compound_parallel_setup_get(Enesim_Renderer *r)
+{
+	Enesim_Renderer_Compound *thiz;
+
+	thiz = ENESIM_RENDERER_COMPOUND(r);
+	return thiz->parallel_setup;
+}
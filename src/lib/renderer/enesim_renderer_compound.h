@@ -73,6 +73,9 @@ EAPI Eina_Bool enesim_renderer_compound_background_enable_get(Enesim_Renderer *r
 
 EAPI void enesim_renderer_compound_background_color_set(Enesim_Renderer *r, Enesim_Color color);
 EAPI Enesim_Color enesim_renderer_compound_background_color_get(Enesim_Renderer *r);
+
+EAPI void enesim_renderer_compound_parallel_setup_set(Enesim_Renderer *r, Eina_Bool enable);
+EAPI Eina_Bool enesim_renderer_compound_parallel_setup_get(Enesim_Renderer *r);
 /**
  * @}
  */
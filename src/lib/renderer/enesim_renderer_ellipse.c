@@ -151,6 +151,26 @@ static Eina_Bool _ellipse_setup(Enesim_Renderer *r, Enesim_Path *path)
 	return EINA_TRUE;
 }
 
+static Eina_Bool _ellipse_rounded_get(Enesim_Renderer *r,
+		Enesim_Renderer_Shape_Path_Rounded *rounded)
+{
+	Enesim_Renderer_Ellipse *thiz;
+
+	thiz = ENESIM_RENDERER_ELLIPSE(r);
+	/* same as the setup */
+	if ((thiz->current.rx <= 0) || (thiz->current.ry <= 0))
+		return EINA_FALSE;
+	rounded->x = thiz->current.x - thiz->current.rx;
+	rounded->y = thiz->current.y - thiz->current.ry;
+	rounded->w = thiz->current.rx * 2;
+	rounded->h = thiz->current.ry * 2;
+	rounded->rx = thiz->current.rx;
+	rounded->ry = thiz->current.ry;
+	rounded->tl = rounded->tr = EINA_TRUE;
+	rounded->bl = rounded->br = EINA_TRUE;
+	return EINA_TRUE;
+}
+
 static void _ellipse_cleanup(Enesim_Renderer *r)
 {
 	Enesim_Renderer_Ellipse *thiz;
@@ -221,6 +241,7 @@ static void _enesim_renderer_ellipse_class_init(void *k)
 	klass->has_changed = _ellipse_has_changed;
 	klass->setup = _ellipse_setup;
 	klass->cleanup = _ellipse_cleanup;
+	klass->rounded_get = _ellipse_rounded_get;
 }
 
 static void _enesim_renderer_ellipse_instance_init(void *o)
@@ -264,6 +264,28 @@ static void _gradient_features_get(Enesim_Renderer *r EINA_UNUSED,
 			ENESIM_RENDERER_FEATURE_ARGB8888;
 }
 
+static void _gradient_sw_fill_block(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *ddata, size_t stride)
+{
+	Enesim_Renderer_Gradient_Class *klass;
+
+	klass = ENESIM_RENDERER_GRADIENT_CLASS_GET(r);
+	klass->sw_fill_block(r, x, y, w, h, ddata, stride);
+}
+
+static void _gradient_sw_hints(Enesim_Renderer *r,
+		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
+{
+	Enesim_Renderer_Gradient_Class *klass;
+
+	*hints = ENESIM_RENDERER_SW_HINT_FULL_SPAN |
+			ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
+	klass = ENESIM_RENDERER_GRADIENT_CLASS_GET(r);
+	if (klass->sw_fill_block && enesim_renderer_transformation_type_get(r) ==
+			ENESIM_MATRIX_TYPE_IDENTITY)
+		*hints |= ENESIM_RENDERER_SW_HINT_BLOCK;
+}
+
 static Eina_Bool _gradient_has_changed(Enesim_Renderer *r)
 {
 	Enesim_Renderer_Gradient *thiz;
@@ -355,6 +377,8 @@ static void _enesim_renderer_gradient_class_init(void *k)
 	klass->has_changed = _gradient_has_changed;
 	klass->sw_setup = _gradient_sw_setup;
 	klass->sw_cleanup = _gradient_sw_cleanup;
+	klass->sw_hints_get = _gradient_sw_hints;
+	klass->sw_fill_block = _gradient_sw_fill_block;
 #if BUILD_OPENGL
 	klass->opengl_setup = _gradient_opengl_setup;
 	klass->opengl_cleanup = _gradient_opengl_cleanup;
@@ -246,6 +246,42 @@ GRADIENT_PROJECTIVE(Enesim_Renderer_Gradient_Linear, ENESIM_RENDERER_GRADIENT_LI
 GRADIENT_PROJECTIVE(Enesim_Renderer_Gradient_Linear, ENESIM_RENDERER_GRADIENT_LINEAR, _linear_distance, pad);
 GRADIENT_PROJECTIVE(Enesim_Renderer_Gradient_Linear, ENESIM_RENDERER_GRADIENT_LINEAR, _linear_distance, reflect);
 
+/* An horizontal gradient has every row equal and a vertical one has every
+ * row of a single color
+ */
+static void _linear_block_identity(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *ddata, size_t stride)
+{
+	Enesim_Renderer_Gradient_Linear *thiz;
+	Enesim_Renderer_Sw_Fill fill;
+	uint8_t *dst = ddata;
+	int i;
+
+	thiz = ENESIM_RENDERER_GRADIENT_LINEAR(r);
+	fill = _spans[enesim_renderer_gradient_repeat_mode_get(r)][ENESIM_MATRIX_TYPE_IDENTITY];
+	for (i = 0; i < h; i++)
+	{
+		uint32_t *d = (uint32_t *)dst;
+
+		if (i && !thiz->sw.ayy)
+		{
+			memcpy(d, ddata, w * sizeof(uint32_t));
+		}
+		else if (!thiz->sw.ayx)
+		{
+			int j;
+
+			fill(r, x, y + i, 1, d);
+			for (j = 1; j < w; j++)
+				d[j] = d[0];
+		}
+		else
+		{
+			fill(r, x, y + i, w, d);
+		}
+		dst += stride;
+	}
+}
 
 static Eina_Bool _linear_setup(Enesim_Renderer *r, Enesim_Matrix *m,
 		double *ayx, double *ayy, double *scale)
@@ -444,6 +480,7 @@ static void _enesim_renderer_gradient_linear_class_init(void *k)
 	klass->has_changed = _linear_has_changed;
 	klass->sw_setup = _linear_sw_setup;
 	klass->sw_cleanup = _linear_sw_cleanup;
+	klass->sw_fill_block = _linear_block_identity;
 #if BUILD_OPENGL
 	klass->opengl_setup = _linear_opengl_setup;
 	klass->opengl_cleanup = _linear_opengl_cleanup;
@@ -270,6 +270,8 @@ typedef struct _Enesim_Renderer_Gradient_Class
 	/* software based functions */
 	Enesim_Renderer_Sw_Setup sw_setup;
 	Enesim_Renderer_Sw_Cleanup sw_cleanup;
+	/* to fill blocks without a transformation */
+	Enesim_Renderer_Sw_Fill_Block sw_fill_block;
 	/* opengl based functions */
 	Enesim_Renderer_OpenGL_Setup opengl_setup;
 	Enesim_Renderer_OpenGL_Cleanup opengl_cleanup;
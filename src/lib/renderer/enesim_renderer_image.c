@@ -84,6 +84,10 @@ typedef struct _Enesim_Renderer_Image
 	Eina_F16p16 nxx, nyy;
 	Enesim_Matrix_F16p16 matrix;
 	Enesim_Compositor_Span span;
+	/* to copy the pixels directly on a destination bigger than the cache */
+	Enesim_Compositor_Span stream_span;
+	uint8_t *dst;
+	uint8_t *dst_end;
 #if BUILD_OPENGL
 	struct {
 		Enesim_Surface *s;
@@ -91,6 +95,8 @@ typedef struct _Enesim_Renderer_Image
 #endif
 	Eina_List *surface_damages;
 	Eina_Bool simple : 1;
+	/* the identity fill can fill blocks too */
+	Eina_Bool block : 1;
 	Eina_Bool changed : 1;
 	Eina_Bool src_changed : 1;
 } Enesim_Renderer_Image;
@@ -482,7 +488,65 @@ static void _argb8888_image_no_scale_identity(Enesim_Renderer *r,
 		len = thiz->sw - x;
 	}
 	src = argb8888_at(src, thiz->sstride, x, y);
-	thiz->span(dst, len, src, thiz->color, NULL);
+	/* the spans of other renderers stay on the cache */
+	if (thiz->stream_span && (uint8_t *)dst >= thiz->dst &&
+			(uint8_t *)dst < thiz->dst_end)
+		thiz->stream_span(dst, len, src, thiz->color, NULL);
+	else
+		thiz->span(dst, len, src, thiz->color, NULL);
+}
+
+/* The same as the identity span for every row of the block, the clipping
+ * against the image columns is only done once
+ */
+static void _argb8888_image_no_scale_identity_block(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *ddata, size_t stride)
+{
+	Enesim_Renderer_Image *thiz = ENESIM_RENDERER_IMAGE(r);
+	Enesim_Compositor_Span span;
+	uint32_t *src;
+	uint8_t *dst = ddata;
+	int left, len;
+
+	x -= eina_f16p16_int_to(thiz->ixx);
+	y -= eina_f16p16_int_to(thiz->iyy);
+
+	if ((x >= thiz->sw) || (x + w <= 0) || !thiz->color)
+	{
+		while (h--)
+		{
+			memset(dst, 0, sizeof(unsigned int) * w);
+			dst += stride;
+		}
+		return;
+	}
+	left = x < 0 ? -x : 0;
+	len = w - left;
+	if (len > thiz->sw - (x + left))
+		len = thiz->sw - (x + left);
+	span = thiz->span;
+	if (thiz->stream_span && dst >= thiz->dst && dst < thiz->dst_end)
+		span = thiz->stream_span;
+
+	while (h--)
+	{
+		uint32_t *d = (uint32_t *)dst;
+
+		if ((y < 0) || (y >= thiz->sh))
+		{
+			memset(d, 0, sizeof(unsigned int) * w);
+		}
+		else
+		{
+			src = argb8888_at(thiz->src, thiz->sstride, x + left, y);
+			memset(d, 0, sizeof(unsigned int) * left);
+			span(d + left, len, src, thiz->color, NULL);
+			memset(d + left + len, 0, sizeof(unsigned int) *
+					(w - left - len));
+		}
+		dst += stride;
+		y++;
+	}
 }
 
 static void _argb8888_image_no_scale_affine(Enesim_Renderer *r,
@@ -1475,11 +1539,13 @@ static void _image_sw_state_cleanup(Enesim_Renderer *r, Enesim_Surface *s EINA_U
 	if (thiz->current.s)
 		enesim_surface_unmap(thiz->current.s, (void **)(&thiz->src), EINA_FALSE);
 	thiz->span = NULL;
+	thiz->stream_span = NULL;
+	thiz->block = EINA_FALSE;
 	_image_state_cleanup(r);
 }
 
 static Eina_Bool _image_sw_state_setup(Enesim_Renderer *r,
-		Enesim_Surface *s EINA_UNUSED, Enesim_Rop rop, 
+		Enesim_Surface *s, Enesim_Rop rop, 
 		Enesim_Renderer_Sw_Fill *fill, Enesim_Log **l EINA_UNUSED)
 {
 	Enesim_Renderer_Image *thiz;
@@ -1487,6 +1553,7 @@ static Eina_Bool _image_sw_state_setup(Enesim_Renderer *r,
 	Enesim_Matrix m;
 	Enesim_Matrix_Type mtype;
 	Enesim_Quality quality;
+	size_t dstride;
 	double x, y, w, h;
 	double ox, oy;
 
@@ -1602,6 +1669,23 @@ static Eina_Bool _image_sw_state_setup(Enesim_Renderer *r,
 			if (rop == ENESIM_ROP_BLEND)
 				*fill = _argb8888_blend_span;
 		}
+		thiz->block = (*fill == _argb8888_image_no_scale_identity);
+		/* a copy on a big surface is done with streaming stores */
+		thiz->stream_span = NULL;
+		if (mtype == ENESIM_MATRIX_TYPE_IDENTITY &&
+				rop == ENESIM_ROP_FILL &&
+				thiz->color == ENESIM_COLOR_FULL &&
+				enesim_surface_format_get(s) == ENESIM_FORMAT_ARGB8888 &&
+				enesim_surface_sw_data_get(s, (void **)&thiz->dst,
+				&dstride))
+		{
+			int dh;
+
+			enesim_surface_size_get(s, NULL, &dh);
+			thiz->dst_end = thiz->dst + dstride * dh;
+			thiz->stream_span = enesim_compositor_span_stream_get(fmt,
+					ENESIM_FORMAT_ARGB8888, dstride * dh);
+		}
 	}
 
 	return EINA_TRUE;
@@ -1619,15 +1703,15 @@ static void _image_features_get(Enesim_Renderer *r EINA_UNUSED,
 static void _image_sw_image_hints(Enesim_Renderer *r, Enesim_Rop rop,
 		Enesim_Renderer_Sw_Hint *hints)
 {
-	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
-	if (rop != ENESIM_ROP_FILL)
-	{
-		Enesim_Renderer_Image *thiz = ENESIM_RENDERER_IMAGE(r);
-
-		if (thiz->span)
-			*hints |= ENESIM_RENDERER_SW_HINT_ROP;
-	}
+	Enesim_Renderer_Image *thiz = ENESIM_RENDERER_IMAGE(r);
 
+	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE |
+			ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
+	/* only the blend is done directly */
+	if (rop == ENESIM_ROP_BLEND && thiz->span)
+		*hints |= ENESIM_RENDERER_SW_HINT_ROP;
+	if (thiz->block)
+		*hints |= ENESIM_RENDERER_SW_HINT_BLOCK;
 }
 
 static Eina_Bool _image_has_changed(Enesim_Renderer *r)
@@ -1760,6 +1844,7 @@ static void _enesim_renderer_image_class_init(void *k)
 	klass->sw_hints_get = _image_sw_image_hints;
 	klass->sw_setup = _image_sw_state_setup;
 	klass->sw_cleanup = _image_sw_state_cleanup;
+	klass->sw_fill_block = _argb8888_image_no_scale_identity_block;
 #if BUILD_OPENGL
 	klass->opengl_initialize = _image_opengl_initialize;
 	klass->opengl_setup = _image_opengl_setup;
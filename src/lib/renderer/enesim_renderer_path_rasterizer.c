@@ -68,6 +68,11 @@ typedef struct _Enesim_Renderer_Path_Enesim
 	/* properties */
 	/* private */
 	Enesim_Renderer *bifigure;
+	/* the exact area rasterizer, used on the good quality */
+	Enesim_Renderer *coverage;
+	const Enesim_Figure *coverage_figure;
+	/* the rasterizer that draws */
+	Enesim_Renderer *current;
 } Enesim_Renderer_Path_Enesim;
 
 typedef struct _Enesim_Renderer_Path_Enesim_Class
@@ -81,7 +86,7 @@ static void _enesim_renderer_path_rasterizer_span(Enesim_Renderer *r,
 	Enesim_Renderer_Path_Enesim *thiz;
 
 	thiz = ENESIM_RENDERER_PATH_ENESIM(r);
-	enesim_renderer_sw_draw(thiz->bifigure, x, y, len, ddata);
+	enesim_renderer_sw_draw(thiz->current, x, y, len, ddata);
 }
 
 static void _enesim_renderer_path_rasterizer_generate_figures(Enesim_Renderer *r)
@@ -104,6 +109,69 @@ static void _enesim_renderer_path_rasterizer_generate_figures(Enesim_Renderer *r
 	/* set the stroke figure on the bifigure as its over polys */
 	enesim_rasterizer_bifigure_over_figure_set(thiz->bifigure, parent->stroke_figure_used ? parent->stroke_figure : NULL);
 #endif
+	/* the figures have changed */
+	thiz->coverage_figure = NULL;
+}
+
+/* The coverage rasterizer only fills a figure, so it can draw the fill and
+ * the generated stroke, but not both at once or the thin strokes
+ */
+static const Enesim_Figure * _enesim_renderer_path_rasterizer_coverage_figure_get(
+		Enesim_Renderer *r)
+{
+	Enesim_Renderer_Path_Abstract *parent;
+	const Enesim_Renderer_State *cs;
+	const Enesim_Renderer_Shape_State *css;
+
+	parent = ENESIM_RENDERER_PATH_ABSTRACT(r);
+	cs = enesim_renderer_state_get(r);
+	css = enesim_renderer_shape_state_get(r);
+
+	if (WIREFRAME || cs->current.quality != ENESIM_QUALITY_GOOD)
+		return NULL;
+	if (css->current.draw_mode == ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL)
+		return parent->fill_figure;
+	if (css->current.draw_mode == ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE &&
+			parent->stroke_figure_used)
+		return parent->stroke_figure;
+	return NULL;
+}
+
+static Eina_Bool _enesim_renderer_path_rasterizer_coverage_setup(
+		Enesim_Renderer *r, const Enesim_Figure *figure,
+		Enesim_Surface *s, Enesim_Rop rop, Enesim_Log **l)
+{
+	Enesim_Renderer_Path_Enesim *thiz;
+	const Enesim_Renderer_State *cs;
+	const Enesim_Renderer_Shape_State *css;
+
+	thiz = ENESIM_RENDERER_PATH_ENESIM(r);
+	cs = enesim_renderer_state_get(r);
+	css = enesim_renderer_shape_state_get(r);
+
+	if (figure != thiz->coverage_figure)
+	{
+		enesim_rasterizer_figure_set(thiz->coverage, figure);
+		thiz->coverage_figure = figure;
+	}
+	enesim_renderer_shape_draw_mode_set(thiz->coverage, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+	/* the stroke is filled with its own color and renderer */
+	if (css->current.draw_mode == ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE)
+	{
+		enesim_renderer_shape_fill_color_set(thiz->coverage, css->current.stroke.color);
+		enesim_renderer_shape_fill_renderer_set(thiz->coverage, enesim_renderer_ref(css->current.stroke.r));
+		enesim_renderer_shape_fill_rule_set(thiz->coverage, ENESIM_RENDERER_SHAPE_FILL_RULE_NON_ZERO);
+	}
+	else
+	{
+		enesim_renderer_shape_fill_color_set(thiz->coverage, css->current.fill.color);
+		enesim_renderer_shape_fill_renderer_set(thiz->coverage, enesim_renderer_ref(css->current.fill.r));
+		enesim_renderer_shape_fill_rule_set(thiz->coverage, css->current.fill.rule);
+	}
+	enesim_renderer_color_set(thiz->coverage, cs->current.color);
+	enesim_renderer_origin_set(thiz->coverage, cs->current.ox, cs->current.oy);
+
+	return enesim_renderer_setup(thiz->coverage, s, rop, l);
 }
 
 /*----------------------------------------------------------------------------*
@@ -137,6 +205,7 @@ static Eina_Bool _enesim_renderer_path_rasterizer_sw_setup(Enesim_Renderer *r, E
 	Enesim_Renderer_Shape *bifigure_shape;
 	const Enesim_Renderer_State *cs;
 	const Enesim_Renderer_Shape_State *css;
+	const Enesim_Figure *figure;
 	double swx, swy;
 
 	thiz = ENESIM_RENDERER_PATH_ENESIM(r);
@@ -149,6 +218,16 @@ static Eina_Bool _enesim_renderer_path_rasterizer_sw_setup(Enesim_Renderer *r, E
 		_enesim_renderer_path_rasterizer_generate_figures(r);
 	}
 
+	figure = _enesim_renderer_path_rasterizer_coverage_figure_get(r);
+	if (figure)
+	{
+		thiz->current = thiz->coverage;
+		if (!_enesim_renderer_path_rasterizer_coverage_setup(r, figure, s, rop, l))
+			return EINA_FALSE;
+		*draw = _enesim_renderer_path_rasterizer_span;
+		return EINA_TRUE;
+	}
+
 #if WIREFRAME
 	enesim_renderer_shape_draw_mode_set(thiz->bifigure, ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE);
 #else
@@ -178,6 +257,7 @@ static Eina_Bool _enesim_renderer_path_rasterizer_sw_setup(Enesim_Renderer *r, E
 	bifigure_shape->state.dashes = enesim_list_ref(css->dashes);
 
 	/* finally do the setup */
+	thiz->current = thiz->bifigure;
 	if (!enesim_renderer_setup(thiz->bifigure, s, rop, l))
 	{
 		return EINA_FALSE;
@@ -193,7 +273,11 @@ static void _enesim_renderer_path_rasterizer_sw_cleanup(Enesim_Renderer *r, Enes
 	Enesim_Renderer_Path_Enesim *thiz;
 
 	thiz = ENESIM_RENDERER_PATH_ENESIM(r);
-	enesim_renderer_cleanup(thiz->bifigure, s);
+	if (thiz->current)
+	{
+		enesim_renderer_cleanup(thiz->current, s);
+		thiz->current = NULL;
+	}
 	enesim_renderer_path_abstract_cleanup(r);
 }
 /*----------------------------------------------------------------------------*
@@ -209,6 +293,7 @@ static void _enesim_renderer_path_rasterizer_features_get(Enesim_Renderer *r EIN
 {
 	*features = ENESIM_RENDERER_FEATURE_TRANSLATE |
 			ENESIM_RENDERER_FEATURE_AFFINE |
+			ENESIM_RENDERER_FEATURE_QUALITY |
 			ENESIM_RENDERER_FEATURE_BACKEND_SOFTWARE |
 			ENESIM_RENDERER_FEATURE_ARGB8888;
 }
@@ -330,6 +415,7 @@ static void _enesim_renderer_path_enesim_instance_init(void *o)
 
 	r = enesim_rasterizer_bifigure_new();
 	thiz->bifigure = r;
+	thiz->coverage = enesim_rasterizer_coverage_new();
 
 	/* FIXME for now */
 	enesim_renderer_shape_stroke_join_set(ENESIM_RENDERER(o), ENESIM_RENDERER_SHAPE_STROKE_JOIN_ROUND);
@@ -343,6 +429,8 @@ static void _enesim_renderer_path_enesim_instance_deinit(void *o)
 	thiz = ENESIM_RENDERER_PATH_ENESIM(o);
 	if (thiz->bifigure)
 		enesim_renderer_unref(thiz->bifigure);
+	if (thiz->coverage)
+		enesim_renderer_unref(thiz->coverage);
 }
 /*============================================================================*
  *                                 Global                                     *
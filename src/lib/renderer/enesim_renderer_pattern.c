@@ -249,6 +249,34 @@ PATTERN_AFFINE(repeat)
 PATTERN_AFFINE(restrict)
 
 static Enesim_Renderer_Sw_Fill  _spans[ENESIM_REPEAT_MODE_LAST][ENESIM_MATRIX_TYPE_LAST];
+
+/* Without a transformation the rows repeat with the source, the rows of a
+ * block after the first period are copied
+ */
+static void _pattern_block_identity(Enesim_Renderer *r,
+		int x, int y, int w, int h, void *ddata, size_t stride)
+{
+	Enesim_Renderer_Pattern *thiz;
+	Enesim_Renderer_Sw_Fill fill;
+	uint8_t *dst = ddata;
+	int period;
+	int i;
+
+	thiz = ENESIM_RENDERER_PATTERN(r);
+	fill = _spans[thiz->current.repeat_mode][ENESIM_MATRIX_TYPE_IDENTITY];
+	period = thiz->src_h;
+	if (thiz->current.repeat_mode == ENESIM_REPEAT_MODE_REFLECT)
+		period *= 2;
+	for (i = 0; i < h; i++)
+	{
+		if (i >= period)
+			memcpy(dst, dst - period * stride,
+					w * sizeof(uint32_t));
+		else
+			fill(r, x, y + i, w, dst);
+		dst += stride;
+	}
+}
 /*----------------------------------------------------------------------------*
  *                      The Enesim's renderer interface                       *
  *----------------------------------------------------------------------------*/
@@ -294,6 +322,15 @@ static void _pattern_sw_cleanup(Enesim_Renderer *r, Enesim_Surface *s)
 	_pattern_state_cleanup(r, s);
 }
 
+static void _pattern_sw_hints(Enesim_Renderer *r,
+		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
+{
+	*hints = 0;
+	if (enesim_renderer_transformation_type_get(r) ==
+			ENESIM_MATRIX_TYPE_IDENTITY)
+		*hints |= ENESIM_RENDERER_SW_HINT_BLOCK;
+}
+
 static void _pattern_features_get(Enesim_Renderer *r EINA_UNUSED,
 		Enesim_Renderer_Feature *features)
 {
@@ -347,7 +384,9 @@ static void _enesim_renderer_pattern_class_init(void *k)
 	klass->features_get = _pattern_features_get;
 	klass->has_changed = _pattern_has_changed;
 	klass->sw_setup = _pattern_sw_setup;
+	klass->sw_hints_get = _pattern_sw_hints;
 	klass->sw_cleanup = _pattern_sw_cleanup;
+	klass->sw_fill_block = _pattern_block_identity;
 	memset(_spans, 0, sizeof(_spans));
 	_spans[ENESIM_REPEAT_MODE_REPEAT][ENESIM_MATRIX_TYPE_IDENTITY] = _enesim_renderer_pattern_argb8888_repeat_identity_span;
 	_spans[ENESIM_REPEAT_MODE_REFLECT][ENESIM_MATRIX_TYPE_IDENTITY] = _enesim_renderer_pattern_argb8888_reflect_identity_span;
@@ -195,7 +195,8 @@ static Eina_Bool _perlin_has_changed(Enesim_Renderer *r)
 static void _perlin_sw_hints_get(Enesim_Renderer *r EINA_UNUSED,
 		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
 {
-	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
+	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE | ENESIM_RENDERER_SW_HINT_FULL_SPAN |
+			ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
 }
 
 /*----------------------------------------------------------------------------*
@@ -228,6 +228,28 @@ static Eina_Bool _rectangle_setup(Enesim_Renderer *r, Enesim_Path *path)
 	return EINA_TRUE;
 }
 
+static Eina_Bool _rectangle_rounded_get(Enesim_Renderer *r,
+		Enesim_Renderer_Shape_Path_Rounded *rounded)
+{
+	Enesim_Renderer_Rectangle *thiz;
+
+	thiz = ENESIM_RENDERER_RECTANGLE(r);
+	/* same as the setup */
+	if ((thiz->current.width < 1) || (thiz->current.height < 1))
+		return EINA_FALSE;
+	rounded->x = thiz->current.x;
+	rounded->y = thiz->current.y;
+	rounded->w = thiz->current.width;
+	rounded->h = thiz->current.height;
+	rounded->rx = thiz->current.corner.rx;
+	rounded->ry = thiz->current.corner.ry;
+	rounded->tl = thiz->current.corner.tl;
+	rounded->tr = thiz->current.corner.tr;
+	rounded->bl = thiz->current.corner.bl;
+	rounded->br = thiz->current.corner.br;
+	return EINA_TRUE;
+}
+
 static void _rectangle_cleanup(Enesim_Renderer *r)
 {
 	Enesim_Renderer_Rectangle *thiz;
@@ -297,6 +319,7 @@ static void _enesim_renderer_rectangle_class_init(void *k)
 	klass->has_changed = _rectangle_has_changed;
 	klass->setup = _rectangle_setup;
 	klass->cleanup = _rectangle_cleanup;
+	klass->rounded_get = _rectangle_rounded_get;
 }
 
 static void _enesim_renderer_rectangle_instance_init(void *o)
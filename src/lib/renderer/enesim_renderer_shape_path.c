@@ -19,6 +19,7 @@
  * here for simple usage
  */
 #include "enesim_private.h"
+#include "libargb.h"
 
 #include "enesim_main.h"
 #include "enesim_log.h"
@@ -47,6 +48,438 @@
 /** @cond internal */
 #define ENESIM_LOG_DEFAULT enesim_log_renderer_shape
 
+/* The biggest shape drawn without the path, in pixels */
+#define ENESIM_RENDERER_SHAPE_PATH_ANALYTIC_MAX 32768
+
+/* The shapes that are a rectangle with elliptic corners and that are only
+ * scaled are drawn without generating the path. The area of the shape on a
+ * pixel has a closed form, the area of the rectangle minus the part of every
+ * corner box outside of its ellipse. The coverage of the pixels on the sides
+ * of every row is kept on a table, the rest of the row is a constant run
+ */
+typedef struct _Enesim_Renderer_Shape_Path_Corner
+{
+	/* the box of the corner */
+	double x0, y0, x1, y1;
+	/* the center of the ellipse */
+	double cx, cy;
+} Enesim_Renderer_Shape_Path_Corner;
+
+typedef struct _Enesim_Renderer_Shape_Path_Row
+{
+	/* the first pixel with coverage */
+	int x;
+	/* the pixels on the left with their own coverage */
+	int left;
+	/* the constant run after them */
+	int len;
+	int a;
+	/* the pixels on the right with their own coverage */
+	int right;
+	/* where the coverage of the left and right pixels is */
+	int offset;
+} Enesim_Renderer_Shape_Path_Row;
+
+struct _Enesim_Renderer_Shape_Path_Analytic
+{
+	/* the shape on the destination */
+	Enesim_Renderer_Shape_Path_Rounded rounded;
+	Enesim_Renderer_Shape_Path_Corner corners[4];
+	int ncorners;
+	/* the table */
+	Enesim_Renderer_Shape_Path_Row *rows;
+	int y;
+	int nrows;
+	int arows;
+	uint16_t *coverages;
+	int acoverages;
+	Eina_Bool generated;
+	/* the draw state */
+	Eina_Bool used;
+	Enesim_Color color;
+	Enesim_Renderer *fill_r;
+};
+
+/* The area of the unit circle on the left of x and above y */
+static double _shape_path_analytic_circle_area(double x, double y)
+{
+	double area;
+	double c;
+	double lo, hi;
+
+	if ((x <= -1) || (y <= -1))
+		return 0;
+	if (x > 1)
+		x = 1;
+	if (y > 1)
+		y = 1;
+	/* the whole columns on the left of x */
+	area = (x * sqrt(1 - x * x) + asin(x)) + M_PI / 2;
+	/* the columns between -c and c are cut by y */
+	c = sqrt(1 - y * y);
+	lo = -c;
+	hi = x < c ? x : c;
+	if (hi > lo)
+	{
+		double cut;
+
+		cut = ((hi * sqrt(1 - hi * hi) + asin(hi)) -
+				(lo * sqrt(1 - lo * lo) + asin(lo))) / 2;
+		if (y >= 0)
+			area -= cut - y * (hi - lo);
+		else
+			area = cut + y * (hi - lo);
+	}
+	else if (y < 0)
+	{
+		area = 0;
+	}
+	return area;
+}
+
+/* The area of a box inside the ellipse of a corner */
+static double _shape_path_analytic_ellipse_area(
+		const Enesim_Renderer_Shape_Path_Analytic *thiz,
+		const Enesim_Renderer_Shape_Path_Corner *c,
+		double x0, double y0, double x1, double y1)
+{
+	double rx = thiz->rounded.rx;
+	double ry = thiz->rounded.ry;
+
+	x0 = (x0 - c->cx) / rx;
+	x1 = (x1 - c->cx) / rx;
+	y0 = (y0 - c->cy) / ry;
+	y1 = (y1 - c->cy) / ry;
+	return rx * ry * (_shape_path_analytic_circle_area(x1, y1) -
+			_shape_path_analytic_circle_area(x0, y1) -
+			_shape_path_analytic_circle_area(x1, y0) +
+			_shape_path_analytic_circle_area(x0, y0));
+}
+
+/* The coverage of the shape on a box, from 0 to 256 */
+static int _shape_path_analytic_coverage(
+		const Enesim_Renderer_Shape_Path_Analytic *thiz,
+		double x0, double y0, double x1, double y1)
+{
+	const Enesim_Renderer_Shape_Path_Rounded *rd = &thiz->rounded;
+	double area;
+	int a;
+	int i;
+
+	if (x0 < rd->x)
+		x0 = rd->x;
+	if (y0 < rd->y)
+		y0 = rd->y;
+	if (x1 > rd->x + rd->w)
+		x1 = rd->x + rd->w;
+	if (y1 > rd->y + rd->h)
+		y1 = rd->y + rd->h;
+	if ((x1 <= x0) || (y1 <= y0))
+		return 0;
+
+	area = (x1 - x0) * (y1 - y0);
+	for (i = 0; i < thiz->ncorners; i++)
+	{
+		const Enesim_Renderer_Shape_Path_Corner *c = &thiz->corners[i];
+		double cx0 = x0 > c->x0 ? x0 : c->x0;
+		double cy0 = y0 > c->y0 ? y0 : c->y0;
+		double cx1 = x1 < c->x1 ? x1 : c->x1;
+		double cy1 = y1 < c->y1 ? y1 : c->y1;
+
+		if ((cx1 <= cx0) || (cy1 <= cy0))
+			continue;
+		area -= (cx1 - cx0) * (cy1 - cy0) -
+				_shape_path_analytic_ellipse_area(thiz, c,
+				cx0, cy0, cx1, cy1);
+	}
+	a = area * 256 + 0.5;
+	if (a < 0)
+		return 0;
+	if (a > 256)
+		return 256;
+	return a;
+}
+
+/* The x of a side of the shape at y, dir is 1 for the left side and -1 for
+ * the right one
+ */
+static double _shape_path_analytic_side(
+		const Enesim_Renderer_Shape_Path_Rounded *rd,
+		Eina_Bool top, Eina_Bool bottom, double x, double dir,
+		double y)
+{
+	double t;
+
+	if (top && (y < rd->y + rd->ry))
+		t = (rd->y + rd->ry - y) / rd->ry;
+	else if (bottom && (y > rd->y + rd->h - rd->ry))
+		t = (y - (rd->y + rd->h - rd->ry)) / rd->ry;
+	else
+		return x;
+	t = 1 - t * t;
+	if (t < 0)
+		t = 0;
+	return x + dir * rd->rx * (1 - sqrt(t));
+}
+
+static void _shape_path_analytic_corner_add(
+		Enesim_Renderer_Shape_Path_Analytic *thiz,
+		double x0, double y0, double cx, double cy)
+{
+	Enesim_Renderer_Shape_Path_Corner *c;
+
+	c = &thiz->corners[thiz->ncorners++];
+	c->x0 = x0;
+	c->y0 = y0;
+	c->x1 = x0 + thiz->rounded.rx;
+	c->y1 = y0 + thiz->rounded.ry;
+	c->cx = cx;
+	c->cy = cy;
+}
+
+static Eina_Bool _shape_path_analytic_generate(
+		Enesim_Renderer_Shape_Path_Analytic *thiz)
+{
+	const Enesim_Renderer_Shape_Path_Rounded *rd = &thiz->rounded;
+	double x0 = rd->x;
+	double y0 = rd->y;
+	double x1 = rd->x + rd->w;
+	double y1 = rd->y + rd->h;
+	double rx = rd->rx;
+	double ry = rd->ry;
+	/* where the sides are the closest to the center */
+	double ltop = rd->tl ? y0 + ry : y0;
+	double rtop = rd->tr ? y0 + ry : y0;
+	int ncoverages = 0;
+	int i;
+
+	thiz->ncorners = 0;
+	if (rd->tl)
+		_shape_path_analytic_corner_add(thiz, x0, y0, x0 + rx, y0 + ry);
+	if (rd->tr)
+		_shape_path_analytic_corner_add(thiz, x1 - rx, y0, x1 - rx, y0 + ry);
+	if (rd->bl)
+		_shape_path_analytic_corner_add(thiz, x0, y1 - ry, x0 + rx, y1 - ry);
+	if (rd->br)
+		_shape_path_analytic_corner_add(thiz, x1 - rx, y1 - ry, x1 - rx, y1 - ry);
+
+	thiz->y = floor(y0);
+	thiz->nrows = ceil(y1) - thiz->y;
+	if (thiz->nrows > thiz->arows)
+	{
+		Enesim_Renderer_Shape_Path_Row *rows;
+
+		rows = realloc(thiz->rows, thiz->nrows * sizeof(Enesim_Renderer_Shape_Path_Row));
+		if (!rows)
+			return EINA_FALSE;
+		thiz->rows = rows;
+		thiz->arows = thiz->nrows;
+	}
+
+	/* first the extent of every row */
+	for (i = 0; i < thiz->nrows; i++)
+	{
+		Enesim_Renderer_Shape_Path_Row *row = &thiz->rows[i];
+		double va = thiz->y + i;
+		double vb = va + 1;
+		double lmin, lmax, rmin, rmax;
+		double l0, l1, r0, r1;
+		int il, ir;
+
+		if (va < y0)
+			va = y0;
+		if (vb > y1)
+			vb = y1;
+		/* the sides are monotonic on every corner */
+		l0 = _shape_path_analytic_side(rd, rd->tl, rd->bl, x0, 1, va);
+		l1 = _shape_path_analytic_side(rd, rd->tl, rd->bl, x0, 1, vb);
+		r0 = _shape_path_analytic_side(rd, rd->tr, rd->br, x1, -1, va);
+		r1 = _shape_path_analytic_side(rd, rd->tr, rd->br, x1, -1, vb);
+		lmin = _shape_path_analytic_side(rd, rd->tl, rd->bl, x0, 1,
+				ltop < va ? va : ltop > vb ? vb : ltop);
+		rmax = _shape_path_analytic_side(rd, rd->tr, rd->br, x1, -1,
+				rtop < va ? va : rtop > vb ? vb : rtop);
+		lmax = l0 > l1 ? l0 : l1;
+		rmin = r0 < r1 ? r0 : r1;
+
+		row->x = floor(lmin);
+		row->offset = ncoverages;
+		il = ceil(lmax);
+		ir = floor(rmin);
+		/* between the sides the whole height of the row is covered */
+		if (il < ir)
+		{
+			row->left = il - row->x;
+			row->len = ir - il;
+			row->right = (int)ceil(rmax) - ir;
+			row->a = (vb - va) * 256 + 0.5;
+		}
+		else
+		{
+			row->left = (int)ceil(rmax) - row->x;
+			row->len = 0;
+			row->right = 0;
+			row->a = 0;
+		}
+		ncoverages += row->left + row->right;
+	}
+	if (ncoverages > thiz->acoverages)
+	{
+		uint16_t *coverages;
+
+		coverages = realloc(thiz->coverages, ncoverages * sizeof(uint16_t));
+		if (!coverages)
+			return EINA_FALSE;
+		thiz->coverages = coverages;
+		thiz->acoverages = ncoverages;
+	}
+
+	/* now the coverage of the pixels on the sides */
+	for (i = 0; i < thiz->nrows; i++)
+	{
+		Enesim_Renderer_Shape_Path_Row *row = &thiz->rows[i];
+		uint16_t *c = thiz->coverages + row->offset;
+		double py = thiz->y + i;
+		int x;
+		int n;
+
+		for (n = 0, x = row->x; n < row->left; n++, x++)
+			*c++ = _shape_path_analytic_coverage(thiz, x, py, x + 1, py + 1);
+		x += row->len;
+		for (n = 0; n < row->right; n++, x++)
+			*c++ = _shape_path_analytic_coverage(thiz, x, py, x + 1, py + 1);
+	}
+	return EINA_TRUE;
+}
+
+/* Get the shape on the destination in case it can be drawn without the path */
+static Eina_Bool _shape_path_analytic_get(Enesim_Renderer *r,
+		Enesim_Renderer_Shape_Path_Rounded *rounded)
+{
+	Enesim_Renderer_Shape_Path_Class *klass;
+	Enesim_Matrix m;
+	double ox, oy;
+
+	klass = ENESIM_RENDERER_SHAPE_PATH_CLASS_GET(r);
+	if (!klass->rounded_get)
+		return EINA_FALSE;
+	/* the exact area is the best coverage there is, only the fast
+	 * quality keeps the cheaper coverage of the path
+	 */
+	if (enesim_renderer_quality_get(r) == ENESIM_QUALITY_FAST)
+		return EINA_FALSE;
+	if (enesim_renderer_shape_draw_mode_get(r) != ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL)
+		return EINA_FALSE;
+	/* only a scale keeps the shape axis aligned */
+	enesim_renderer_transformation_get(r, &m);
+	if (m.xy || m.yx || m.zx || m.zy || (m.zz != 1) ||
+			(m.xx <= 0) || (m.yy <= 0))
+		return EINA_FALSE;
+	if (!klass->rounded_get(r, rounded))
+		return EINA_FALSE;
+
+	enesim_renderer_origin_get(r, &ox, &oy);
+	rounded->x = rounded->x * m.xx + m.xz + ox;
+	rounded->y = rounded->y * m.yy + m.yz + oy;
+	rounded->w *= m.xx;
+	rounded->h *= m.yy;
+	rounded->rx *= m.xx;
+	rounded->ry *= m.yy;
+	if (!(rounded->w > 0) || !(rounded->h > 0) ||
+			(rounded->w >= ENESIM_RENDERER_SHAPE_PATH_ANALYTIC_MAX) ||
+			(rounded->h >= ENESIM_RENDERER_SHAPE_PATH_ANALYTIC_MAX) ||
+			!(fabs(rounded->x) < INT_MAX / 2) ||
+			!(fabs(rounded->y) < INT_MAX / 2))
+		return EINA_FALSE;
+	/* same as the arcs of the path */
+	if (rounded->rx > rounded->w / 2)
+		rounded->rx = rounded->w / 2;
+	if (rounded->ry > rounded->h / 2)
+		rounded->ry = rounded->h / 2;
+	if (!(rounded->rx > 0) || !(rounded->ry > 0))
+	{
+		rounded->tl = rounded->tr = EINA_FALSE;
+		rounded->bl = rounded->br = EINA_FALSE;
+	}
+	return EINA_TRUE;
+}
+
+static Eina_Bool _shape_path_analytic_is_equal(
+		const Enesim_Renderer_Shape_Path_Rounded *a,
+		const Enesim_Renderer_Shape_Path_Rounded *b)
+{
+	if ((a->x != b->x) || (a->y != b->y) || (a->w != b->w) ||
+			(a->h != b->h) || (a->rx != b->rx) || (a->ry != b->ry))
+		return EINA_FALSE;
+	if ((a->tl != b->tl) || (a->tr != b->tr) || (a->bl != b->bl) ||
+			(a->br != b->br))
+		return EINA_FALSE;
+	return EINA_TRUE;
+}
+
+static Eina_Bool _shape_path_analytic_setup(Enesim_Renderer *r,
+		Enesim_Surface *s, Enesim_Log **l)
+{
+	Enesim_Renderer_Shape_Path *thiz;
+	Enesim_Renderer_Shape_Path_Analytic *analytic;
+	Enesim_Renderer_Shape_Path_Rounded rounded;
+
+	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	if (!_shape_path_analytic_get(r, &rounded))
+		return EINA_FALSE;
+	if (!thiz->analytic)
+	{
+		thiz->analytic = calloc(1, sizeof(Enesim_Renderer_Shape_Path_Analytic));
+		if (!thiz->analytic)
+			return EINA_FALSE;
+	}
+	analytic = thiz->analytic;
+	/* the table is kept until the shape moves on the destination */
+	if (!analytic->generated ||
+			!_shape_path_analytic_is_equal(&analytic->rounded, &rounded))
+	{
+		analytic->rounded = rounded;
+		analytic->generated = _shape_path_analytic_generate(analytic);
+		if (!analytic->generated)
+			return EINA_FALSE;
+	}
+
+	enesim_renderer_shape_fill_setup(r, &analytic->color, &analytic->fill_r);
+	if (analytic->fill_r)
+	{
+		if (!enesim_renderer_setup(analytic->fill_r, s, ENESIM_ROP_FILL, l))
+		{
+			ENESIM_RENDERER_LOG(r, l, "Fill renderer failed");
+			enesim_renderer_unref(analytic->fill_r);
+			analytic->fill_r = NULL;
+			return EINA_FALSE;
+		}
+	}
+	analytic->used = EINA_TRUE;
+	return EINA_TRUE;
+}
+
+static void _shape_path_analytic_cleanup(Enesim_Renderer *r, Enesim_Surface *s)
+{
+	Enesim_Renderer_Shape_Path *thiz;
+	Enesim_Renderer_Shape_Path_Class *klass;
+	Enesim_Renderer_Shape_Path_Analytic *analytic;
+
+	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	klass = ENESIM_RENDERER_SHAPE_PATH_CLASS_GET(r);
+	analytic = thiz->analytic;
+	if (analytic->fill_r)
+	{
+		enesim_renderer_cleanup(analytic->fill_r, s);
+		enesim_renderer_unref(analytic->fill_r);
+		analytic->fill_r = NULL;
+	}
+	analytic->used = EINA_FALSE;
+	enesim_renderer_shape_state_commit(r);
+	if (klass->cleanup)
+		klass->cleanup(r);
+}
+
 static Eina_Bool _shape_path_propagate(Enesim_Renderer *r)
 {
 	Enesim_Renderer_Shape_Path *thiz;
@@ -66,7 +499,7 @@ static Eina_Bool _shape_path_propagate(Enesim_Renderer *r)
 	return EINA_TRUE;
 }
 
-static Eina_Bool _shape_path_setup(Enesim_Renderer *r, Enesim_Surface *s,
+static Eina_Bool _shape_path_path_setup(Enesim_Renderer *r, Enesim_Surface *s,
 		Enesim_Rop rop, Enesim_Log **l)
 {
 	Enesim_Renderer_Shape_Path *thiz;
@@ -75,9 +508,6 @@ static Eina_Bool _shape_path_setup(Enesim_Renderer *r, Enesim_Surface *s,
 	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
 	klass = ENESIM_RENDERER_SHAPE_PATH_CLASS_GET(r);
 
-	if (!_shape_path_propagate(r))
-		return EINA_FALSE;
-
 	if (!enesim_renderer_setup(thiz->r_path, s, rop, l))
 	{
 		if (klass->cleanup)
@@ -112,6 +542,186 @@ static void _shape_path_path_span(Enesim_Renderer *r,
 	enesim_renderer_sw_draw(thiz->r_path, x, y, len, ddata);
 }
 
+static inline void _shape_path_analytic_run(uint32_t *d, int len, int a,
+		Enesim_Color color, Eina_Bool paint)
+{
+	uint32_t *e = d + len;
+
+	if (!a)
+	{
+		memset(d, 0, len * sizeof(uint32_t));
+		return;
+	}
+	if (!paint)
+	{
+		if (a < 256)
+			color = argb8888_mul_256(a, color);
+		while (d < e)
+			*d++ = color;
+		return;
+	}
+	while (d < e)
+	{
+		uint32_t p0 = *d;
+
+		if (color != ENESIM_COLOR_FULL)
+			p0 = argb8888_mul4_sym(color, p0);
+		if (a < 256)
+			p0 = argb8888_mul_256(a, p0);
+		*d++ = p0;
+	}
+}
+
+static inline void _shape_path_analytic_pixels(uint32_t *d, int len,
+		const uint16_t *c, Enesim_Color color, Eina_Bool paint)
+{
+	uint32_t *e = d + len;
+
+	while (d < e)
+	{
+		int a = *c++;
+
+		if (!paint)
+		{
+			*d = a < 256 ? argb8888_mul_256(a, color) : color;
+		}
+		else
+		{
+			uint32_t p0 = *d;
+
+			if (color != ENESIM_COLOR_FULL)
+				p0 = argb8888_mul4_sym(color, p0);
+			if (a < 256)
+				p0 = argb8888_mul_256(a, p0);
+			*d = p0;
+		}
+		d++;
+	}
+}
+
+/* Draw the shape from the table of rows */
+static void _shape_path_analytic_span(Enesim_Renderer *r,
+		int x, int y, int len, void *ddata)
+{
+	Enesim_Renderer_Shape_Path *thiz;
+	Enesim_Renderer_Shape_Path_Analytic *analytic;
+	const Enesim_Renderer_Shape_Path_Row *row;
+	const uint16_t *c;
+	uint32_t *dst = ddata;
+	uint32_t *end = dst + len;
+	Eina_Bool paint = EINA_FALSE;
+	int x0, x1, x2, x3;
+
+	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	analytic = thiz->analytic;
+	if ((y < analytic->y) || (y >= analytic->y + analytic->nrows))
+	{
+		memset(dst, 0, len * sizeof(uint32_t));
+		return;
+	}
+	row = &analytic->rows[y - analytic->y];
+	c = analytic->coverages + row->offset;
+	if (analytic->fill_r)
+	{
+		enesim_renderer_sw_draw(analytic->fill_r, x, y, len, dst);
+		paint = EINA_TRUE;
+	}
+
+	x0 = row->x;
+	x1 = x0 + row->left;
+	x2 = x1 + row->len;
+	x3 = x2 + row->right;
+	while (dst < end)
+	{
+		int n = end - dst;
+
+		if (x < x0)
+		{
+			if (n > x0 - x)
+				n = x0 - x;
+			_shape_path_analytic_run(dst, n, 0, analytic->color, paint);
+		}
+		else if (x < x1)
+		{
+			if (n > x1 - x)
+				n = x1 - x;
+			_shape_path_analytic_pixels(dst, n, c + x - x0,
+					analytic->color, paint);
+		}
+		else if (x < x2)
+		{
+			if (n > x2 - x)
+				n = x2 - x;
+			_shape_path_analytic_run(dst, n, row->a,
+					analytic->color, paint);
+		}
+		else if (x < x3)
+		{
+			if (n > x3 - x)
+				n = x3 - x;
+			_shape_path_analytic_pixels(dst, n,
+					c + row->left + x - x2,
+					analytic->color, paint);
+		}
+		else
+		{
+			_shape_path_analytic_run(dst, n, 0, analytic->color, paint);
+		}
+		dst += n;
+		x += n;
+	}
+}
+
+/* Outside of the shape and on the constant runs the color is solid */
+static int _shape_path_analytic_runs(Enesim_Renderer *r, int x, int y,
+		int len, Enesim_Color *color)
+{
+	Enesim_Renderer_Shape_Path *thiz;
+	Enesim_Renderer_Shape_Path_Analytic *analytic;
+	const Enesim_Renderer_Shape_Path_Row *row;
+	int x0, x1, x2, x3;
+	int n;
+
+	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	analytic = thiz->analytic;
+	*color = 0;
+	if ((y < analytic->y) || (y >= analytic->y + analytic->nrows))
+		return len;
+	row = &analytic->rows[y - analytic->y];
+
+	x0 = row->x;
+	x1 = x0 + row->left;
+	x2 = x1 + row->len;
+	x3 = x2 + row->right;
+	if (x < x0)
+	{
+		n = x0 - x;
+	}
+	else if (x < x1)
+	{
+		n = -(x1 - x);
+		return n < -len ? -len : n;
+	}
+	else if (x < x2)
+	{
+		n = x2 - x;
+		if (row->a >= 256)
+			*color = analytic->color;
+		else if (row->a)
+			*color = argb8888_mul_256(row->a, analytic->color);
+	}
+	else if (x < x3)
+	{
+		n = -(x3 - x);
+		return n < -len ? -len : n;
+	}
+	else
+	{
+		n = len;
+	}
+	return n > len ? len : n;
+}
+
 #if BUILD_OPENGL
 static void _shape_path_opengl_draw(Enesim_Renderer *r, Enesim_Surface *s,
 		Enesim_Rop rop, const Eina_Rectangle *area, int x, int y)
@@ -142,7 +752,14 @@ static Eina_Bool _shape_path_sw_setup(Enesim_Renderer *r,
 		Enesim_Surface *s, Enesim_Rop rop,
 		Enesim_Renderer_Sw_Fill *draw, Enesim_Log **l)
 {
-	if (!_shape_path_setup(r, s, rop, l))
+	if (!_shape_path_propagate(r))
+		return EINA_FALSE;
+	if (_shape_path_analytic_setup(r, s, l))
+	{
+		*draw = _shape_path_analytic_span;
+		return EINA_TRUE;
+	}
+	if (!_shape_path_path_setup(r, s, rop, l))
 		return EINA_FALSE;
 	*draw = _shape_path_path_span;
 	return EINA_TRUE;
@@ -150,7 +767,13 @@ static Eina_Bool _shape_path_sw_setup(Enesim_Renderer *r,
 
 static void _shape_path_sw_cleanup(Enesim_Renderer *r, Enesim_Surface *s)
 {
-	_shape_path_cleanup(r, s);
+	Enesim_Renderer_Shape_Path *thiz;
+
+	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	if (thiz->analytic && thiz->analytic->used)
+		_shape_path_analytic_cleanup(r, s);
+	else
+		_shape_path_cleanup(r, s);
 }
 
 static void _shape_path_features_get(Enesim_Renderer *r EINA_UNUSED,
@@ -166,6 +789,14 @@ static void _shape_path_sw_hints(Enesim_Renderer *r, Enesim_Rop rop,
 	Enesim_Renderer_Shape_Path *thiz;
 
 	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
+	if (thiz->analytic && thiz->analytic->used)
+	{
+		*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
+		if (!thiz->analytic->fill_r)
+			*hints |= ENESIM_RENDERER_SW_HINT_FULL_SPAN |
+					ENESIM_RENDERER_SW_HINT_RUNS;
+		return;
+	}
 	enesim_renderer_sw_hints_get(thiz->r_path, rop, hints);
 }
 
@@ -175,7 +806,9 @@ static Eina_Bool _shape_path_opengl_setup(Enesim_Renderer *r,
 		Enesim_Renderer_OpenGL_Draw *draw,
 		Enesim_Log **l)
 {
-	if (!_shape_path_setup(r, s, rop, l))
+	if (!_shape_path_propagate(r))
+		return EINA_FALSE;
+	if (!_shape_path_path_setup(r, s, rop, l))
 		return EINA_FALSE;
 
 	*draw = _shape_path_opengl_draw;
@@ -213,6 +846,7 @@ static void _enesim_renderer_shape_path_class_init(void *k)
 	 */
 	klass->sw_setup = _shape_path_sw_setup;
 	klass->sw_cleanup = _shape_path_sw_cleanup;
+	klass->sw_runs = _shape_path_analytic_runs;
 #if BUILD_OPENGL
 	klass->opengl_setup = _shape_path_opengl_setup;
 	klass->opengl_cleanup = _shape_path_opengl_cleanup;
@@ -237,6 +871,12 @@ static void _enesim_renderer_shape_path_instance_deinit(void *o)
 	thiz = ENESIM_RENDERER_SHAPE_PATH(o);
 	enesim_renderer_unref(thiz->r_path);
 	enesim_path_unref(thiz->path);
+	if (thiz->analytic)
+	{
+		free(thiz->analytic->rows);
+		free(thiz->analytic->coverages);
+		free(thiz->analytic);
+	}
 }
 /*============================================================================*
  *                                 Global                                     *
@@ -254,7 +894,15 @@ void enesim_renderer_shape_path_bounds_get_default(Enesim_Renderer *r,
 		Enesim_Rectangle *bounds)
 {
 	Enesim_Renderer_Shape_Path *thiz;
+	Enesim_Renderer_Shape_Path_Rounded rounded;
 
+	/* the shapes drawn without the path do not need to generate it */
+	if (_shape_path_analytic_get(r, &rounded))
+	{
+		enesim_rectangle_coords_from(bounds, rounded.x, rounded.y,
+				rounded.w, rounded.h);
+		return;
+	}
 	thiz = ENESIM_RENDERER_SHAPE_PATH(r);
 	_shape_path_propagate(r);
 	enesim_renderer_bounds_get(thiz->r_path, bounds);
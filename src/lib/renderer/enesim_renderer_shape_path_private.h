@@ -31,16 +31,39 @@
 		ENESIM_RENDERER_SHAPE_PATH_DESCRIPTOR)
 
 
+typedef struct _Enesim_Renderer_Shape_Path_Analytic Enesim_Renderer_Shape_Path_Analytic;
+
 typedef struct _Enesim_Renderer_Shape_Path
 {
 	Enesim_Renderer_Shape parent;
 	Enesim_Renderer *r_path;
 	Enesim_Path *path;
+	/* the coverage of the shape when it is drawn without the path */
+	Enesim_Renderer_Shape_Path_Analytic *analytic;
 } Enesim_Renderer_Shape_Path;
 
+/* A rectangle with elliptic corners, for the shapes that can be drawn
+ * without generating the path
+ */
+typedef struct _Enesim_Renderer_Shape_Path_Rounded
+{
+	double x;
+	double y;
+	double w;
+	double h;
+	double rx;
+	double ry;
+	Eina_Bool tl : 1;
+	Eina_Bool tr : 1;
+	Eina_Bool bl : 1;
+	Eina_Bool br : 1;
+} Enesim_Renderer_Shape_Path_Rounded;
+
 typedef Eina_Bool (*Enesim_Renderer_Shape_Path_Setup)(Enesim_Renderer *r,
 		Enesim_Path *path);
 typedef void (*Enesim_Renderer_Shape_Path_Cleanup)(Enesim_Renderer *r);
+typedef Eina_Bool (*Enesim_Renderer_Shape_Path_Rounded_Get)(Enesim_Renderer *r,
+		Enesim_Renderer_Shape_Path_Rounded *rounded);
 
 typedef struct _Enesim_Renderer_Shape_Path_Class
 {
@@ -48,6 +71,8 @@ typedef struct _Enesim_Renderer_Shape_Path_Class
 	Enesim_Renderer_Has_Changed_Cb has_changed;
 	Enesim_Renderer_Shape_Path_Setup setup;
 	Enesim_Renderer_Shape_Path_Cleanup cleanup;
+	/* optional, the filled shape as a rounded rectangle */
+	Enesim_Renderer_Shape_Path_Rounded_Get rounded_get;
 } Enesim_Renderer_Shape_Path_Class;
 
 Enesim_Object_Descriptor * enesim_renderer_shape_path_descriptor_get(void);
@@ -305,15 +305,43 @@ static void _span_projective_paints(Enesim_Renderer *r,
 	}
 }
 
+static inline unsigned int _stripes_affine_color_get(
+		Enesim_Renderer_Stripes *thiz, Eina_F16p16 yy)
+{
+	int hh = thiz->hh, hh0 = thiz->hh0, h0 = hh0 >> 16;
+	Enesim_Color c0 = thiz->final_color1;
+	Enesim_Color c1 = thiz->final_color2;
+	unsigned int p0 = c0;
+	int syy = (yy % hh), sy;
+
+	if (syy < 0)
+		syy += hh;
+	sy = syy >> 16;
+	if (sy == 0)
+	{
+		int a = 1 + ((syy & 0xffff) >> 8);
+
+		p0 = argb8888_interp_256(a, c0, c1);
+	}
+	if (syy >= hh0)
+	{
+		p0 = c1;
+		if (sy == h0)
+		{
+			int a = 1 + ((syy & 0xffff) >> 8);
+
+			p0 = argb8888_interp_256(a, c1, c0);
+		}
+	}
+	return p0;
+}
+
 static void _span_affine(Enesim_Renderer *r,
 		int x, int y,
 		int len, void *ddata)
 {
 	Enesim_Renderer_Stripes *thiz = ENESIM_RENDERER_STRIPES(r);
 	int ayx = thiz->matrix.yx;
-	int hh = thiz->hh, hh0 = thiz->hh0, h0 = hh0 >> 16;
-	Enesim_Color c0 = thiz->final_color1;
-	Enesim_Color c1 = thiz->final_color2;
 	uint32_t *dst = ddata;
 	unsigned int *d = dst, *e = d + len;
 	Eina_F16p16 yy, xx;
@@ -321,33 +349,25 @@ static void _span_affine(Enesim_Renderer *r,
 	enesim_coord_affine_setup(&xx, &yy, x, y, thiz->ox, thiz->oy,  &thiz->matrix);
 	while (d < e)
 	{
-		unsigned int p0 = c0;
-		int syy = (yy % hh), sy;
-
-		if (syy < 0)
-			syy += hh;
-		sy = syy >> 16;
-		if (sy == 0)
-		{
-			int a = 1 + ((syy & 0xffff) >> 8);
-
-			p0 = argb8888_interp_256(a, c0, c1);
-		}
-		if (syy >= hh0)
-		{
-			p0 = c1;
-			if (sy == h0)
-			{
-				int a = 1 + ((syy & 0xffff) >> 8);
-
-				p0 = argb8888_interp_256(a, c1, c0);
-			}
-		}
-		*d++ = p0;
+		*d++ = _stripes_affine_color_get(thiz, yy);
 		yy += ayx;
 	}
 }
 
+/* The stripes are horizontal, without a rotation every span is a single
+ * run
+ */
+static int _stripes_runs(Enesim_Renderer *r, int x, int y, int len,
+		Enesim_Color *color)
+{
+	Enesim_Renderer_Stripes *thiz = ENESIM_RENDERER_STRIPES(r);
+	Eina_F16p16 yy, xx;
+
+	enesim_coord_affine_setup(&xx, &yy, x, y, thiz->ox, thiz->oy,  &thiz->matrix);
+	*color = _stripes_affine_color_get(thiz, yy);
+	return len;
+}
+
 static void _span_affine_paints(Enesim_Renderer *r,
 		int x, int y, int len, void *ddata)
 {
@@ -537,10 +557,21 @@ static void _stripes_features_get(Enesim_Renderer *r EINA_UNUSED,
 			ENESIM_RENDERER_FEATURE_ARGB8888;
 }
 
-static void _stripes_sw_hints(Enesim_Renderer *r EINA_UNUSED,
+static void _stripes_sw_hints(Enesim_Renderer *r,
 		Enesim_Rop rop EINA_UNUSED, Enesim_Renderer_Sw_Hint *hints)
 {
-	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE;
+	Enesim_Renderer_Stripes *thiz = ENESIM_RENDERER_STRIPES(r);
+	Enesim_Matrix_Type type;
+	Enesim_Matrix matrix;
+
+	*hints = ENESIM_RENDERER_SW_HINT_COLORIZE | ENESIM_RENDERER_SW_HINT_FULL_SPAN |
+			ENESIM_RENDERER_SW_HINT_SPLIT_SPAN;
+	/* the inverse matrix does not move along y on a span either */
+	type = enesim_renderer_transformation_type_get(r);
+	enesim_renderer_transformation_get(r, &matrix);
+	if (type != ENESIM_MATRIX_TYPE_PROJECTIVE && matrix.yx == 0 &&
+			!thiz->current.even.paint && !thiz->current.odd.paint)
+		*hints |= ENESIM_RENDERER_SW_HINT_RUNS;
 }
 
 static Eina_Bool _stripes_has_changed(Enesim_Renderer *r)
@@ -634,6 +665,7 @@ static void _enesim_renderer_stripes_class_init(void *k)
 	klass->sw_hints_get = _stripes_sw_hints;
 	klass->sw_setup = _stripes_sw_setup;
 	klass->sw_cleanup = _stripes_sw_cleanup;
+	klass->sw_runs = _stripes_runs;
 #if BUILD_OPENGL
 	klass->opengl_initialize = _stripes_opengl_initialize;
 	klass->opengl_setup = _stripes_opengl_setup;
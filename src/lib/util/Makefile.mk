@@ -1,9 +1,12 @@
 
 src_lib_libenesim_la_SOURCES += \
+src/lib/util/enesim_atomic_private.h \
 src/lib/util/enesim_barrier.c \
 src/lib/util/enesim_barrier_private.h \
 src/lib/util/enesim_coord.c \
 src/lib/util/enesim_coord_private.h \
+src/lib/util/enesim_cpu.c \
+src/lib/util/enesim_cpu_private.h \
 src/lib/util/enesim_cramer.c \
 src/lib/util/enesim_cramer_private.h \
 src/lib/util/enesim_list.c \
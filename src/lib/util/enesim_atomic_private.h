@@ -0,0 +1,48 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _ENESIM_ATOMIC_PRIVATE_H
+#define _ENESIM_ATOMIC_PRIVATE_H
+
+/* The minimum atomic operations on an integer we need. The get has acquire
+ * semantics and the set has release semantics, so whatever was written
+ * before a set is visible after a get that reads it
+ */
+#ifdef _WIN32
+
+typedef volatile LONG Enesim_Atomic;
+#define enesim_atomic_get(a) InterlockedCompareExchange(a, 0, 0)
+#define enesim_atomic_set(a, v) InterlockedExchange(a, v)
+#define enesim_atomic_cas(a, o, n) (InterlockedCompareExchange(a, n, o) == (o))
+
+#elif defined(__ATOMIC_ACQUIRE)
+
+typedef int Enesim_Atomic;
+#define enesim_atomic_get(a) __atomic_load_n(a, __ATOMIC_ACQUIRE)
+#define enesim_atomic_set(a, v) __atomic_store_n(a, v, __ATOMIC_RELEASE)
+#define enesim_atomic_cas(a, o, n) __sync_bool_compare_and_swap(a, o, n)
+
+#else /* older gcc */
+
+typedef volatile int Enesim_Atomic;
+#define enesim_atomic_get(a) __sync_fetch_and_add(a, 0)
+#define enesim_atomic_set(a, v) do { __sync_synchronize(); *(a) = (v); } while (0)
+#define enesim_atomic_cas(a, o, n) __sync_bool_compare_and_swap(a, o, n)
+
+#endif
+
+#endif /* _ENESIM_ATOMIC_PRIVATE_H */
@@ -0,0 +1,145 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "enesim_private.h"
+#include "enesim_cpu_private.h"
+
+#include <string.h>
+
+#if ENESIM_CPU_X86
+#include <cpuid.h>
+#endif
+/*============================================================================*
+ *                                  Local                                     *
+ *============================================================================*/
+/** @cond internal */
+#define ENESIM_LOG_DEFAULT enesim_log_global
+
+typedef struct _Enesim_Cpu_Feature_Name
+{
+	const char *name;
+	Enesim_Cpu_Feature feature;
+} Enesim_Cpu_Feature_Name;
+
+static Enesim_Cpu_Feature_Name _names[] = {
+	{ "mmx", ENESIM_CPU_FEATURE_MMX },
+	{ "sse", ENESIM_CPU_FEATURE_SSE },
+	{ "sse2", ENESIM_CPU_FEATURE_SSE2 },
+	{ "ssse3", ENESIM_CPU_FEATURE_SSSE3 },
+	{ "sse4.1", ENESIM_CPU_FEATURE_SSE41 },
+	{ "avx2", ENESIM_CPU_FEATURE_AVX2 },
+};
+
+static int _features = 0;
+
+#if ENESIM_CPU_X86
+static int _x86_features_get(void)
+{
+	unsigned int eax, ebx, ecx, edx;
+	int ret = 0;
+
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+		return 0;
+
+	if (edx & (1 << 23))
+		ret |= ENESIM_CPU_FEATURE_MMX;
+	if (edx & (1 << 25))
+		ret |= ENESIM_CPU_FEATURE_SSE;
+	if (edx & (1 << 26))
+		ret |= ENESIM_CPU_FEATURE_SSE2;
+	if (ecx & (1 << 9))
+		ret |= ENESIM_CPU_FEATURE_SSSE3;
+	if (ecx & (1 << 19))
+		ret |= ENESIM_CPU_FEATURE_SSE41;
+	/* avx2 needs the os to save the ymm registers too */
+	if ((ecx & (1 << 27)) && (ecx & (1 << 28)) &&
+			__get_cpuid_max(0, NULL) >= 7)
+	{
+		unsigned int xcr0, xcr0h;
+
+		__asm__ ("xgetbv" : "=a" (xcr0), "=d" (xcr0h) : "c" (0));
+		__cpuid_count(7, 0, eax, ebx, ecx, edx);
+		if (((xcr0 & 0x6) == 0x6) && (ebx & (1 << 5)))
+			ret |= ENESIM_CPU_FEATURE_AVX2;
+	}
+	return ret;
+}
+#endif
+
+/* ENESIM_CPU_DISABLE is a comma separated list of features to not use,
+ * "all" disables every one of them. Useful to compare the SIMD kernels
+ * against the generic ones
+ */
+static int _disabled_get(void)
+{
+	const char *env;
+	int ret = 0;
+
+	env = getenv("ENESIM_CPU_DISABLE");
+	if (!env)
+		return 0;
+
+	while (*env)
+	{
+		const char *end;
+		size_t len;
+		unsigned int i;
+
+		end = strchr(env, ',');
+		len = end ? (size_t)(end - env) : strlen(env);
+		if (len == 3 && !strncmp(env, "all", 3))
+			return ~0;
+		for (i = 0; i < sizeof(_names) / sizeof(Enesim_Cpu_Feature_Name); i++)
+		{
+			if (strlen(_names[i].name) == len &&
+					!strncmp(env, _names[i].name, len))
+				ret |= _names[i].feature;
+		}
+		env += len;
+		if (*env == ',')
+			env++;
+	}
+	return ret;
+}
+/*============================================================================*
+ *                                 Global                                     *
+ *============================================================================*/
+void enesim_cpu_init(void)
+{
+	unsigned int i;
+
+#if ENESIM_CPU_X86
+	_features = _x86_features_get();
+#endif
+	_features &= ~_disabled_get();
+	for (i = 0; i < sizeof(_names) / sizeof(Enesim_Cpu_Feature_Name); i++)
+	{
+		if (_features & _names[i].feature)
+			INF("CPU feature '%s' available", _names[i].name);
+	}
+}
+
+void enesim_cpu_shutdown(void)
+{
+	_features = 0;
+}
+
+Eina_Bool enesim_cpu_feature_has(Enesim_Cpu_Feature f)
+{
+	return (_features & f) ? EINA_TRUE : EINA_FALSE;
+}
+/** @endcond */
@@ -0,0 +1,47 @@
+/* ENESIM - Drawing Library
+ * Copyright (C) 2007-2013 Jorge Luis Zapata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef _ENESIM_CPU_PRIVATE_H
+#define _ENESIM_CPU_PRIVATE_H
+
+/* The SIMD kernels are built with a per function target, independently of
+ * the flags the library is compiled with, and are only registered when the
+ * cpu we run on supports them
+ */
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#define ENESIM_CPU_X86 1
+#define ENESIM_CPU_TARGET(t) __attribute__((target(t)))
+#else
+#define ENESIM_CPU_X86 0
+#define ENESIM_CPU_TARGET(t)
+#endif
+
+typedef enum _Enesim_Cpu_Feature
+{
+	ENESIM_CPU_FEATURE_MMX   = (1 << 0),
+	ENESIM_CPU_FEATURE_SSE   = (1 << 1),
+	ENESIM_CPU_FEATURE_SSE2  = (1 << 2),
+	ENESIM_CPU_FEATURE_SSSE3 = (1 << 3),
+	ENESIM_CPU_FEATURE_SSE41 = (1 << 4),
+	ENESIM_CPU_FEATURE_AVX2  = (1 << 5),
+} Enesim_Cpu_Feature;
+
+void enesim_cpu_init(void);
+void enesim_cpu_shutdown(void);
+Eina_Bool enesim_cpu_feature_has(Enesim_Cpu_Feature f);
+
+#endif
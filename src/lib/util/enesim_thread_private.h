@@ -24,7 +24,10 @@ typedef HANDLE Enesim_Thread;
 Eina_Bool enesim_thread_win32_new(HANDLE *thread, LPTHREAD_START_ROUTINE callback, void *data);
 
 #define enesim_thread_new(thread, cb, data) enesim_thread_win32_new(thread, cb, data)
-#define enesim_thread_free(thread) CloseHandle(thread)
+#define enesim_thread_free(thread) do {					\
+	WaitForSingleObject(thread, INFINITE);					\
+	CloseHandle(thread);							\
+} while (0)
 #define enesim_thread_affinity_set(thread, cpunum) SetThreadAffinityMask(thread, 1 << (cpunum))
 
 #else /* _WIN32 */
@@ -13,8 +13,24 @@ check_PROGRAMS = \
 src/tests/enesim_test_eina_pool \
 src/tests/enesim_test_renderer \
 src/tests/enesim_test_renderer_error \
+src/tests/enesim_test_renderer_async \
+src/tests/enesim_test_renderer_compound \
+src/tests/enesim_test_threads \
+src/tests/enesim_test_image_context \
 src/tests/enesim_test_object01 \
-src/tests/enesim_test_damages
+src/tests/enesim_test_damages \
+src/tests/enesim_test_renderer_runs \
+src/tests/enesim_test_renderer_stream \
+src/tests/enesim_test_renderer_block \
+src/tests/enesim_test_renderer_coverage \
+src/tests/enesim_test_renderer_analytic \
+src/tests/enesim_test_renderer_rasterizer
+
+if BUILD_STATIC
+check_PROGRAMS += \
+src/tests/enesim_test_compositor \
+src/tests/enesim_bench_compositor
+endif
 
 if HAVE_OPENCL
 check_PROGRAMS += \
@@ -39,6 +55,39 @@ src_tests_enesim_test_renderer_error_SOURCES = src/tests/enesim_test_renderer_er
 src_tests_enesim_test_renderer_error_LDADD = $(tests_LDADD)
 src_tests_enesim_test_renderer_error_CPPFLAGS = $(tests_CPPFLAGS)
 
+src_tests_enesim_test_renderer_async_SOURCES = \
+src/tests/enesim_test_renderer_async.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_async_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_async_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_compound_SOURCES = \
+src/tests/enesim_test_renderer_compound.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_compound_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_compound_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_threads_SOURCES = \
+src/tests/enesim_test_threads.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_threads_LDADD = $(tests_LDADD)
+src_tests_enesim_test_threads_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_image_context_SOURCES = src/tests/enesim_test_image_context.c
+src_tests_enesim_test_image_context_LDADD = $(tests_LDADD)
+src_tests_enesim_test_image_context_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_compositor_SOURCES = \
+src/tests/enesim_test_compositor.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_compositor_LDADD = $(tests_LDADD)
+src_tests_enesim_test_compositor_LDFLAGS = -static
+src_tests_enesim_test_compositor_CPPFLAGS = $(tests_CPPFLAGS)
+
 src_tests_enesim_test_damages_SOURCES = src/tests/enesim_test_damages.c
 src_tests_enesim_test_damages_LDADD = $(tests_LDADD)
 src_tests_enesim_test_damages_CPPFLAGS = $(tests_CPPFLAGS)
@@ -58,3 +107,50 @@ src_tests_enesim_test_renderer_pool_CPPFLAGS = $(tests_CPPFLAGS)
 src_tests_enesim_test_object01_SOURCES = src/tests/enesim_test_object01.c
 src_tests_enesim_test_object01_LDADD = $(tests_LDADD)
 src_tests_enesim_test_object01_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_runs_SOURCES = \
+src/tests/enesim_test_renderer_runs.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_runs_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_runs_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_stream_SOURCES = \
+src/tests/enesim_test_renderer_stream.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_stream_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_stream_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_block_SOURCES = \
+src/tests/enesim_test_renderer_block.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_block_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_block_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_coverage_SOURCES = \
+src/tests/enesim_test_renderer_coverage.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_coverage_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_coverage_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_analytic_SOURCES = \
+src/tests/enesim_test_renderer_analytic.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_analytic_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_analytic_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_test_renderer_rasterizer_SOURCES = \
+src/tests/enesim_test_renderer_rasterizer.c \
+src/tests/enesim_test_helper.c \
+src/tests/enesim_test_helper.h
+src_tests_enesim_test_renderer_rasterizer_LDADD = $(tests_LDADD)
+src_tests_enesim_test_renderer_rasterizer_CPPFLAGS = $(tests_CPPFLAGS)
+
+src_tests_enesim_bench_compositor_SOURCES = src/tests/enesim_bench_compositor.c
+src_tests_enesim_bench_compositor_LDADD = $(tests_LDADD)
+src_tests_enesim_bench_compositor_LDFLAGS = -static
+src_tests_enesim_bench_compositor_CPPFLAGS = $(tests_CPPFLAGS)
@@ -0,0 +1,502 @@
+#include "Enesim.h"
+#include "enesim_compositor_private.h"
+#include "enesim_converter_private.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Time every registered span, point and converter function for several
+ * lengths, alignments and alpha distributions and print the Mpixels/s of
+ * each one as comma separated values. Every function is timed with the
+ * generic, the SSE2 and the AVX2 implementations, selected through the
+ * ENESIM_CPU_DISABLE variable, but an implementation is only printed when
+ * it is not the same function than a lower one.
+ * The -t option sets the milliseconds every case is timed
+ */
+#define MAX_LEN 4096
+#define CONVERTER_HEIGHT 16
+/* enough for a destination, source and mask of argb8888 pixels */
+#define BUFFER_SIZE ((MAX_LEN + 16) * sizeof(uint32_t))
+#define MAX_SEEN 1024
+
+typedef enum _Alpha
+{
+	ALPHA_OPAQUE,
+	ALPHA_TRANSPARENT,
+	ALPHA_RANDOM,
+	ALPHA_RUNS,
+	ALPHA_LAST,
+} Alpha;
+
+typedef struct _Impl
+{
+	const char *name;
+	/* the ENESIM_CPU_DISABLE value, NULL for every feature */
+	const char *disable;
+} Impl;
+
+static const Impl _impls[] = {
+	{ "generic", "all" },
+	{ "sse2", "avx2" },
+	{ "avx2", NULL },
+};
+
+static const char *_rops[ENESIM_ROP_LAST] = {
+	"blend",
+	"fill",
+	"dst_out",
+	"src_in",
+	"dst_in",
+	"multiply",
+	"screen",
+};
+
+static const char *_formats[ENESIM_FORMAT_LAST] = {
+	"none",
+	"argb8888",
+	"a8",
+};
+
+static const char *_buffer_formats[ENESIM_BUFFER_FORMATS] = {
+	"rgb565",
+	"argb8888",
+	"argb8888_pre",
+	"xrgb8888",
+	"rgb888",
+	"bgr888",
+	"a8",
+	"gray",
+	"cmyk",
+	"cmyk_adobe",
+};
+
+static const char *_angles[ENESIM_ANGLE_LAST] = {
+	"0",
+	"90",
+	"180",
+	"270",
+};
+
+static const char *_alphas[ALPHA_LAST] = {
+	"opaque",
+	"transparent",
+	"random",
+	"runs",
+};
+
+static const int _lengths[] = { 8, 64, 512, MAX_LEN };
+static const int _aligns[] = { 0, 1 };
+
+static const char *_impl;
+static double _budget = 1e-3;
+/* the functions already timed, to not time them again on another
+ * implementation
+ */
+typedef struct _Seen
+{
+	void *f;
+	int key;
+} Seen;
+
+static Seen _seen[MAX_SEEN];
+static int _nseen;
+
+static uint8_t *_dst;
+static uint8_t *_src;
+static uint8_t *_mask;
+
+static uint32_t _random(void)
+{
+	static uint32_t x = 0x12345678;
+
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return x;
+}
+
+static uint8_t _alpha_get(Alpha alpha, int i)
+{
+	switch (alpha)
+	{
+		case ALPHA_OPAQUE:
+		return 0xff;
+
+		case ALPHA_TRANSPARENT:
+		return 0;
+
+		case ALPHA_RUNS:
+		/* runs of transparent, opaque and translucent pixels */
+		switch ((i / 32) % 3)
+		{
+			case 0:
+			return 0;
+			case 1:
+			return 0xff;
+			default:
+			break;
+		}
+		return _random() & 0xff;
+
+		default:
+		return _random() & 0xff;
+	}
+}
+
+/* premultiplied argb8888 pixels, the a8 formats only use the first bytes */
+static void _pixels_fill(uint8_t *data, Alpha alpha)
+{
+	uint32_t *d = (uint32_t *)data;
+	int i;
+
+	for (i = 0; i < (int)(BUFFER_SIZE / sizeof(uint32_t)); i++)
+	{
+		uint32_t a = _alpha_get(alpha, i);
+		uint32_t c = _random();
+
+		d[i] = (a << 24) | ((((c >> 16) & 0xff) * a / 255) << 16) |
+				((((c >> 8) & 0xff) * a / 255) << 8) |
+				((c & 0xff) * a / 255);
+	}
+}
+
+static void _a8_fill(uint8_t *data, Alpha alpha)
+{
+	int i;
+
+	for (i = 0; i < (int)BUFFER_SIZE; i++)
+		data[i] = _alpha_get(alpha, i);
+}
+
+static double _time_get(void)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+/* the same function can be registered for several operations, the key
+ * is the operation
+ */
+static Eina_Bool _seen_check(void *f, int type, int rop, int dfmt, int sfmt,
+		int color, int mfmt)
+{
+	int key;
+	int i;
+
+	key = (((((type * 16 + rop) * 16 + dfmt) * 16 + sfmt) * 2 + color)
+			* 16) + mfmt;
+	for (i = 0; i < _nseen; i++)
+	{
+		if (_seen[i].f == f && _seen[i].key == key)
+			return EINA_TRUE;
+	}
+	if (_nseen < MAX_SEEN)
+	{
+		_seen[_nseen].f = f;
+		_seen[_nseen].key = key;
+		_nseen++;
+	}
+	return EINA_FALSE;
+}
+
+static void * _offset(void *data, Enesim_Format fmt, int align)
+{
+	return (uint8_t *)data + (fmt == ENESIM_FORMAT_A8 ? align : align * 4);
+}
+
+static void _data_setup(Enesim_Format dfmt, Enesim_Format sfmt,
+		Enesim_Format mfmt, Alpha alpha)
+{
+	if (dfmt == ENESIM_FORMAT_A8)
+		_a8_fill(_dst, ALPHA_RANDOM);
+	else
+		_pixels_fill(_dst, ALPHA_RANDOM);
+	if (sfmt == ENESIM_FORMAT_A8)
+		_a8_fill(_src, alpha);
+	else
+		_pixels_fill(_src, alpha);
+	if (mfmt == ENESIM_FORMAT_A8)
+		_a8_fill(_mask, alpha);
+	else
+		_pixels_fill(_mask, alpha);
+}
+
+/* the color alpha follows the distribution too when there is no source
+ * or mask to do it
+ */
+static uint32_t _color_get(Eina_Bool color, Enesim_Format sfmt,
+		Enesim_Format mfmt, Alpha alpha)
+{
+	if (!color)
+		return 0xffffffff;
+	if (sfmt || mfmt)
+		return 0xc0804020;
+	switch (alpha)
+	{
+		case ALPHA_OPAQUE:
+		return 0xff804020;
+		case ALPHA_TRANSPARENT:
+		return 0;
+		default:
+		return 0x80402010;
+	}
+}
+
+static void _print(const char *type, const char *rop, const char *dfmt,
+		const char *sfmt, const char *color, const char *mfmt, int len,
+		int align, Alpha alpha, double mpix)
+{
+	printf("%s,%s,%s,%s,%s,%s,%s,%d,%d,%s,%.2f\n", type, rop, dfmt, sfmt,
+			color, mfmt, _impl, len, align, _alphas[alpha], mpix);
+}
+
+static void _span_cb(Enesim_Compositor_Span sp, Enesim_Rop rop,
+		Enesim_Format dfmt, Enesim_Format sfmt, Eina_Bool color,
+		Enesim_Format mfmt, void *data EINA_UNUSED)
+{
+	unsigned int l, a;
+	Alpha alpha;
+
+	if (_seen_check(sp, 0, rop, dfmt, sfmt, color, mfmt))
+		return;
+
+	for (alpha = 0; alpha < ALPHA_LAST; alpha++)
+	{
+		uint32_t c = _color_get(color, sfmt, mfmt, alpha);
+
+		_data_setup(dfmt, sfmt, mfmt, alpha);
+		for (l = 0; l < sizeof(_lengths) / sizeof(int); l++)
+		{
+			for (a = 0; a < sizeof(_aligns) / sizeof(int); a++)
+			{
+				uint32_t *d, *s, *m;
+				double start, elapsed;
+				int len = _lengths[l];
+				int n = 1;
+				int i;
+
+				d = _offset(_dst, dfmt, _aligns[a]);
+				s = _offset(_src, sfmt, _aligns[a]);
+				m = _offset(_mask, mfmt, _aligns[a]);
+				for (;;)
+				{
+					start = _time_get();
+					for (i = 0; i < n; i++)
+						sp(d, len, s, c, m);
+					elapsed = _time_get() - start;
+					if (elapsed >= _budget)
+						break;
+					n *= 2;
+				}
+				_print("span", _rops[rop], _formats[dfmt],
+						_formats[sfmt],
+						color ? "color" : "none",
+						_formats[mfmt], len, _aligns[a],
+						alpha, (double)n * len / elapsed / 1e6);
+			}
+		}
+	}
+}
+
+static void _point_cb(Enesim_Compositor_Point pt, Enesim_Rop rop,
+		Enesim_Format dfmt, Enesim_Format sfmt, Eina_Bool color,
+		Enesim_Format mfmt, void *data EINA_UNUSED)
+{
+	unsigned int l, a;
+	Alpha alpha;
+
+	if (_seen_check(pt, 1, rop, dfmt, sfmt, color, mfmt))
+		return;
+
+	for (alpha = 0; alpha < ALPHA_LAST; alpha++)
+	{
+		uint32_t c = _color_get(color, sfmt, mfmt, alpha);
+
+		/* the point functions get the source and mask pixels by value */
+		_data_setup(dfmt, ENESIM_FORMAT_ARGB8888,
+				ENESIM_FORMAT_ARGB8888, alpha);
+		for (l = 0; l < sizeof(_lengths) / sizeof(int); l++)
+		{
+			for (a = 0; a < sizeof(_aligns) / sizeof(int); a++)
+			{
+				uint32_t *d, *s, *m;
+				double start, elapsed;
+				int len = _lengths[l];
+				int n = 1;
+				int i, j;
+
+				d = _offset(_dst, dfmt, _aligns[a]);
+				s = (uint32_t *)_src;
+				m = (uint32_t *)_mask;
+				for (;;)
+				{
+					start = _time_get();
+					for (i = 0; i < n; i++)
+					{
+						for (j = 0; j < len; j++)
+							pt(d + j, s[j], c, m[j]);
+					}
+					elapsed = _time_get() - start;
+					if (elapsed >= _budget)
+						break;
+					n *= 2;
+				}
+				_print("point", _rops[rop], _formats[dfmt],
+						_formats[sfmt],
+						color ? "color" : "none",
+						_formats[mfmt], len, _aligns[a],
+						alpha, (double)n * len / elapsed / 1e6);
+			}
+		}
+	}
+}
+
+static void _sw_data_set(Enesim_Buffer_Sw_Data *data, Enesim_Buffer_Format fmt,
+		uint8_t *plane0, int stride)
+{
+	switch (fmt)
+	{
+		case ENESIM_BUFFER_FORMAT_RGB565:
+		data->rgb565.plane0 = (uint16_t *)plane0;
+		data->rgb565.plane0_stride = stride;
+		break;
+
+		case ENESIM_BUFFER_FORMAT_A8:
+		case ENESIM_BUFFER_FORMAT_GRAY:
+		data->a8.plane0 = plane0;
+		data->a8.plane0_stride = stride;
+		break;
+
+		case ENESIM_BUFFER_FORMAT_RGB888:
+		case ENESIM_BUFFER_FORMAT_BGR888:
+		case ENESIM_BUFFER_FORMAT_CMYK:
+		case ENESIM_BUFFER_FORMAT_CMYK_ADOBE:
+		data->rgb888.plane0 = plane0;
+		data->rgb888.plane0_stride = stride;
+		break;
+
+		default:
+		data->argb8888.plane0 = (uint32_t *)plane0;
+		data->argb8888.plane0_stride = stride;
+		break;
+	}
+}
+
+static void _converter_cb(Enesim_Converter_2D cnv, Enesim_Buffer_Format dfmt,
+		Enesim_Angle angle, Enesim_Buffer_Format sfmt,
+		void *data EINA_UNUSED)
+{
+	uint8_t *dst, *src;
+	unsigned int l;
+	Alpha alpha;
+
+	if (_seen_check(cnv, 2, 0, dfmt, sfmt, 0, angle))
+		return;
+
+	dst = malloc(enesim_buffer_format_size_get(dfmt, MAX_LEN,
+			CONVERTER_HEIGHT));
+	src = malloc(enesim_buffer_format_size_get(sfmt, MAX_LEN,
+			CONVERTER_HEIGHT));
+	for (alpha = 0; alpha < ALPHA_LAST; alpha++)
+	{
+		int y;
+
+		/* every row of the source has the same pixels */
+		_pixels_fill(_src, alpha);
+		for (y = 0; y < CONVERTER_HEIGHT; y++)
+		{
+			size_t stride = enesim_buffer_format_size_get(sfmt,
+					MAX_LEN, 1);
+			memcpy(src + y * stride, _src, stride);
+		}
+
+		for (l = 0; l < sizeof(_lengths) / sizeof(int); l++)
+		{
+			Enesim_Buffer_Sw_Data ddata;
+			Enesim_Buffer_Sw_Data sdata;
+			double start, elapsed;
+			int len = _lengths[l];
+			int n = 1;
+			int i;
+
+			_sw_data_set(&ddata, dfmt, dst,
+					enesim_buffer_format_size_get(dfmt,
+					len, 1));
+			_sw_data_set(&sdata, sfmt, src,
+					enesim_buffer_format_size_get(sfmt,
+					MAX_LEN, 1));
+			for (;;)
+			{
+				start = _time_get();
+				for (i = 0; i < n; i++)
+					cnv(&ddata, len, CONVERTER_HEIGHT,
+							&sdata, len,
+							CONVERTER_HEIGHT);
+				elapsed = _time_get() - start;
+				if (elapsed >= _budget)
+					break;
+				n *= 2;
+			}
+			_print("converter", "none", _buffer_formats[dfmt],
+					_buffer_formats[sfmt], "none",
+					_angles[angle], len, 0, alpha,
+					(double)n * len * CONVERTER_HEIGHT /
+					elapsed / 1e6);
+		}
+	}
+	free(dst);
+	free(src);
+}
+
+int main(int argc, char **argv)
+{
+	unsigned int i;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "t:")) != -1)
+	{
+		switch (opt)
+		{
+			case 't':
+			_budget = atof(optarg) / 1000;
+			break;
+
+			default:
+			fprintf(stderr, "Usage: %s [-t msecs]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	if (posix_memalign((void **)&_dst, 64, BUFFER_SIZE) ||
+			posix_memalign((void **)&_src, 64, BUFFER_SIZE) ||
+			posix_memalign((void **)&_mask, 64, BUFFER_SIZE))
+		return 1;
+
+	/* the converters have no color nor mask, the angle goes on the mask
+	 * column
+	 */
+	printf("# type,rop,dfmt,sfmt,color,mask,impl,len,align,alpha,mpix_s\n");
+	for (i = 0; i < sizeof(_impls) / sizeof(Impl); i++)
+	{
+		/* the cpu features are read on init */
+		if (_impls[i].disable)
+			setenv("ENESIM_CPU_DISABLE", _impls[i].disable, 1);
+		else
+			unsetenv("ENESIM_CPU_DISABLE");
+		_impl = _impls[i].name;
+		enesim_init();
+		enesim_compositor_span_foreach(_span_cb, NULL);
+		enesim_compositor_point_foreach(_point_cb, NULL);
+		enesim_converter_surface_foreach(_converter_cb, NULL);
+		enesim_shutdown();
+	}
+
+	free(_dst);
+	free(_src);
+	free(_mask);
+
+	return 0;
+}
@@ -0,0 +1,264 @@
+#include "enesim_test_helper.h"
+#include "enesim_compositor_private.h"
+#include <stdlib.h>
+
+/* Draw with the SIMD compositor functions and with the generic ones and
+ * check that every result is equal. Every level of SIMD functions is
+ * checked by disabling the levels above it. The blend and fill draws are done on a8
+ * surfaces too, the result must be the alpha of the argb8888 one. The blend
+ * point functions are checked on every pixel of a surface too
+ */
+#define WIDTH 251
+#define HEIGHT 97
+/* renderer, color and mask combinations for every rop */
+#define NCOMBS 8
+#define NDRAWS (NCOMBS * ENESIM_ROP_LAST)
+/* the rops the a8 compositor has */
+#define NA8DRAWS (NCOMBS * 2)
+/* color, mask color and pixel blend points */
+#define NPOINTS 3
+#define NLEVELS 3
+
+static const char *_rops[ENESIM_ROP_LAST] = {
+	"blend",
+	"fill",
+	"dst out",
+	"src in",
+	"dst in",
+	"multiply",
+	"screen",
+};
+
+/* the features to disable and the name of the level checked */
+static const char *_levels[NLEVELS][2] = {
+	{ "", "best" },
+	{ "avx2", "ssse3" },
+	{ "avx2,ssse3", "sse2" },
+};
+
+static const char *_points[NPOINTS] = {
+	"color",
+	"mask color",
+	"pixel",
+};
+
+static Enesim_Renderer * _shape_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_circle_new();
+	enesim_renderer_circle_center_set(r, 120.5, 50.3);
+	enesim_renderer_circle_radius_set(r, 60);
+	enesim_renderer_shape_fill_color_set(r, 0x80008000);
+	enesim_renderer_shape_stroke_color_set(r, 0xff000080);
+	enesim_renderer_shape_stroke_weight_set(r, 5);
+	enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE_FILL);
+	return r;
+}
+
+/* the gradient does not colorize, the compositor does it */
+static Enesim_Renderer * _gradient_new(void)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer_Gradient_Stop stop;
+
+	r = enesim_renderer_gradient_linear_new();
+	enesim_renderer_gradient_linear_position_set(r, 10, 0, 200, 50);
+	stop.argb = 0x00000000;
+	stop.pos = 0;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	stop.argb = 0xffff8000;
+	stop.pos = 0.5;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	stop.argb = 0x80000080;
+	stop.pos = 1;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	return r;
+}
+
+static Enesim_Renderer * _mask_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_checker_new();
+	enesim_renderer_checker_even_color_set(r, 0xffffffff);
+	enesim_renderer_checker_odd_color_set(r, 0x40404040);
+	enesim_renderer_checker_width_set(r, 13);
+	enesim_renderer_checker_height_set(r, 7);
+	return r;
+}
+
+/* draw every combination of renderer, rop, color and mask and keep the
+ * result
+ */
+static void _draw(void *dst[], int ndraws, Enesim_Format fmt)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *mask;
+	Enesim_Surface *s;
+	int i;
+
+	for (i = 0; i < ndraws; i++)
+	{
+		r = (i & 4) ? _gradient_new() : _shape_new();
+		if (i & 1)
+			enesim_renderer_color_set(r, 0xc0c0c0c0);
+		if (i & 2)
+		{
+			mask = _mask_new();
+			enesim_renderer_mask_set(r, mask);
+		}
+		s = enesim_surface_new(fmt, WIDTH, HEIGHT);
+		enesim_test_surface_pattern_set(s);
+		enesim_renderer_draw(r, s, i / NCOMBS, NULL, 3, 1, NULL);
+
+		dst[i] = enesim_test_surface_pixels_get(s);
+		enesim_surface_unref(s);
+		enesim_renderer_unref(r);
+	}
+}
+
+/* apply every blend point on every pixel with a different source and mask
+ * alpha on each one
+ */
+static void _point_draw(void *dst[])
+{
+	Enesim_Compositor_Point pts[NPOINTS];
+	Enesim_Format fmt = ENESIM_FORMAT_ARGB8888;
+	Enesim_Surface *s;
+	uint32_t *data;
+	size_t stride;
+	int i, x, y;
+
+	pts[0] = enesim_compositor_point_get(ENESIM_ROP_BLEND, &fmt,
+			ENESIM_FORMAT_NONE, 0xc0804020, ENESIM_FORMAT_NONE);
+	pts[1] = enesim_compositor_point_get(ENESIM_ROP_BLEND, &fmt,
+			ENESIM_FORMAT_NONE, 0xc0804020, ENESIM_FORMAT_ARGB8888);
+	pts[2] = enesim_compositor_point_get(ENESIM_ROP_BLEND, &fmt,
+			ENESIM_FORMAT_ARGB8888, ENESIM_COLOR_FULL,
+			ENESIM_FORMAT_NONE);
+	for (i = 0; i < NPOINTS; i++)
+	{
+		s = enesim_surface_new(fmt, WIDTH, HEIGHT);
+		enesim_test_surface_pattern_set(s);
+		enesim_surface_sw_data_get(s, (void **)&data, &stride);
+		for (y = 0; y < HEIGHT; y++)
+		{
+			uint32_t *d = (uint32_t *)((uint8_t *)data + y * stride);
+
+			for (x = 0; x < WIDTH; x++)
+			{
+				uint32_t a = (x * 11 + y * 7) & 0xff;
+
+				pts[i](&d[x], (a << 24) | (a << 16) | ((a / 2) << 8),
+						0xc0804020, a << 24);
+			}
+		}
+		dst[i] = enesim_test_surface_pixels_get(s);
+		enesim_surface_unref(s);
+	}
+}
+
+/* compare the draws of a level with the generic ones */
+static int _level_check(const char *level,
+		uint32_t *generic[], uint8_t *generic_a8[],
+		uint32_t *generic_pt[])
+{
+	uint32_t *simd[NDRAWS];
+	uint8_t *simd_a8[NA8DRAWS];
+	uint32_t *simd_pt[NPOINTS];
+	int ret = 0;
+	int i, j;
+
+	enesim_init();
+	_draw((void **)simd, NDRAWS, ENESIM_FORMAT_ARGB8888);
+	_draw((void **)simd_a8, NA8DRAWS, ENESIM_FORMAT_A8);
+	_point_draw((void **)simd_pt);
+	enesim_shutdown();
+
+	for (i = 0; i < NDRAWS; i++)
+	{
+		Eina_Bool equal;
+
+		equal = !memcmp(simd[i], generic[i],
+				WIDTH * HEIGHT * sizeof(uint32_t));
+		printf("%s %s%s%s (%s): %s\n", (i & 4) ? "Gradient" : "Shape",
+				_rops[i / NCOMBS],
+				(i & 1) ? " with color" : "",
+				(i & 2) ? " with mask" : "",
+				level, equal ? "ok" : "different");
+		if (!equal)
+			ret = 1;
+	}
+
+	for (i = 0; i < NA8DRAWS; i++)
+	{
+		Eina_Bool equal = EINA_TRUE;
+
+		for (j = 0; j < WIDTH * HEIGHT; j++)
+		{
+			if (simd_a8[i][j] != simd[i][j] >> 24 ||
+					generic_a8[i][j] != simd[i][j] >> 24)
+				equal = EINA_FALSE;
+		}
+		printf("%s %s%s%s on a8 (%s): %s\n", (i & 4) ? "Gradient" : "Shape",
+				_rops[i / NCOMBS],
+				(i & 1) ? " with color" : "",
+				(i & 2) ? " with mask" : "",
+				level, equal ? "ok" : "different");
+		if (!equal)
+			ret = 1;
+		free(simd_a8[i]);
+	}
+
+	for (i = 0; i < NPOINTS; i++)
+	{
+		Eina_Bool equal;
+
+		equal = !memcmp(simd_pt[i], generic_pt[i],
+				WIDTH * HEIGHT * sizeof(uint32_t));
+		printf("Blend point %s (%s): %s\n", _points[i], level,
+				equal ? "ok" : "different");
+		if (!equal)
+			ret = 1;
+		free(simd_pt[i]);
+	}
+
+	for (i = 0; i < NDRAWS; i++)
+		free(simd[i]);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t *generic[NDRAWS];
+	uint8_t *generic_a8[NA8DRAWS];
+	uint32_t *generic_pt[NPOINTS];
+	int ret = 0;
+	int i;
+
+	/* the cpu features are read on init */
+	setenv("ENESIM_CPU_DISABLE", "all", 1);
+	enesim_init();
+	_draw((void **)generic, NDRAWS, ENESIM_FORMAT_ARGB8888);
+	_draw((void **)generic_a8, NA8DRAWS, ENESIM_FORMAT_A8);
+	_point_draw((void **)generic_pt);
+	enesim_shutdown();
+
+	for (i = 0; i < NLEVELS; i++)
+	{
+		setenv("ENESIM_CPU_DISABLE", _levels[i][0], 1);
+		ret |= _level_check(_levels[i][1], generic, generic_a8,
+				generic_pt);
+	}
+
+	for (i = 0; i < NDRAWS; i++)
+		free(generic[i]);
+	for (i = 0; i < NA8DRAWS; i++)
+		free(generic_a8[i]);
+	for (i = 0; i < NPOINTS; i++)
+		free(generic_pt[i]);
+
+	return ret;
+}
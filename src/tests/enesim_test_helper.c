@@ -0,0 +1,127 @@
+#include "enesim_test_helper.h"
+#include <stdlib.h>
+
+static size_t _bpp_get(Enesim_Surface *s)
+{
+	return enesim_surface_format_get(s) == ENESIM_FORMAT_A8 ? 1 :
+			sizeof(uint32_t);
+}
+
+/* A new surface with every pixel set to a value no renderer writes, to know
+ * that every pixel is written when filling it
+ */
+Enesim_Surface * enesim_test_surface_new(Enesim_Format fmt, int w, int h)
+{
+	Enesim_Surface *s;
+	uint8_t *data;
+	size_t stride;
+
+	s = enesim_surface_new(fmt, w, h);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	memset(data, 0x55, stride * h);
+	return s;
+}
+
+/* Set a different alpha on every pixel, for the rops that read the
+ * destination
+ */
+void enesim_test_surface_pattern_set(Enesim_Surface *s)
+{
+	uint8_t *data;
+	size_t stride;
+	size_t bpp;
+	int w, h;
+	int x, y;
+
+	bpp = _bpp_get(s);
+	enesim_surface_size_get(s, &w, &h);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	for (y = 0; y < h; y++)
+	{
+		uint8_t *d = data + y * stride;
+
+		for (x = 0; x < w; x++)
+		{
+			uint8_t a = (x * 5 + y * 3) & 0xff;
+
+			if (bpp == 1)
+				d[x] = a;
+			else
+				((uint32_t *)d)[x] = (a << 24) | ((a / 2) << 16) |
+						((a / 3) << 8) | (a / 4);
+		}
+	}
+}
+
+/* The maximum difference between the components of two surfaces of the same
+ * size and format, zero if both are equal
+ */
+int enesim_test_surface_difference(Enesim_Surface *s1, Enesim_Surface *s2)
+{
+	uint8_t *d1, *d2;
+	size_t stride1, stride2;
+	size_t len;
+	int max = 0;
+	int w, h;
+
+	enesim_surface_size_get(s1, &w, &h);
+	len = w * _bpp_get(s1);
+	enesim_surface_sw_data_get(s1, (void **)&d1, &stride1);
+	enesim_surface_sw_data_get(s2, (void **)&d2, &stride2);
+	while (h--)
+	{
+		size_t i;
+
+		if (memcmp(d1, d2, len))
+		{
+			for (i = 0; i < len; i++)
+			{
+				int diff = abs(d1[i] - d2[i]);
+
+				if (diff > max)
+					max = diff;
+			}
+		}
+		d1 += stride1;
+		d2 += stride2;
+	}
+	return max;
+}
+
+/* A copy of the pixels without the stride, to compare draws done on
+ * different inits of the library
+ */
+void * enesim_test_surface_pixels_get(Enesim_Surface *s)
+{
+	uint8_t *data;
+	uint8_t *pixels;
+	size_t stride;
+	size_t len;
+	int w, h;
+	int y;
+
+	enesim_surface_size_get(s, &w, &h);
+	len = w * _bpp_get(s);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	pixels = malloc(len * h);
+	for (y = 0; y < h; y++)
+		memcpy(pixels + y * len, data + y * stride, len);
+	return pixels;
+}
+
+/* Fill a new argb8888 surface with the renderer */
+Enesim_Surface * enesim_test_draw(Enesim_Renderer *r, int w, int h)
+{
+	Enesim_Surface *s;
+
+	s = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, w, h);
+	enesim_renderer_draw(r, s, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	return s;
+}
+
+/* Print the result of a check, returns the exit code for it */
+int enesim_test_result(const char *name, Eina_Bool ok)
+{
+	printf("%s: %s\n", name, ok ? "ok" : "different");
+	return ok ? 0 : 1;
+}
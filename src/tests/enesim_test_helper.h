@@ -0,0 +1,14 @@
+#ifndef ENESIM_TEST_HELPER_H_
+#define ENESIM_TEST_HELPER_H_
+
+#include "Enesim.h"
+
+/* Surface functions shared by the tests that compare two ways of drawing */
+Enesim_Surface * enesim_test_surface_new(Enesim_Format fmt, int w, int h);
+void enesim_test_surface_pattern_set(Enesim_Surface *s);
+int enesim_test_surface_difference(Enesim_Surface *s1, Enesim_Surface *s2);
+void * enesim_test_surface_pixels_get(Enesim_Surface *s);
+Enesim_Surface * enesim_test_draw(Enesim_Renderer *r, int w, int h);
+int enesim_test_result(const char *name, Eina_Bool ok);
+
+#endif /*ENESIM_TEST_HELPER_H_*/
@@ -0,0 +1,188 @@
+#include "Enesim.h"
+#include <stdlib.h>
+#include <unistd.h>
+
+/* Load several images asynchronously on a context with a single thread. The
+ * provider of the images blocks the thread on the first load, so the other
+ * jobs are queued while their priorities are changed and one of them is
+ * cancelled. Once released, the jobs must be loaded in priority order and
+ * every callback must be called with the expected result
+ */
+#define MIME "image/x-enesim-test"
+#define NJOBS 8
+
+/* the priority of every job after the first one, in order of request */
+static Enesim_Priority _priorities[NJOBS - 1] = {
+	ENESIM_PRIORITY_PRIMARY,
+	ENESIM_PRIORITY_MARGINAL,
+	ENESIM_PRIORITY_PRIMARY,
+	ENESIM_PRIORITY_NONE,
+	ENESIM_PRIORITY_SECONDARY,
+	ENESIM_PRIORITY_SECONDARY,
+	ENESIM_PRIORITY_PRIMARY,
+};
+/* the job to cancel */
+#define CANCELLED 6
+/* the jobs with the same priority keep the order of request */
+static int _expected[NJOBS - 1] = { 0, 1, 3, 7, 5, 2, 4 };
+
+static Eina_Lock _lock;
+static Eina_Condition _cond;
+static Eina_Bool _blocked = EINA_FALSE;
+static Eina_Bool _released = EINA_FALSE;
+static int _loaded[NJOBS];
+static int _nloaded = 0;
+static int _called = 0;
+static int _ret = 0;
+
+static Eina_Bool _test_info_get(Enesim_Stream *data, int *w, int *h,
+		Enesim_Buffer_Format *sfmt, void *options, Eina_Error *err)
+{
+	*w = 1;
+	*h = 1;
+	*sfmt = ENESIM_BUFFER_FORMAT_ARGB8888_PRE;
+	return EINA_TRUE;
+}
+
+/* the stream has the index of the job, the first one waits to be released */
+static Eina_Bool _test_load(Enesim_Stream *data, Enesim_Buffer *b,
+		void *options, Eina_Error *err)
+{
+	int idx;
+
+	enesim_stream_read(data, &idx, sizeof(int));
+	eina_lock_take(&_lock);
+	if (!idx)
+	{
+		_blocked = EINA_TRUE;
+		eina_condition_broadcast(&_cond);
+		while (!_released)
+			eina_condition_wait(&_cond);
+	}
+	_loaded[_nloaded++] = idx;
+	eina_lock_release(&_lock);
+	return EINA_TRUE;
+}
+
+static Enesim_Image_Provider_Descriptor _test_provider = {
+	/* .version = 		*/ ENESIM_IMAGE_PROVIDER_DESCRIPTOR_VERSION,
+	/* .name = 		*/ "test",
+	/* .options_parse = 	*/ NULL,
+	/* .options_free = 	*/ NULL,
+	/* .loadable = 		*/ NULL,
+	/* .saveable = 		*/ NULL,
+	/* .info_get = 		*/ _test_info_get,
+	/* .formats_get = 	*/ NULL,
+	/* .load = 		*/ _test_load,
+	/* .save = 		*/ NULL,
+};
+
+static void _load_cb(Enesim_Buffer *b, void *data, int error)
+{
+	int idx = (int)(long)data;
+
+	_called++;
+	if (idx == CANCELLED)
+	{
+		if (error != ENESIM_IMAGE_ERROR_CANCELLED)
+		{
+			printf("Job %d was cancelled but finished with %d\n", idx, error);
+			_ret = 1;
+		}
+		return;
+	}
+	if (error)
+	{
+		printf("Job %d failed with %d\n", idx, error);
+		_ret = 1;
+		return;
+	}
+	enesim_buffer_unref(b);
+}
+
+int main(int argc, char **argv)
+{
+	Enesim_Image_Context *ctx;
+	Enesim_Image_Job *jobs[NJOBS];
+	Enesim_Stream *streams[NJOBS];
+	int i;
+
+	enesim_init();
+	eina_lock_new(&_lock);
+	eina_condition_new(&_cond, &_lock);
+	enesim_image_provider_register(&_test_provider,
+			ENESIM_PRIORITY_PRIMARY, MIME);
+
+	ctx = enesim_image_context_new();
+	enesim_image_context_threads_max_set(ctx, 1);
+	for (i = 0; i < NJOBS; i++)
+	{
+		int *idx;
+
+		/* the stream owns the data */
+		idx = malloc(sizeof(int));
+		*idx = i;
+		streams[i] = enesim_stream_buffer_new(idx, sizeof(int));
+		jobs[i] = enesim_image_context_load_async(ctx, streams[i],
+				MIME, NULL, NULL, _load_cb,
+				(void *)(long)i, NULL);
+		if (!jobs[i])
+		{
+			printf("Can not load the image\n");
+			return 1;
+		}
+		/* wait for the thread to block on the first job */
+		if (!i)
+		{
+			eina_lock_take(&_lock);
+			while (!_blocked)
+				eina_condition_wait(&_cond);
+			eina_lock_release(&_lock);
+		}
+	}
+	/* every job but the first one is queued now */
+	for (i = 1; i < NJOBS; i++)
+		enesim_image_context_job_priority_set(ctx, jobs[i],
+				_priorities[i - 1]);
+	if (!enesim_image_context_job_cancel(ctx, jobs[CANCELLED]))
+	{
+		printf("Queued job %d can not be cancelled\n", CANCELLED);
+		_ret = 1;
+	}
+	if (enesim_image_context_job_cancel(ctx, jobs[0]))
+	{
+		printf("Running job 0 has been cancelled\n");
+		_ret = 1;
+	}
+	eina_lock_take(&_lock);
+	_released = EINA_TRUE;
+	eina_condition_broadcast(&_cond);
+	eina_lock_release(&_lock);
+
+	while (_called < NJOBS)
+	{
+		enesim_image_context_dispatch(ctx);
+		usleep(1000);
+	}
+	enesim_image_context_free(ctx);
+
+	printf("Load order:");
+	for (i = 0; i < _nloaded; i++)
+		printf(" %d", _loaded[i]);
+	printf("\n");
+	if (_nloaded != NJOBS - 1 || memcmp(_loaded, _expected,
+			sizeof(int) * (NJOBS - 1)))
+	{
+		printf("The jobs are not loaded in priority order\n");
+		_ret = 1;
+	}
+
+	for (i = 0; i < NJOBS; i++)
+		enesim_stream_unref(streams[i]);
+	enesim_image_provider_unregister(&_test_provider, MIME);
+	eina_condition_free(&_cond);
+	eina_lock_free(&_lock);
+	enesim_shutdown();
+
+	return _ret;
+}
@@ -0,0 +1,216 @@
+#include "enesim_test_helper.h"
+#include <math.h>
+
+/* The rectangles, circles and ellipses that are only scaled are drawn with
+ * the exact area of every pixel on the default and the good quality, without
+ * generating the path. Draw them and check that both qualities are equal,
+ * that the sum of the coverage is the area of the shape, and that every
+ * pixel is close to the same path drawn with the exact area rasterizer,
+ * which only differs on the flattening of the arcs
+ */
+#define WIDTH 160
+#define HEIGHT 120
+#define NSHAPES 7
+/* the most a component can differ from the path */
+#define MAX_DIFFERENCE 32
+
+static const char *_names[NSHAPES] = {
+	"Rectangle",
+	"Rounded rectangle",
+	"Rounded rectangle with two corners",
+	"Circle",
+	"Ellipse",
+	"Scaled ellipse with origin",
+	"Rectangle with a fill renderer",
+};
+
+static Enesim_Renderer * _shape_new(int i, Enesim_Path *p, double *area)
+{
+	Enesim_Renderer *r;
+	Enesim_Matrix m;
+
+	switch (i)
+	{
+		case 0:
+		case 6:
+		r = enesim_renderer_rectangle_new();
+		enesim_renderer_rectangle_position_set(r, 10.3, 20.6);
+		enesim_renderer_rectangle_size_set(r, 101.2, 60.7);
+		enesim_path_move_to(p, 10.3, 20.6);
+		enesim_path_line_to(p, 111.5, 20.6);
+		enesim_path_line_to(p, 111.5, 81.3);
+		enesim_path_line_to(p, 10.3, 81.3);
+		enesim_path_close(p);
+		*area = 101.2 * 60.7;
+		break;
+
+		case 1:
+		case 2:
+		r = enesim_renderer_rectangle_new();
+		enesim_renderer_rectangle_position_set(r, 10.3, 20.6);
+		enesim_renderer_rectangle_size_set(r, 101.2, 60.7);
+		enesim_renderer_rectangle_corner_radii_set(r, 20.4, 12.2);
+		enesim_renderer_rectangle_corners_set(r, EINA_TRUE, i == 1,
+				i == 1, EINA_TRUE);
+		enesim_path_move_to(p, 10.3, 20.6 + 12.2);
+		enesim_path_arc_to(p, 20.4, 12.2, 0, EINA_FALSE, EINA_TRUE,
+				10.3 + 20.4, 20.6);
+		if (i == 1)
+		{
+			enesim_path_line_to(p, 111.5 - 20.4, 20.6);
+			enesim_path_arc_to(p, 20.4, 12.2, 0, EINA_FALSE,
+					EINA_TRUE, 111.5, 20.6 + 12.2);
+		}
+		else
+		{
+			enesim_path_line_to(p, 111.5, 20.6);
+		}
+		enesim_path_line_to(p, 111.5, 81.3 - 12.2);
+		enesim_path_arc_to(p, 20.4, 12.2, 0, EINA_FALSE, EINA_TRUE,
+				111.5 - 20.4, 81.3);
+		if (i == 1)
+		{
+			enesim_path_line_to(p, 10.3 + 20.4, 81.3);
+			enesim_path_arc_to(p, 20.4, 12.2, 0, EINA_FALSE,
+					EINA_TRUE, 10.3, 81.3 - 12.2);
+		}
+		else
+		{
+			enesim_path_line_to(p, 10.3, 81.3);
+		}
+		enesim_path_close(p);
+		/* every corner leaves out a square minus a quarter of ellipse */
+		*area = 101.2 * 60.7 - (i == 1 ? 4 : 2) * (1 - M_PI / 4) *
+				20.4 * 12.2;
+		break;
+
+		case 3:
+		r = enesim_renderer_circle_new();
+		enesim_renderer_circle_center_set(r, 70.25, 55.5);
+		enesim_renderer_circle_radius_set(r, 40.3);
+		enesim_path_move_to(p, 70.25, 55.5 - 40.3);
+		enesim_path_arc_to(p, 40.3, 40.3, 0, EINA_FALSE, EINA_TRUE,
+				70.25 + 40.3, 55.5);
+		enesim_path_arc_to(p, 40.3, 40.3, 0, EINA_FALSE, EINA_TRUE,
+				70.25, 55.5 + 40.3);
+		enesim_path_arc_to(p, 40.3, 40.3, 0, EINA_FALSE, EINA_TRUE,
+				70.25 - 40.3, 55.5);
+		enesim_path_arc_to(p, 40.3, 40.3, 0, EINA_FALSE, EINA_TRUE,
+				70.25, 55.5 - 40.3);
+		*area = M_PI * 40.3 * 40.3;
+		break;
+
+		default:
+		r = enesim_renderer_ellipse_new();
+		enesim_renderer_ellipse_center_set(r, 60.7, 50.2);
+		enesim_renderer_ellipse_radii_set(r, 50.5, 20.25);
+		enesim_path_move_to(p, 60.7, 50.2 - 20.25);
+		enesim_path_arc_to(p, 50.5, 20.25, 0, EINA_FALSE, EINA_TRUE,
+				60.7 + 50.5, 50.2);
+		enesim_path_arc_to(p, 50.5, 20.25, 0, EINA_FALSE, EINA_TRUE,
+				60.7, 50.2 + 20.25);
+		enesim_path_arc_to(p, 50.5, 20.25, 0, EINA_FALSE, EINA_TRUE,
+				60.7 - 50.5, 50.2);
+		enesim_path_arc_to(p, 50.5, 20.25, 0, EINA_FALSE, EINA_TRUE,
+				60.7, 50.2 - 20.25);
+		*area = M_PI * 50.5 * 20.25;
+		if (i == 5)
+		{
+			enesim_matrix_scale(&m, 1.25, 1.5);
+			enesim_renderer_transformation_set(r, &m);
+			enesim_renderer_origin_set(r, 3.3, -7.6);
+			*area *= 1.25 * 1.5;
+		}
+		break;
+	}
+	return r;
+}
+
+static void _properties_set(Enesim_Renderer *r, int i)
+{
+	enesim_renderer_shape_fill_color_set(r, 0xff808080);
+	enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+	if (i == 6)
+	{
+		Enesim_Renderer *checker;
+
+		checker = enesim_renderer_checker_new();
+		enesim_renderer_checker_even_color_set(checker, 0xff00ff00);
+		enesim_renderer_checker_odd_color_set(checker, 0xffff0000);
+		enesim_renderer_checker_width_set(checker, 7);
+		enesim_renderer_checker_height_set(checker, 5);
+		enesim_renderer_shape_fill_renderer_set(r, checker);
+	}
+}
+
+static Eina_Bool _compare(int i)
+{
+	Enesim_Renderer *shape, *path;
+	Enesim_Surface *s1, *s2, *s3;
+	Enesim_Path *p;
+	Enesim_Matrix m;
+	uint8_t *data;
+	size_t stride;
+	double ox, oy;
+	double area;
+	double sum = 0;
+	int max;
+	int x, y;
+	Eina_Bool ret = EINA_TRUE;
+
+	p = enesim_path_new();
+	shape = _shape_new(i, p, &area);
+	_properties_set(shape, i);
+	path = enesim_renderer_path_new();
+	enesim_renderer_path_path_set(path, p);
+	_properties_set(path, i);
+	/* the exact area rasterizer */
+	enesim_renderer_quality_set(path, ENESIM_QUALITY_GOOD);
+	enesim_renderer_transformation_get(shape, &m);
+	enesim_renderer_transformation_set(path, &m);
+	enesim_renderer_origin_get(shape, &ox, &oy);
+	enesim_renderer_origin_set(path, ox, oy);
+
+	s1 = enesim_test_draw(shape, WIDTH, HEIGHT);
+	enesim_renderer_quality_set(shape, ENESIM_QUALITY_GOOD);
+	s2 = enesim_test_draw(shape, WIDTH, HEIGHT);
+	s3 = enesim_test_draw(path, WIDTH, HEIGHT);
+	if (enesim_test_surface_difference(s1, s2))
+		ret = EINA_FALSE;
+	max = enesim_test_surface_difference(s1, s3);
+	if (max > MAX_DIFFERENCE)
+		ret = EINA_FALSE;
+	enesim_surface_sw_data_get(s1, (void **)&data, &stride);
+	for (y = 0; y < HEIGHT; y++)
+	{
+		uint32_t *d = (uint32_t *)(data + y * stride);
+
+		for (x = 0; x < WIDTH; x++)
+			sum += (d[x] >> 24) / 255.0;
+	}
+	if (fabs(sum - area) > 1 + (area / 256))
+		ret = EINA_FALSE;
+	printf("%s: area %g coverage %g maximum difference %d\n", _names[i],
+			area, sum, max);
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_surface_unref(s3);
+	enesim_renderer_unref(shape);
+	enesim_renderer_unref(path);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	for (i = 0; i < NSHAPES; i++)
+		ret |= enesim_test_result(_names[i], _compare(i));
+	enesim_shutdown();
+
+	return ret;
+}
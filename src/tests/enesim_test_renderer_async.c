@@ -0,0 +1,81 @@
+#include "enesim_test_helper.h"
+
+/* Draw the same renderers synchronously and asynchronously and check that
+ * both results are equal
+ */
+static Enesim_Renderer * _checker_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_checker_new();
+	enesim_renderer_checker_width_set(r, 20);
+	enesim_renderer_checker_height_set(r, 20);
+	enesim_renderer_checker_even_color_set(r, 0xffff0000);
+	enesim_renderer_checker_odd_color_set(r, 0xff0000ff);
+	return r;
+}
+
+static Enesim_Renderer * _circle_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_circle_new();
+	enesim_renderer_circle_center_set(r, 160, 120);
+	enesim_renderer_circle_radius_set(r, 100);
+	enesim_renderer_shape_fill_color_set(r, 0x80008000);
+	enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+	return r;
+}
+
+int main(int argc, char **argv)
+{
+	Enesim_Renderer_Draw_Future *f1, *f2;
+	Enesim_Renderer *r1, *r2;
+	Enesim_Surface *s1, *s2, *ref1, *ref2;
+	Eina_Rectangle clip;
+	int ret = 0;
+
+	enesim_init();
+	r1 = _checker_new();
+	r2 = _circle_new();
+	eina_rectangle_coords_from(&clip, 10, 15, 250, 200);
+
+	ref1 = enesim_surface_new(ENESIM_FORMAT_ARGB8888, 320, 240);
+	ref2 = enesim_surface_new(ENESIM_FORMAT_ARGB8888, 320, 240);
+	enesim_renderer_draw(r1, ref1, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	enesim_renderer_draw(r2, ref2, ENESIM_ROP_BLEND, &clip, 0, 0, NULL);
+
+	/* draw on two surfaces at the same time */
+	s1 = enesim_surface_new(ENESIM_FORMAT_ARGB8888, 320, 240);
+	s2 = enesim_surface_new(ENESIM_FORMAT_ARGB8888, 320, 240);
+	f1 = enesim_renderer_draw_async(r1, s1, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	f2 = enesim_renderer_draw_async(r2, s2, ENESIM_ROP_BLEND, &clip, 0, 0, NULL);
+	if (!f1 || !f2)
+	{
+		printf("Async draw failed\n");
+		return 1;
+	}
+	/* the workers might have finished already, but with a single cpu
+	 * the drawing only happens when waiting
+	 */
+	printf("First draw done: %d\n", enesim_renderer_draw_future_is_done(f1));
+	enesim_renderer_draw_future_wait(f2);
+	enesim_renderer_draw_future_wait(f1);
+
+	if (enesim_test_surface_difference(s1, ref1) ||
+			enesim_test_surface_difference(s2, ref2))
+	{
+		printf("Async draw differs from the sync draw\n");
+		ret = 1;
+	}
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_surface_unref(ref1);
+	enesim_surface_unref(ref2);
+	enesim_renderer_unref(r1);
+	enesim_renderer_unref(r2);
+	enesim_shutdown();
+
+	return ret;
+}
@@ -0,0 +1,157 @@
+#include "enesim_test_helper.h"
+
+/* The renderers that fill blocks of rows at once do it when they fill the
+ * destination directly. Draw them that way and inside a compound, which
+ * fills them row by row, and compare both results
+ */
+#define WIDTH 203
+#define HEIGHT 161
+#define NRENDERERS 8
+
+static const char *_names[NRENDERERS] = {
+	"Checker",
+	"Horizontal gradient",
+	"Vertical gradient",
+	"Diagonal gradient",
+	"Repeat pattern",
+	"Reflect pattern",
+	"Image",
+	"Image with color",
+};
+
+static Enesim_Surface * _source_new(int w, int h)
+{
+	Enesim_Surface *s;
+	uint32_t *data;
+	size_t stride;
+	int x, y;
+
+	s = enesim_surface_new(ENESIM_FORMAT_ARGB8888, w, h);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	for (y = 0; y < h; y++)
+	{
+		uint32_t *d = (uint32_t *)((uint8_t *)data + y * stride);
+
+		for (x = 0; x < w; x++)
+			d[x] = 0xff000000 | ((x * 7 + y * 13) & 0xffffff);
+	}
+	return s;
+}
+
+static Enesim_Renderer * _gradient_new(double x0, double y0, double x1,
+		double y1)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer_Gradient_Stop stop;
+
+	r = enesim_renderer_gradient_linear_new();
+	enesim_renderer_gradient_linear_position_set(r, x0, y0, x1, y1);
+	enesim_renderer_gradient_repeat_mode_set(r, ENESIM_REPEAT_MODE_REFLECT);
+	stop.argb = 0xff000000;
+	stop.pos = 0;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	stop.argb = 0x80ff8000;
+	stop.pos = 1;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	return r;
+}
+
+static Enesim_Renderer * _image_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_image_new();
+	enesim_renderer_image_source_surface_set(r, _source_new(150, 100));
+	enesim_renderer_image_position_set(r, -20, 30);
+	enesim_renderer_image_size_set(r, 150, 100);
+	return r;
+}
+
+static Enesim_Renderer * _renderer_new(int i)
+{
+	Enesim_Renderer *r;
+
+	switch (i)
+	{
+		case 0:
+		r = enesim_renderer_checker_new();
+		enesim_renderer_checker_even_color_set(r, 0xff00ff00);
+		enesim_renderer_checker_odd_color_set(r, 0x40200000);
+		enesim_renderer_checker_width_set(r, 13);
+		enesim_renderer_checker_height_set(r, 7);
+		enesim_renderer_origin_set(r, -3, 2.5);
+		break;
+
+		case 1:
+		r = _gradient_new(10, 20, 60, 20);
+		break;
+
+		case 2:
+		r = _gradient_new(10, 20, 10, 50);
+		break;
+
+		case 3:
+		r = _gradient_new(10, 20, 60, 50);
+		break;
+
+		case 4:
+		case 5:
+		r = enesim_renderer_pattern_new();
+		enesim_renderer_pattern_source_renderer_set(r, _image_new());
+		enesim_renderer_pattern_repeat_mode_set(r, i == 4 ?
+				ENESIM_REPEAT_MODE_REPEAT :
+				ENESIM_REPEAT_MODE_REFLECT);
+		enesim_renderer_origin_set(r, 5, -7);
+		break;
+
+		case 6:
+		r = _image_new();
+		break;
+
+		default:
+		r = _image_new();
+		enesim_renderer_color_set(r, 0xc0c0c0c0);
+		break;
+	}
+	return r;
+}
+
+static Eina_Bool _draw(int i)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *compound;
+	Enesim_Renderer_Compound_Layer *l;
+	Enesim_Surface *s1, *s2;
+	Eina_Bool ret;
+
+	r = _renderer_new(i);
+	compound = enesim_renderer_compound_new();
+	l = enesim_renderer_compound_layer_new();
+	enesim_renderer_compound_layer_renderer_set(l, enesim_renderer_ref(r));
+	enesim_renderer_compound_layer_rop_set(l, ENESIM_ROP_FILL);
+	enesim_renderer_compound_layer_add(compound, l);
+
+	s1 = enesim_test_draw(r, WIDTH, HEIGHT);
+	s2 = enesim_test_draw(compound, WIDTH, HEIGHT);
+	ret = !enesim_test_surface_difference(s1, s2);
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_renderer_unref(compound);
+	enesim_renderer_unref(r);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	for (i = 0; i < NRENDERERS; i++)
+		ret |= enesim_test_result(_names[i], _draw(i));
+	enesim_shutdown();
+
+	return ret;
+}
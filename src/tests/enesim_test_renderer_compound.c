@@ -0,0 +1,197 @@
+#include "enesim_test_helper.h"
+
+/* Draw a compound with the setup of the layers done serially and in
+ * parallel and check that both results are equal. One of the layers can not
+ * setup, both setups must skip it and log it. A compound with a masked
+ * layer is checked too, against drawing its layers one after the other
+ */
+#define WIDTH 320
+#define HEIGHT 240
+#define NLAYERS 24
+
+static Enesim_Renderer * _layer_renderer_new(int i)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer_Gradient_Stop stop;
+
+	switch (i % 4)
+	{
+		case 0:
+		r = enesim_renderer_circle_new();
+		enesim_renderer_circle_center_set(r, 20 + i * 12, 30 + i * 7);
+		enesim_renderer_circle_radius_set(r, 15 + i);
+		enesim_renderer_shape_fill_color_set(r, 0x80008000);
+		enesim_renderer_shape_stroke_color_set(r, 0xff000080);
+		enesim_renderer_shape_stroke_weight_set(r, 3);
+		enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE_FILL);
+		break;
+
+		case 1:
+		r = enesim_renderer_rectangle_new();
+		enesim_renderer_rectangle_position_set(r, i * 9.5, i * 6.25);
+		enesim_renderer_rectangle_size_set(r, 60.5, 40.3);
+		enesim_renderer_rectangle_corner_radii_set(r, 8, 6);
+		enesim_renderer_rectangle_corners_set(r, EINA_TRUE, EINA_TRUE,
+				EINA_TRUE, EINA_TRUE);
+		enesim_renderer_shape_fill_color_set(r, 0xc0804020);
+		enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+		break;
+
+		case 2:
+		r = enesim_renderer_gradient_linear_new();
+		enesim_renderer_gradient_linear_position_set(r, 0, i * 10, 80, i * 10 + 40);
+		stop.argb = 0x40ff0000;
+		stop.pos = 0;
+		enesim_renderer_gradient_stop_add(r, &stop);
+		stop.argb = 0x400000ff;
+		stop.pos = 1;
+		enesim_renderer_gradient_stop_add(r, &stop);
+		break;
+
+		default:
+		r = enesim_renderer_ellipse_new();
+		enesim_renderer_ellipse_center_set(r, 300 - i * 11, 20 + i * 8);
+		enesim_renderer_ellipse_radii_set(r, 30, 12);
+		enesim_renderer_shape_fill_color_set(r, 0x60606000);
+		enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+		break;
+	}
+	return r;
+}
+
+static Enesim_Renderer * _compound_new(Eina_Bool parallel)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer_Compound_Layer *l;
+	int i;
+
+	r = enesim_renderer_compound_new();
+	enesim_renderer_compound_background_enable_set(r, EINA_TRUE);
+	enesim_renderer_compound_background_color_set(r, 0xff202020);
+	enesim_renderer_compound_parallel_setup_set(r, parallel);
+	for (i = 0; i < NLAYERS; i++)
+	{
+		l = enesim_renderer_compound_layer_new();
+		/* an image without a source can not setup */
+		if (i == NLAYERS / 2)
+			enesim_renderer_compound_layer_renderer_set(l,
+					enesim_renderer_image_new());
+		else
+			enesim_renderer_compound_layer_renderer_set(l,
+					_layer_renderer_new(i));
+		enesim_renderer_compound_layer_rop_set(l, ENESIM_ROP_BLEND);
+		enesim_renderer_compound_layer_add(r, l);
+	}
+	return r;
+}
+
+static Enesim_Surface * _draw(Eina_Bool parallel, Eina_Bool *logged)
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *s;
+	Enesim_Log *log = NULL;
+
+	r = _compound_new(parallel);
+	s = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, WIDTH, HEIGHT);
+	enesim_renderer_draw(r, s, ENESIM_ROP_FILL, NULL, 0, 0, &log);
+	/* draw again to setup the layers already setup before */
+	enesim_renderer_draw(r, s, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	*logged = log != NULL;
+	enesim_log_delete(log);
+	enesim_renderer_unref(r);
+	return s;
+}
+
+static int _check(const char *name)
+{
+	Enesim_Surface *serial, *parallel;
+	Eina_Bool serial_logged, parallel_logged;
+	int ret;
+
+	serial = _draw(EINA_FALSE, &serial_logged);
+	parallel = _draw(EINA_TRUE, &parallel_logged);
+	ret = enesim_test_result(name, serial_logged && parallel_logged &&
+			!enesim_test_surface_difference(serial, parallel));
+	enesim_surface_unref(serial);
+	enesim_surface_unref(parallel);
+	return ret;
+}
+
+/* the gradient can not draw the mask by itself */
+static Enesim_Renderer * _masked_new(Eina_Bool color)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *mask;
+	Enesim_Renderer_Gradient_Stop stop;
+
+	r = enesim_renderer_gradient_linear_new();
+	enesim_renderer_gradient_linear_position_set(r, 10, 0, 300, 200);
+	stop.argb = 0xff00ff00;
+	stop.pos = 0;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	stop.argb = 0x80800000;
+	stop.pos = 1;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	if (color)
+		enesim_renderer_color_set(r, 0xc0c0c0c0);
+
+	mask = enesim_renderer_circle_new();
+	enesim_renderer_circle_center_set(mask, 160, 120);
+	enesim_renderer_circle_radius_set(mask, 90);
+	enesim_renderer_shape_fill_color_set(mask, 0xffffffff);
+	enesim_renderer_mask_set(r, mask);
+	return r;
+}
+
+static int _masked_check(const char *name, Eina_Bool color)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer_Compound_Layer *l;
+	Enesim_Surface *s1, *s2;
+	int ret;
+
+	/* the layers one after the other */
+	s1 = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, WIDTH, HEIGHT);
+	r = _layer_renderer_new(1);
+	enesim_renderer_draw(r, s1, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	enesim_renderer_unref(r);
+	r = _masked_new(color);
+	enesim_renderer_draw(r, s1, ENESIM_ROP_BLEND, NULL, 0, 0, NULL);
+	enesim_renderer_unref(r);
+
+	/* the compound draws the masked layer on its own spans */
+	r = enesim_renderer_compound_new();
+	l = enesim_renderer_compound_layer_new();
+	enesim_renderer_compound_layer_renderer_set(l, _layer_renderer_new(1));
+	enesim_renderer_compound_layer_rop_set(l, ENESIM_ROP_FILL);
+	enesim_renderer_compound_layer_add(r, l);
+	l = enesim_renderer_compound_layer_new();
+	enesim_renderer_compound_layer_renderer_set(l, _masked_new(color));
+	enesim_renderer_compound_layer_rop_set(l, ENESIM_ROP_BLEND);
+	enesim_renderer_compound_layer_add(r, l);
+	s2 = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, WIDTH, HEIGHT);
+	enesim_renderer_draw(r, s2, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	enesim_renderer_unref(r);
+
+	ret = enesim_test_result(name, !enesim_test_surface_difference(s1, s2));
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+
+	enesim_init();
+	ret |= _check("Default threads");
+	enesim_threads_set(1);
+	ret |= _check("One thread");
+	enesim_threads_set(5);
+	ret |= _check("Five threads");
+	ret |= _masked_check("Masked layer", EINA_FALSE);
+	ret |= _masked_check("Masked layer with color", EINA_TRUE);
+	enesim_shutdown();
+
+	return ret;
+}
@@ -0,0 +1,191 @@
+#include "enesim_test_helper.h"
+#include <stdlib.h>
+#include <math.h>
+
+/* The paths are rasterized with the exact area of every pixel on the good
+ * quality. Draw some figures and check that the sum of the coverage is the
+ * area of each figure. The coverage is kept for the next draws, so check too
+ * that drawing again with other colors and origin gives the same result as
+ * a new path
+ */
+#define WIDTH 120
+#define HEIGHT 100
+#define NFIGURES 5
+
+static const char *_names[NFIGURES] = {
+	"Pixel aligned square",
+	"Square",
+	"Triangle",
+	"Star non zero",
+	"Star even odd",
+};
+
+/* the star as a pentagon of the outer points (x, y) on the center 60, 50
+ * with radius 40, the even odd rule leaves out the inner pentagon
+ */
+static double _star_area(Eina_Bool even_odd)
+{
+	double r = 40;
+	/* the radius of the inner pentagon */
+	double ri = r * cos(2 * M_PI / 5) / cos(M_PI / 5);
+	double inner = 5 * ri * ri * sin(2 * M_PI / 5) / 2;
+	/* each of the points is a triangle with the side of the inner pentagon
+	 * as base
+	 */
+	double side = 2 * ri * sin(M_PI / 5);
+	double height = r - ri * cos(M_PI / 5);
+	double points = 5 * side * height / 2;
+
+	return even_odd ? points : points + inner;
+}
+
+static Enesim_Renderer * _path_new(int i, double *area)
+{
+	Enesim_Renderer *r;
+	Enesim_Path *p;
+
+	p = enesim_path_new();
+	switch (i)
+	{
+		case 0:
+		enesim_path_move_to(p, 10, 10);
+		enesim_path_line_to(p, 20, 10);
+		enesim_path_line_to(p, 20, 30);
+		enesim_path_line_to(p, 10, 30);
+		*area = 200;
+		break;
+
+		case 1:
+		enesim_path_move_to(p, 10.3, 10.7);
+		enesim_path_line_to(p, 40.1, 10.7);
+		enesim_path_line_to(p, 40.1, 50.2);
+		enesim_path_line_to(p, 10.3, 50.2);
+		*area = (40.1 - 10.3) * (50.2 - 10.7);
+		break;
+
+		case 2:
+		enesim_path_move_to(p, 10.25, 10.5);
+		enesim_path_line_to(p, 90.75, 20.25);
+		enesim_path_line_to(p, 40.5, 70.75);
+		*area = fabs((90.75 - 10.25) * (70.75 - 10.5) -
+				(40.5 - 10.25) * (20.25 - 10.5)) / 2;
+		break;
+
+		default:
+		{
+			int k;
+
+			for (k = 0; k < 5; k++)
+			{
+				double a = -M_PI / 2 + k * 4 * M_PI / 5;
+				double x = 60 + 40 * cos(a);
+				double y = 50 + 40 * sin(a);
+
+				if (!k)
+					enesim_path_move_to(p, x, y);
+				else
+					enesim_path_line_to(p, x, y);
+			}
+			*area = _star_area(i == 4);
+		}
+		break;
+	}
+	enesim_path_close(p);
+
+	r = enesim_renderer_path_new();
+	enesim_renderer_path_path_set(r, p);
+	enesim_renderer_shape_fill_color_set(r, 0xffffffff);
+	enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+	if (i == 4)
+		enesim_renderer_shape_fill_rule_set(r, ENESIM_RENDERER_SHAPE_FILL_RULE_EVEN_ODD);
+	enesim_renderer_quality_set(r, ENESIM_QUALITY_GOOD);
+	return r;
+}
+
+static Eina_Bool _draw(int i)
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *s;
+	uint8_t *data;
+	size_t stride;
+	double area;
+	double sum = 0;
+	int x, y;
+	Eina_Bool ret = EINA_TRUE;
+
+	r = _path_new(i, &area);
+	s = enesim_test_draw(r, WIDTH, HEIGHT);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	for (y = 0; y < HEIGHT; y++)
+	{
+		uint32_t *d = (uint32_t *)(data + y * stride);
+
+		for (x = 0; x < WIDTH; x++)
+		{
+			/* a pixel aligned figure has no partial pixels */
+			if (!i && d[x] != 0 && d[x] != 0xffffffff)
+				ret = EINA_FALSE;
+			sum += (d[x] >> 24) / 255.0;
+		}
+	}
+	/* the coverage is truncated to 256 levels */
+	if (fabs(sum - area) > 1 + (area / 128))
+		ret = EINA_FALSE;
+	printf("%s: area %g coverage %g\n", _names[i], area, sum);
+
+	enesim_surface_unref(s);
+	enesim_renderer_unref(r);
+
+	return ret;
+}
+
+static void _properties_set(Enesim_Renderer *r)
+{
+	enesim_renderer_shape_fill_color_set(r, 0x80ff8000);
+	enesim_renderer_color_set(r, 0xc0c0c0c0);
+	enesim_renderer_origin_set(r, 13, -7);
+}
+
+static Eina_Bool _redraw(int i)
+{
+	Enesim_Renderer *r1, *r2;
+	Enesim_Surface *s1, *s2;
+	double area;
+	Eina_Bool ret;
+
+	r1 = _path_new(i, &area);
+	s1 = enesim_test_draw(r1, WIDTH, HEIGHT);
+	_properties_set(r1);
+	enesim_renderer_draw(r1, s1, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+
+	r2 = _path_new(i, &area);
+	_properties_set(r2);
+	s2 = enesim_test_draw(r2, WIDTH, HEIGHT);
+	ret = !enesim_test_surface_difference(s1, s2);
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_renderer_unref(r1);
+	enesim_renderer_unref(r2);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	for (i = 0; i < NFIGURES; i++)
+	{
+		char name[64];
+
+		ret |= enesim_test_result(_names[i], _draw(i));
+		snprintf(name, sizeof(name), "%s redrawn", _names[i]);
+		ret |= enesim_test_result(name, _redraw(i));
+	}
+	enesim_shutdown();
+
+	return ret;
+}
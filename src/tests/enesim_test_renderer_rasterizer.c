@@ -0,0 +1,158 @@
+#include "enesim_test_helper.h"
+
+/* Draw a big path with many edges on a single thread and on several threads
+ * and check that every result is equal. The edges go up and down across
+ * every band of rows the rasterizer bins its vectors on, and the threads
+ * steal the bands of rows in any order, so the active edge tables are taken
+ * on rows above the ones they were left at and built again from the
+ * vectors of other bands. Lists of areas that start in the middle of a band
+ * are drawn from the bottom up too
+ */
+#define WIDTH 800
+#define HEIGHT 600
+#define NVERTICES 200
+#define NAREAS 24
+#define NRENDERERS 4
+
+static const char *_names[NRENDERERS] = {
+	"Non zero fill",
+	"Even odd fill with a fill renderer",
+	"Stroke and fill with a fill renderer",
+	"Even odd stroke and fill with renderers",
+};
+
+static Enesim_Renderer * _checker_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_checker_new();
+	enesim_renderer_checker_even_color_set(r, 0xff00ff00);
+	enesim_renderer_checker_odd_color_set(r, 0x80800000);
+	enesim_renderer_checker_width_set(r, 11);
+	enesim_renderer_checker_height_set(r, 7);
+	return r;
+}
+
+static Enesim_Renderer * _path_new(int i)
+{
+	Enesim_Renderer *r;
+	Enesim_Path *p;
+	int k;
+
+	/* every edge crosses many bands, going down and up again */
+	p = enesim_path_new();
+	enesim_path_move_to(p, 20, 20);
+	for (k = 1; k < NVERTICES; k++)
+	{
+		double x = 20 + (k * (WIDTH - 40.0)) / NVERTICES;
+		double y;
+
+		if (k & 1)
+			y = HEIGHT - 20 - ((k * 37) % (HEIGHT / 2)) + 0.3;
+		else
+			y = 20 + ((k * 53) % (HEIGHT / 2)) + 0.6;
+		enesim_path_line_to(p, x, y);
+	}
+	enesim_path_line_to(p, WIDTH - 20, HEIGHT / 2);
+	enesim_path_close(p);
+
+	r = enesim_renderer_path_new();
+	enesim_renderer_path_path_set(r, p);
+	enesim_renderer_shape_fill_color_set(r, 0xff336699);
+	enesim_renderer_shape_stroke_color_set(r, 0xffff8800);
+	enesim_renderer_shape_stroke_weight_set(r, 3);
+	if (i & 1)
+		enesim_renderer_shape_fill_rule_set(r,
+				ENESIM_RENDERER_SHAPE_FILL_RULE_EVEN_ODD);
+	if (i > 0)
+		enesim_renderer_shape_fill_renderer_set(r, _checker_new());
+	if (i > 1)
+		enesim_renderer_shape_draw_mode_set(r,
+				ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE_FILL);
+	else
+		enesim_renderer_shape_draw_mode_set(r,
+				ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+	if (i > 2)
+		enesim_renderer_shape_stroke_renderer_set(r, _checker_new());
+	return r;
+}
+
+/* Draw the areas from the top down or from the bottom up, they are closer
+ * than a band so going up can stay on the same band
+ */
+static Enesim_Surface * _areas_draw(Enesim_Renderer *r, Eina_Bool up)
+{
+	Enesim_Surface *s;
+	Eina_Rectangle areas[NAREAS];
+	Eina_List *l = NULL;
+	int k;
+
+	for (k = 0; k < NAREAS; k++)
+	{
+		eina_rectangle_coords_from(&areas[k], (k * 71) % (WIDTH / 2),
+				13 + k * 23, WIDTH / 2, 6);
+		if (up)
+			l = eina_list_prepend(l, &areas[k]);
+		else
+			l = eina_list_append(l, &areas[k]);
+	}
+	s = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, WIDTH, HEIGHT);
+	enesim_renderer_draw_list(r, s, ENESIM_ROP_FILL, l, 0, 0, NULL);
+	eina_list_free(l);
+	return s;
+}
+
+static int _check(int i)
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *ref, *ref_areas;
+	Enesim_Surface *s, *s_areas, *s_again, *s_up;
+	char name[256];
+	int ret;
+
+	r = _path_new(i);
+	enesim_threads_set(1);
+	ref = enesim_test_draw(r, WIDTH, HEIGHT);
+	ref_areas = _areas_draw(r, EINA_FALSE);
+	s_up = _areas_draw(r, EINA_TRUE);
+
+	/* every thread takes a single row at a time */
+	enesim_threads_set(4);
+	enesim_renderer_threads_rows_min_set(r, 1);
+	s = enesim_test_draw(r, WIDTH, HEIGHT);
+	s_areas = _areas_draw(r, EINA_TRUE);
+	/* the tables are left on other rows by the previous draw */
+	s_again = enesim_test_draw(r, WIDTH, HEIGHT);
+
+	snprintf(name, sizeof(name), "%s on four threads", _names[i]);
+	ret = enesim_test_result(name,
+			!enesim_test_surface_difference(ref, s) &&
+			!enesim_test_surface_difference(ref, s_again));
+	snprintf(name, sizeof(name), "%s on areas from the bottom up",
+			_names[i]);
+	ret |= enesim_test_result(name,
+			!enesim_test_surface_difference(ref_areas, s_up) &&
+			!enesim_test_surface_difference(ref_areas, s_areas));
+
+	enesim_surface_unref(ref);
+	enesim_surface_unref(ref_areas);
+	enesim_surface_unref(s);
+	enesim_surface_unref(s_areas);
+	enesim_surface_unref(s_again);
+	enesim_surface_unref(s_up);
+	enesim_renderer_unref(r);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	for (i = 0; i < NRENDERERS; i++)
+		ret |= _check(i);
+	enesim_shutdown();
+
+	return ret;
+}
@@ -0,0 +1,171 @@
+#include "enesim_test_helper.h"
+
+/* The renderers that give runs of a solid color are composed with the color
+ * spans. Draw them with every rop and compare the result with an image of
+ * the same renderer filled before, which is composed with the pixel spans
+ */
+#define WIDTH 203
+#define HEIGHT 61
+
+static const char *_rops[ENESIM_ROP_LAST] = {
+	"blend",
+	"fill",
+	"dst out",
+	"src in",
+	"dst in",
+	"multiply",
+	"screen",
+};
+
+static Enesim_Renderer * _renderer_new(int i)
+{
+	Enesim_Renderer *r;
+
+	switch (i)
+	{
+		case 0:
+		r = enesim_renderer_background_new();
+		enesim_renderer_background_color_set(r, 0x80402010);
+		break;
+
+		case 1:
+		r = enesim_renderer_checker_new();
+		enesim_renderer_checker_even_color_set(r, 0xff00ff00);
+		enesim_renderer_checker_odd_color_set(r, 0x40200000);
+		enesim_renderer_checker_width_set(r, 13);
+		enesim_renderer_checker_height_set(r, 7);
+		enesim_renderer_origin_set(r, -3, 2);
+		break;
+
+		case 2:
+		r = enesim_renderer_stripes_new();
+		enesim_renderer_stripes_even_color_set(r, 0xffff00ff);
+		enesim_renderer_stripes_odd_color_set(r, 0x80008000);
+		enesim_renderer_stripes_even_thickness_set(r, 5.5);
+		enesim_renderer_stripes_odd_thickness_set(r, 9);
+		break;
+
+		default:
+		r = enesim_renderer_rectangle_new();
+		enesim_renderer_rectangle_position_set(r, 10.3, 5.6);
+		enesim_renderer_rectangle_size_set(r, 150.2, 40.7);
+		enesim_renderer_rectangle_corner_radii_set(r, 12.4, 8.2);
+		enesim_renderer_rectangle_corners_set(r, EINA_TRUE, EINA_TRUE,
+				EINA_FALSE, EINA_TRUE);
+		enesim_renderer_shape_fill_color_set(r, 0xc0804020);
+		enesim_renderer_shape_draw_mode_set(r,
+				ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+		break;
+	}
+	return r;
+}
+
+static Eina_Bool _draw(int i, Enesim_Rop rop, Enesim_Format fmt,
+		Eina_Bool color)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *image;
+	Enesim_Surface *filled;
+	Enesim_Surface *s1, *s2;
+	Eina_Bool ret;
+
+	r = _renderer_new(i);
+	if (color)
+		enesim_renderer_color_set(r, 0xc0c0c0c0);
+
+	/* the renderer fills the destination directly */
+	filled = enesim_test_draw(r, WIDTH, HEIGHT);
+	image = enesim_renderer_image_new();
+	enesim_renderer_image_source_surface_set(image, filled);
+	enesim_renderer_image_size_set(image, WIDTH, HEIGHT);
+
+	s1 = enesim_surface_new(fmt, WIDTH, HEIGHT);
+	enesim_test_surface_pattern_set(s1);
+	enesim_renderer_draw(r, s1, rop, NULL, 0, 0, NULL);
+	s2 = enesim_surface_new(fmt, WIDTH, HEIGHT);
+	enesim_test_surface_pattern_set(s2);
+	enesim_renderer_draw(image, s2, rop, NULL, 0, 0, NULL);
+	ret = !enesim_test_surface_difference(s1, s2);
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_renderer_unref(image);
+	enesim_renderer_unref(r);
+
+	return ret;
+}
+
+/* The mask spans do not use the runs, with an opaque mask the renderer is
+ * composed with the pixel spans only
+ */
+static Eina_Bool _draw_masked(int i, Enesim_Rop rop, Enesim_Format fmt,
+		Eina_Bool color)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *mask;
+	Enesim_Surface *s1, *s2;
+	Eina_Bool ret;
+
+	r = _renderer_new(i);
+	if (color)
+		enesim_renderer_color_set(r, 0xc0c0c0c0);
+	s1 = enesim_surface_new(fmt, WIDTH, HEIGHT);
+	enesim_test_surface_pattern_set(s1);
+	enesim_renderer_draw(r, s1, rop, NULL, 0, 0, NULL);
+
+	mask = enesim_renderer_background_new();
+	enesim_renderer_background_color_set(mask, 0xffffffff);
+	enesim_renderer_mask_set(r, mask);
+	s2 = enesim_surface_new(fmt, WIDTH, HEIGHT);
+	enesim_test_surface_pattern_set(s2);
+	enesim_renderer_draw(r, s2, rop, NULL, 0, 0, NULL);
+	ret = !enesim_test_surface_difference(s1, s2);
+
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_renderer_unref(r);
+
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	Enesim_Rop rop;
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	for (i = 0; i < 4; i++)
+	{
+		for (rop = 0; rop < ENESIM_ROP_LAST; rop++)
+		{
+			int j;
+
+			for (j = 0; j < 4; j++)
+			{
+				Enesim_Format fmt;
+				char name[64];
+
+				/* the a8 compositor only blends and fills */
+				fmt = (j & 2) ? ENESIM_FORMAT_A8 : ENESIM_FORMAT_ARGB8888;
+				if (fmt == ENESIM_FORMAT_A8 && rop != ENESIM_ROP_BLEND &&
+						rop != ENESIM_ROP_FILL)
+					continue;
+				snprintf(name, sizeof(name), "%s %s%s%s", i == 0 ?
+						"Background" : i == 1 ? "Checker" :
+						i == 2 ? "Stripes" : "Rounded rectangle",
+						_rops[rop],
+						(j & 1) ? " with color" : "",
+						(j & 2) ? " on a8" : "");
+				ret |= enesim_test_result(name,
+						_draw(i, rop, fmt, j & 1));
+				strcat(name, " masked");
+				ret |= enesim_test_result(name,
+						_draw_masked(i, rop, fmt, j & 1));
+			}
+		}
+	}
+	enesim_shutdown();
+
+	return ret;
+}
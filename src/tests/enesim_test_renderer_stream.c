@@ -0,0 +1,122 @@
+#include "enesim_test_helper.h"
+#include <stdlib.h>
+
+/* The fills and clears on surfaces bigger than the cache are done with the
+ * streaming compositor functions. Draw with them and with the generic ones
+ * and check that every result is equal
+ */
+#define WIDTH 2048
+#define HEIGHT 2100
+#define NDRAWS 4
+
+static const char *_names[NDRAWS] = {
+	"Background",
+	"Checker",
+	"Rectangle",
+	"Image",
+};
+
+static Enesim_Renderer * _image_new(void)
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *s;
+	uint32_t *data;
+	size_t stride;
+	int x, y;
+
+	s = enesim_surface_new(ENESIM_FORMAT_ARGB8888, 1501, 1203);
+	enesim_surface_sw_data_get(s, (void **)&data, &stride);
+	for (y = 0; y < 1203; y++)
+	{
+		uint32_t *d = (uint32_t *)((uint8_t *)data + y * stride);
+
+		for (x = 0; x < 1501; x++)
+			d[x] = 0xff000000 | (x * 7 + y * 13);
+	}
+	r = enesim_renderer_image_new();
+	enesim_renderer_image_source_surface_set(r, s);
+	enesim_renderer_image_position_set(r, 37, 11);
+	enesim_renderer_image_size_set(r, 1501, 1203);
+	return r;
+}
+
+static Enesim_Renderer * _renderer_new(int i)
+{
+	Enesim_Renderer *r;
+
+	switch (i)
+	{
+		case 0:
+		r = enesim_renderer_background_new();
+		enesim_renderer_background_color_set(r, 0x80402010);
+		break;
+
+		case 1:
+		r = enesim_renderer_checker_new();
+		enesim_renderer_checker_even_color_set(r, 0xff00ff00);
+		enesim_renderer_checker_odd_color_set(r, 0x40200000);
+		enesim_renderer_checker_width_set(r, 100);
+		enesim_renderer_checker_height_set(r, 70);
+		enesim_renderer_origin_set(r, -3, 2);
+		break;
+
+		case 2:
+		r = enesim_renderer_rectangle_new();
+		enesim_renderer_rectangle_position_set(r, 100.5, 200.5);
+		enesim_renderer_rectangle_size_set(r, 1000, 900);
+		enesim_renderer_shape_fill_color_set(r, 0xff804020);
+		enesim_renderer_shape_draw_mode_set(r,
+				ENESIM_RENDERER_SHAPE_DRAW_MODE_FILL);
+		break;
+
+		default:
+		r = _image_new();
+		break;
+	}
+	return r;
+}
+
+static void _draw(uint32_t *dst[])
+{
+	int i;
+
+	for (i = 0; i < NDRAWS; i++)
+	{
+		Enesim_Renderer *r;
+		Enesim_Surface *s;
+
+		r = _renderer_new(i);
+		s = enesim_test_draw(r, WIDTH, HEIGHT);
+		dst[i] = enesim_test_surface_pixels_get(s);
+		enesim_surface_unref(s);
+		enesim_renderer_unref(r);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	uint32_t *stream[NDRAWS];
+	uint32_t *generic[NDRAWS];
+	int ret = 0;
+	int i;
+
+	enesim_init();
+	_draw(stream);
+	enesim_shutdown();
+
+	/* the cpu features are read on init */
+	setenv("ENESIM_CPU_DISABLE", "all", 1);
+	enesim_init();
+	_draw(generic);
+	enesim_shutdown();
+
+	for (i = 0; i < NDRAWS; i++)
+	{
+		ret |= enesim_test_result(_names[i], !memcmp(stream[i],
+				generic[i], WIDTH * HEIGHT * sizeof(uint32_t)));
+		free(stream[i]);
+		free(generic[i]);
+	}
+
+	return ret;
+}
@@ -0,0 +1,184 @@
+#include "enesim_test_helper.h"
+
+/* Draw the same renderer with different threading setups and check that
+ * every result is equal. A blur of a renderer is drawn too, its threads
+ * share the tiles of the source, and a masked renderer, on a surface wider
+ * than the chunks the spans are composed in
+ */
+static Enesim_Renderer * _circle_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_circle_new();
+	enesim_renderer_circle_center_set(r, 160, 120);
+	enesim_renderer_circle_radius_set(r, 100);
+	enesim_renderer_shape_fill_color_set(r, 0x80008000);
+	enesim_renderer_shape_stroke_color_set(r, 0xff000080);
+	enesim_renderer_shape_stroke_weight_set(r, 4);
+	enesim_renderer_shape_draw_mode_set(r, ENESIM_RENDERER_SHAPE_DRAW_MODE_STROKE_FILL);
+	return r;
+}
+
+/* the gradient can not draw the mask by itself */
+static Enesim_Renderer * _masked_new(void)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *mask;
+	Enesim_Renderer_Gradient_Stop stop;
+
+	r = enesim_renderer_gradient_linear_new();
+	enesim_renderer_gradient_linear_position_set(r, 10, 0, 1200, 300);
+	stop.argb = 0xff00ff00;
+	stop.pos = 0;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	stop.argb = 0x80800000;
+	stop.pos = 1;
+	enesim_renderer_gradient_stop_add(r, &stop);
+	enesim_renderer_color_set(r, 0xc0c0c0c0);
+
+	mask = enesim_renderer_checker_new();
+	enesim_renderer_checker_even_color_set(mask, 0xffffffff);
+	enesim_renderer_checker_odd_color_set(mask, 0x40404040);
+	enesim_renderer_checker_width_set(mask, 13);
+	enesim_renderer_checker_height_set(mask, 7);
+	enesim_renderer_mask_set(r, mask);
+	return r;
+}
+
+/* the blur keeps its source on a draw cache shared by every thread */
+static Enesim_Renderer * _blur_new(void)
+{
+	Enesim_Renderer *r;
+
+	r = enesim_renderer_blur_new();
+	enesim_renderer_blur_source_renderer_set(r, _circle_new());
+	enesim_renderer_blur_radius_x_set(r, 3);
+	enesim_renderer_blur_radius_y_set(r, 5);
+	return r;
+}
+
+/* Draw a new blur and then again after its source has changed, both on the
+ * current threads. Only the tiles of the cache the source damages are
+ * rendered again
+ */
+static void _blur_draw(Enesim_Surface **s1, Enesim_Surface **s2)
+{
+	Enesim_Renderer *r;
+	Enesim_Renderer *src;
+
+	r = _blur_new();
+	/* every row of a thread maps tiles the other threads map too */
+	enesim_renderer_threads_rows_min_set(r, 1);
+	*s1 = enesim_test_draw(r, 320, 240);
+	src = enesim_renderer_blur_source_renderer_get(r);
+	enesim_renderer_circle_radius_set(src, 70);
+	enesim_renderer_unref(src);
+	*s2 = enesim_test_draw(r, 320, 240);
+	enesim_renderer_unref(r);
+}
+
+/* Change the threads while an asynchronous draw is pending, the draw
+ * must be finished before the workers are replaced
+ */
+static int _check_async(Enesim_Renderer *r, Enesim_Surface *ref,
+		unsigned int threads, const char *name)
+{
+	Enesim_Renderer_Draw_Future *f;
+	Enesim_Surface *s;
+	int w, h;
+	int ret;
+
+	enesim_surface_size_get(ref, &w, &h);
+	s = enesim_test_surface_new(ENESIM_FORMAT_ARGB8888, w, h);
+	f = enesim_renderer_draw_async(r, s, ENESIM_ROP_FILL, NULL, 0, 0, NULL);
+	enesim_threads_set(threads);
+	enesim_renderer_draw_future_wait(f);
+	ret = enesim_test_result(name, !enesim_test_surface_difference(ref, s));
+	enesim_surface_unref(s);
+	return ret;
+}
+
+static int _check(Enesim_Renderer *r, Enesim_Surface *ref, const char *name)
+{
+	Enesim_Surface *s;
+	int w, h;
+	int ret;
+
+	enesim_surface_size_get(ref, &w, &h);
+	s = enesim_test_draw(r, w, h);
+	ret = enesim_test_result(name, !enesim_test_surface_difference(ref, s));
+	enesim_surface_unref(s);
+	return ret;
+}
+
+int main(int argc, char **argv)
+{
+	Enesim_Renderer *r;
+	Enesim_Surface *ref, *ref2;
+	Enesim_Surface *s1, *s2;
+	unsigned int cpus[] = { 0 };
+	int ret = 0;
+
+	enesim_init();
+	r = _circle_new();
+	ref = enesim_test_draw(r, 320, 240);
+	printf("Default threads: %d\n", enesim_threads_get());
+
+	enesim_threads_set(1);
+	ret |= _check(r, ref, "One thread");
+	enesim_threads_set(3);
+	ret |= _check(r, ref, "Three threads");
+	ret |= enesim_test_result("Unpin the threads",
+			enesim_threads_affinity_set(ENESIM_THREAD_AFFINITY_NONE, NULL, 0));
+	ret |= _check(r, ref, "Unpinned threads");
+	ret |= enesim_test_result("Pin the threads",
+			enesim_threads_affinity_set(ENESIM_THREAD_AFFINITY_CPUS, cpus, 1));
+	ret |= _check(r, ref, "Threads on the first cpu");
+	enesim_renderer_threads_max_set(r, 2);
+	ret |= _check(r, ref, "At most two threads");
+	enesim_renderer_threads_max_set(r, 0);
+	enesim_renderer_threads_rows_min_set(r, 1);
+	ret |= _check(r, ref, "One row per thread");
+	enesim_renderer_threads_rows_min_set(r, 1000);
+	ret |= _check(r, ref, "Calling thread only");
+	enesim_threads_set(0);
+	ret |= _check(r, ref, "Default threads");
+	enesim_renderer_threads_rows_min_set(r, 1);
+	enesim_threads_set(4);
+	ret |= _check_async(r, ref, 2, "Threads changed while drawing");
+	enesim_threads_set(1);
+	ret |= _check_async(r, ref, 3, "Workers added while drawing");
+	enesim_threads_set(0);
+	enesim_renderer_threads_rows_min_set(r, 0);
+	enesim_surface_unref(ref);
+	enesim_renderer_unref(r);
+
+	enesim_threads_set(1);
+	_blur_draw(&ref, &ref2);
+	enesim_threads_set(4);
+	_blur_draw(&s1, &s2);
+	ret |= enesim_test_result("Blur on four threads",
+			!enesim_test_surface_difference(ref, s1));
+	ret |= enesim_test_result("Damaged blur on four threads",
+			!enesim_test_surface_difference(ref2, s2));
+	enesim_surface_unref(s1);
+	enesim_surface_unref(s2);
+	enesim_surface_unref(ref);
+	enesim_surface_unref(ref2);
+
+	r = _masked_new();
+	enesim_threads_set(1);
+	ref = enesim_test_draw(r, 1500, 300);
+	enesim_threads_set(4);
+	ret |= _check(r, ref, "Masked on four threads");
+	enesim_renderer_threads_rows_min_set(r, 1);
+	ret |= _check(r, ref, "Masked with one row per thread");
+	enesim_threads_set(0);
+	ret |= _check(r, ref, "Masked on the default threads");
+	enesim_surface_unref(ref);
+	enesim_renderer_unref(r);
+
+	enesim_shutdown();
+
+	return ret;
+}